@@ -187,9 +187,7 @@ void align(const Mesh& orig_mesh, Mesh& polycube_mesh, const int smoothIters) {
         }
     }
     // Align sharp edges;
-    std::vector<FeatureLine> featureLines(orig_mesh.numOfSharpEdges, FeatureLine(orig_mesh));
-    for (size_t i = 0; i < orig_mesh.numOfSharpEdges; i++)
-        featureLines.at(i).Extract(i);
+    std::vector<FeatureLine> featureLines = FeatureLine::ExtractAll(orig_mesh);
     int smooth_iters = smoothIters;
     while (smooth_iters--) {
         for (auto featureLine : featureLines) {
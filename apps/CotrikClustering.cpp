@@ -136,6 +136,28 @@ int main( int argc, char* argv[] )
     GeodesicDistance gd;
     gd.inputMesh = argv[1];//"cap.faces.obj";
     gd.Init();
+
+    // landmark mode: geodesic k-medoids on farthest point sampled distance fields, no V x V matrix
+    if (argc == 5) {
+        const size_t numOfLandmarks = atoi(argv[4]);
+        std::vector<int> item_cids;
+        std::vector<size_t> medoids;
+        gd.ClusterByLandmarks(numOfLandmarks, item_cids, medoids);
+        std::cout << medoids.size() << " landmark clusters" << std::endl;
+
+        std::ofstream fout(argv[3]);
+        for (std::size_t i = 0; i < item_cids.size(); i++)
+            fout << item_cids[i] << std::endl;
+        fout.close();
+
+        MeshFileReader reader(argv[1]);
+        Mesh& mesh = (Mesh&)reader.GetMesh();
+        MeshFileWriter writer(mesh, (std::string(argv[1]) + ".cluster.vtk").c_str());
+        writer.WriteFile();
+        writer.WritePointData(item_cids, "cluster");
+        return 0;
+    }
+
     std::cout << "GeodesicDistance(0, 100) = " << gd.GetGeodesicDistance(0, 100) << std::endl;
 
     std::vector<std::vector<double> > geodesic_distance_matrix(gd.surface.nVertices, std::vector<double>(gd.surface.nVertices, 0.0));
@@ -163,7 +185,7 @@ int main( int argc, char* argv[] )
 
 	if( argc != 4 )
 	{
-		std::cout << "usage: birch (input-file) (range-threshold) (output-file)" << std::endl;
+		std::cout << "usage: birch (input-file) (range-threshold) (output-file) [#landmarks]" << std::endl;
 		return 0;
 	}
 
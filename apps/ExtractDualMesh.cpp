@@ -42,8 +42,11 @@ int main(int argc, char* argv[]) {
 	dualMesh.Build(mesh);
 	if (dualMesh.m_cellType == POLYGON)
 		dualMesh.BuildAllConnectivities();
-	else if (dualMesh.m_cellType == POLYHEDRA)
+	else if (dualMesh.m_cellType == POLYHEDRA) {
+		MeshFileWriter facesWriter(dualMesh.V, dualMesh.F, "F.vtk", POLYGON);
+		facesWriter.WriteFacesVtk();
 		dualMesh.BuildConnection(mesh);
+	}
 	//dualMesh.ExtractBoundary();
 	//dualMesh.ExtractSingularities();
 	//dualMesh.BuildParallelE();
@@ -11,6 +11,7 @@
 #include "PolyLine.h"
 #include "FrameOpt.h"
 #include "ArgumentManager.h"
+#include "TriangleLocator.h"
 #include <iostream>
 #include <set>
 #include <map>
@@ -574,20 +575,32 @@ void get_extend(const std::vector<Face>& quadF, const std::vector<Face>& nonover
     }
 }
 
-void get_inside_quads(const std::vector<VertexUV>& triV, const std::vector<Face>& triF, const std::vector<Vertex>& quadV,
+std::vector<Vertex> get_uv_vertices(const std::vector<VertexUV>& V) {
+    std::vector<Vertex> uvV(V.size());
+    for (auto& v : V) {
+        uvV[v.id] = glm::dvec3(v.uv.x, v.uv.y, 0.0);
+        uvV[v.id].id = v.id;
+    }
+    return uvV;
+}
+
+void get_inside_quads(const TriangleLocator& locator, const std::vector<Vertex>& quadV,
         std::vector<std::vector<Parameters>>& vertex_triangles,
         std::map<size_t, size_t>& overlap_quad_vids, std::vector<bool>& vertex_inside) {
+    std::vector<glm::dvec2> points(quadV.size());
+    for (auto& v : quadV)
+        points[v.id] = glm::dvec2(v.x, v.y);
+    std::vector<std::vector<size_t>> triangle_ids;
+    locator.GetTriangleIds(points, triangle_ids);
     for (auto& v : quadV) {
         bool inside = false;
         int count = 0;
-        for (auto& tri : triF) {
+        for (auto tri_id : triangle_ids[v.id]) {
             glm::dvec2 uv;
-            if (IsVertextInTriangle(v, triV[tri.Vids[0]], triV[tri.Vids[1]], triV[tri.Vids[2]], uv)) {
-                vertex_triangles[v.id].push_back(Parameters(uv, tri.id));
-                inside = true;
-                ++count;
-                //break;
-            }
+            locator.GetBarycentric(points[v.id], tri_id, uv);
+            vertex_triangles[v.id].push_back(Parameters(uv, tri_id));
+            inside = true;
+            ++count;
         }
         if (inside) vertex_inside[v.id] = true;
         if (count > 1) {
@@ -904,10 +917,13 @@ int main1(int argc, char* argv[]) {
     generate_quad_mesh(quadV, quadF);
     generate_quad_mesh(quadV, quadF, quadMesh);
 
+    TriangleLocator locator(triV, F);
+    locator.Build();
+
     std::vector<bool> vertex_inside(quadV.size(), false);
     std::vector<std::vector<Parameters>> vertex_triangles(quadV.size());
     std::map<size_t, size_t> overlap_quad_vids;
-    get_inside_quads(V, F, quadV, vertex_triangles, overlap_quad_vids, vertex_inside);
+    get_inside_quads(locator, quadV, vertex_triangles, overlap_quad_vids, vertex_inside);
 
     std::vector<Face> inside_quadF;
     std::vector<bool> quad_inside(quadF.size(), false);
@@ -991,37 +1007,25 @@ int main1(int argc, char* argv[]) {
     return 0;
 }
 
-std::vector<size_t> get_triangle_ids(const std::vector<VertexUV>& triV, const std::vector<Face>& triF,
-        const std::vector<Vertex>& quadV, const std::vector<Face>& quadF, const Face& f) {
-    std::vector<size_t> res;
-
+std::vector<size_t> get_triangle_ids(const TriangleLocator& locator, const std::vector<Vertex>& quadV, const Face& f) {
     const Vertex& v0 = quadV.at(f.Vids[0]);
     const Vertex& v2 = quadV.at(f.Vids[2]);
     Vertex center = 0.5 * (v0.xyz() + v2.xyz());
-    for (auto& tri : triF) {
-        glm::dvec2 uv;
-        if (IsVertextInTriangle(center, triV[tri.Vids[0]], triV[tri.Vids[1]], triV[tri.Vids[2]], uv))
-            res.push_back(tri.id);
-    }
-
-    return res;
+    return locator.GetTriangleIds(glm::dvec2(center.x, center.y));
 }
 
-std::vector<size_t> get_inside_quadids(const std::vector<VertexUV>& triV, const std::vector<Face>& triF,
-        const std::vector<Vertex>& quadV, const std::vector<Face>& quadF) {
-    std::vector<size_t> res;
-    for (auto& f : quadF) {
-        const Vertex& v0 = quadV.at(f.Vids[0]);
-        const Vertex& v2 = quadV.at(f.Vids[2]);
-        Vertex center = 0.5 * (v0.xyz() + v2.xyz());
-        for (auto& tri : triF) {
-            glm::dvec2 uv;
-            if (IsVertextInTriangle(center, triV[tri.Vids[0]], triV[tri.Vids[1]], triV[tri.Vids[2]], uv)) {
-                res.push_back(f.id);
-                break;
-            }
-        }
+std::vector<size_t> get_inside_quadids(const TriangleLocator& locator, const std::vector<Vertex>& quadV, const std::vector<Face>& quadF) {
+    std::vector<glm::dvec2> centers(quadF.size());
+    for (size_t i = 0; i < quadF.size(); i++) {
+        const Vertex& v0 = quadV.at(quadF[i].Vids[0]);
+        const Vertex& v2 = quadV.at(quadF[i].Vids[2]);
+        centers[i] = 0.5 * (glm::dvec2(v0.x, v0.y) + glm::dvec2(v2.x, v2.y));
     }
+    std::vector<std::vector<size_t>> triangle_ids;
+    locator.GetTriangleIds(centers, triangle_ids);
+    std::vector<size_t> res;
+    for (size_t i = 0; i < quadF.size(); i++)
+        if (!triangle_ids[i].empty()) res.push_back(quadF[i].id);
     return res;
 }
 
@@ -1029,10 +1033,14 @@ void MapbackToOrigTri(const std::vector<VertexUV>& triV, const std::vector<Face>
         const std::vector<Vertex>& quadV, const std::vector<Face>& quadF,
         std::vector<Vertex>& new_quadV, std::vector<Face>& new_quadF) {
 
+    const auto uvV = get_uv_vertices(triV);
+    TriangleLocator locator(uvV, triF);
+    locator.Build();
+
     std::vector<bool> vertex_inside(quadV.size(), false);
     std::vector<std::vector<Parameters>> vertex_triangles(quadV.size());
     std::map<size_t, size_t> overlap_quad_vids;
-    get_inside_quads(triV, triF, quadV, vertex_triangles, overlap_quad_vids, vertex_inside);
+    get_inside_quads(locator, quadV, vertex_triangles, overlap_quad_vids, vertex_inside);
 
     std::vector<Face> inside_quadF;
     std::vector<bool> quad_inside(quadF.size(), false);
@@ -1048,7 +1056,7 @@ void MapbackToOrigTri(const std::vector<VertexUV>& triV, const std::vector<Face>
     size_t new_vid = 0;
     size_t new_fid = 0;
     for (const auto& f : inside_quadF) {
-        auto triangle_ids = get_triangle_ids(triV, triF, quadV, quadF, f);
+        auto triangle_ids = get_triangle_ids(locator, quadV, f);
         for (auto triangle_id : triangle_ids) {
             bool is_good_quad = true;
             for (auto vid : f.Vids) {
@@ -53,9 +53,7 @@ int main(int argc, char* argv[]) {
     cornersFileWriter.WriteCornersVtk();
 
 
-    std::vector<FeatureLine> featureLines(mesh.numOfSharpEdges, FeatureLine(mesh));
-    for (size_t i = 0; i < mesh.numOfSharpEdges; i++)
-        featureLines.at(i).Extract(i);
+    std::vector<FeatureLine> featureLines = FeatureLine::ExtractAll(mesh);
     WriteSharpEdgesVtk("FeatureLines.vtk", mesh, featureLines);
     return 0;
 }
@@ -14,7 +14,7 @@ int main(int argc, char* argv[])
 {
     if (argc < 2)
     {
-        std::cout << "Usage: Smooth input.vtk\n";
+        std::cout << "Usage: Smooth input.vtk [gaussSeidel=true]\n";
         return -1;
     }
     ArgumentManager argumentManager(argc, argv);
@@ -36,6 +36,7 @@ int main(int argc, char* argv[])
 
     //SmoothAlgorithm smoother(mesh, LAPLACIAN);
     SmoothAlgorithm smoother(mesh, SCALED_JACOBIAN);
+    if (argumentManager.get("gaussSeidel") == "true") smoother.gaussSeidel = true;
     const int iters = 1e2;
     const double eps = 1e-4;
     smoother.Run(iters, eps);
@@ -105,9 +105,7 @@ int main(int argc, char* argv[])
     mesh.ExtractSingularities();
     mesh.SetCosAngleThreshold(cosangle);
     mesh.LabelSurface();
-    mesh.BuildParallelE();
-    mesh.BuildConsecutiveE();
-    mesh.BuildOrthogonalE();
+    mesh.BuildEdgeRelations();
     mesh.GetNormalOfSurfaceFaces();
     mesh.GetNormalOfSurfaceVertices();
     mesh.ExtractTwoRingNeighborSurfaceFaceIdsForEachVertex(3);
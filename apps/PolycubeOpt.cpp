@@ -158,22 +158,6 @@ void ConvertHexToTet(const Eigen::MatrixXi& H, Eigen::MatrixXi& T)
                 T(i * 8 + j, k) = H(i, HexToTet[j][k]);
 }
 
-size_t GetClosestBoundaryVertexId(const Vertex& v, const std::vector<Vertex>& V)
-{
-    size_t id = 0;
-    double distance = MAXID;
-    for (size_t i = 0; i < V.size(); i++) {
-        const Vertex& tv = V.at(i);
-        if (tv.isBoundary) {
-            double d = glm::length(v - tv);
-            if (d < distance) {
-                distance = d;
-                id = tv.id;
-            }
-        }
-    }
-    return id;
-}
 void SetConstraints(const Mesh& targetMesh, Eigen::VectorXi& b, Eigen::MatrixXd& bc)
 {
     int numOfVerticesOnBondary = 0;
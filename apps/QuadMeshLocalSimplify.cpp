@@ -400,9 +400,7 @@ void get_feature(Mesh& mesh) {
 	{
 		mesh.LabelSharpEdges(true);
 		// for (auto& e : mesh.E) e.isSharpFeature = copy[e.id];
-		std::vector<FeatureLine> featureLines(mesh.numOfSharpEdges, FeatureLine(mesh));
-		for (size_t i = 0; i < mesh.numOfSharpEdges; i++)
-			featureLines.at(i).Extract(i);
+		std::vector<FeatureLine> featureLines = FeatureLine::ExtractAll(mesh);
 		WriteSharpEdgesVtk("FeatureLines.vtk", mesh, featureLines);
 	}
 	std::set<size_t> sharpEdgeVids;
@@ -13,6 +13,7 @@
 #include "Util.h"
 #include "MeshQuality.h"
 #include "GetSet.h"
+#include "TargetLengthSolver.h"
 #include <math.h>
 #include <random>
 #include <time.h>
@@ -42,7 +43,7 @@ protected:
 
 class MeshMSJImprover : public MeshQualityImprover {
 public:
-    MeshMSJImprover(Mesh& mesh, const Mesh* refMesh = nullptr): MeshQualityImprover(mesh, refMesh) {
+    MeshMSJImprover(Mesh& mesh, const Mesh* refMesh = nullptr): MeshQualityImprover(mesh, refMesh), targetLengthSolver(mesh) {
 
     }
     virtual ~MeshMSJImprover() {
@@ -91,6 +92,8 @@ private:
     bool changeBoundary = false;
     bool projectToTargetSurface = false;
     bool useProjection = true;
+protected:
+    TargetLengthSolver targetLengthSolver;  // built on the first ComputeMeshTargetLength()
 };
 
 class QuadMeshMSJImprover : public MeshMSJImprover {
@@ -187,66 +190,11 @@ public:
         std::cout << "=============================\n";
         std::cout << "   Computing TargetLength    \n";
 
-        std::vector<Eigen::Triplet<double>> coefficients;
-        std::vector<double> b;
-        coefficients.reserve(mesh.E.size() * 5);
-        b.reserve(mesh.E.size() * 5);
-        size_t row  = 0;
-        for (size_t i = 0; i < mesh.E.size(); i++) {
-            auto& e = mesh.E.at(i);
-            coefficients.push_back(Eigen::Triplet<double>(row, i, 1));
-            if (e.isBoundary) b.push_back(e.length);
-            else b.push_back(GetavgMeshEdgeLength());
-            ++row;
-
-            for (auto parallelEid : e.parallelEids) {
-                coefficients.push_back(Eigen::Triplet<double>(row, i, 1));
-                coefficients.push_back(Eigen::Triplet<double>(row++, parallelEid, -1));
-                b.push_back(0);
-            }
-            for (auto consecutiveEid : e.consecutiveEids) {
-                coefficients.push_back(Eigen::Triplet<double>(row, i, 1));
-                coefficients.push_back(Eigen::Triplet<double>(row++, consecutiveEid, -1));
-                b.push_back(0);
-            }
-//            for (auto orthogonalEid : e.orthogonalEids) {
-//                coefficients.push_back(Trip(row, i, 1));
-//                coefficients.push_back(Trip(row, orthogonalEid, -1));
-//                b.push_back(0);
-//            }
-//            row += e.orthogonalEids.size();
-        }
-
-//        for (const Edge& e : mesh.E) {
-//            if (!e.isSingularity) continue;
-//            if (e.N_Cids.size() != 5 && e.N_Cids.size() != 3 && e.N_Cids.size() != 6) continue;
-//            auto combs = Util::combine(e.orthogonalEids.size(), 2);
-//            for (auto& comb : combs) {
-//                auto eid1 = e.orthogonalEids[comb[0]];
-//                auto eid2 = e.orthogonalEids[comb[1]];
-//                coefficients.push_back(Eigen::Triplet<double>(row, eid1, 1));
-//                coefficients.push_back(Eigen::Triplet<double>(row++, eid2, -1));
-//                b.push_back(0);
-//            }
-//        }
-
-        size_t col = mesh.E.size();
-        Eigen::SparseMatrix<double> A(row, col);
-        A.setFromTriplets(coefficients.begin(), coefficients.end());
-        Eigen::SparseMatrix<double> A_T = A.transpose();
-        Eigen::SparseMatrix<double> ATA = A_T * A;
-        VectorXd X(col), B(row);
-        for (size_t i = 0; i < row; i++)
-            B(i) = b[i];
-
-        VectorXd ATB = A_T * B;
-        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> chol(ATA);
-        X = chol.solve(ATB);
-
-        for (auto& e : mesh.E) {
+        if (!targetLengthSolver.IsBuilt()) targetLengthSolver.Build();
+        std::vector<double> X;
+        targetLengthSolver.Solve(GetavgMeshEdgeLength(), X);
+        for (auto& e : mesh.E)
             e.length = X[e.id];
-            //std::cout << X[i] << std::endl;
-        }
         std::cout << "=============================\n";
     }
     VectorXd Solve() {
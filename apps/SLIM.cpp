@@ -31,6 +31,7 @@
 #include "Mesh.h"
 #include "MeshFileReader.h"
 #include "MeshFileWriter.h"
+#include "PointLocator.h"
 #include <stdlib.h>
 
 #include <string>
@@ -162,22 +163,6 @@ void ConvertHexToTet(const Eigen::MatrixXi& H, Eigen::MatrixXi& T)
                 T(i * 8 + j, k) = H(i, HexToTet[j][k]);
 }
 
-size_t GetClosestBoundaryVertexId(const Vertex& v, const std::vector<Vertex>& V)
-{
-    size_t id = 0;
-    double distance = MAXID;
-    for (size_t i = 0; i < V.size(); i++) {
-        const Vertex& tv = V.at(i);
-        if (tv.isBoundary) {
-            double d = glm::length(v - tv);
-            if (d < distance) {
-                distance = d;
-                id = tv.id;
-            }
-        }
-    }
-    return id;
-}
 void GetPolycubeConstraints(const Mesh& tetOrigMesh, const Mesh& tetPolycubeMesh, const Mesh& hexPolycubeMesh,
                             Eigen::VectorXi& b, Eigen::MatrixXd& bc)
 {
@@ -189,12 +174,16 @@ void GetPolycubeConstraints(const Mesh& tetOrigMesh, const Mesh& tetPolycubeMesh
     }
     b.resize(numOfVerticesOnBondary);
     bc.resize(numOfVerticesOnBondary, 3);
+    PointLocator locator(tetPolycubeMesh);
+    locator.Build();
+    std::vector<size_t> closestVids;
+    locator.GetClosestVertexIds(hexPolycubeMesh.V, closestVids, true);
     numOfVerticesOnBondary = 0;
     for (size_t i = 0; i < hexPolycubeMesh.V.size(); i++) {
         const Vertex& v = hexPolycubeMesh.V.at(i);
         if (v.isBoundary) {
             b(numOfVerticesOnBondary) = v.id;
-            const size_t id = GetClosestBoundaryVertexId(v, tetPolycubeMesh.V);
+            const size_t id = closestVids[i];
             for (size_t j = 0; j < 3; j++)
                 bc(numOfVerticesOnBondary, j) = tetOrigMesh.V[id][j];
             numOfVerticesOnBondary++;
@@ -175,22 +175,6 @@ void ConvertHexToTet(const Eigen::MatrixXi& H, Eigen::MatrixXi& T)
                 T(i * 8 + j, k) = H(i, HexToTet[j][k]);
 }
 
-size_t GetClosestBoundaryVertexId(const Vertex& v, const std::vector<Vertex>& V)
-{
-    size_t id = 0;
-    double distance = MAXID;
-    for (size_t i = 0; i < V.size(); i++) {
-        const Vertex& tv = V.at(i);
-        if (tv.isBoundary) {
-            double d = glm::length(v - tv);
-            if (d < distance) {
-                distance = d;
-                id = tv.id;
-            }
-        }
-    }
-    return id;
-}
 void SetConstraints(const Mesh& targetMesh, Eigen::VectorXi& b, Eigen::MatrixXd& bc)
 {
     int numOfVerticesOnBondary = 0;
@@ -377,9 +361,7 @@ int main(int argc, char* argv[]) {
     orig_mesh.GetNormalOfSurfaceFaces();
     orig_mesh.GetNormalOfSurfaceVertices();
 
-    std::vector<FeatureLine> orig_featureLines(orig_mesh.numOfSharpEdges, FeatureLine(orig_mesh));
-    for (size_t i = 0; i < orig_mesh.numOfSharpEdges; i++)
-    	orig_featureLines.at(i).Extract(i);
+    std::vector<FeatureLine> orig_featureLines = FeatureLine::ExtractAll(orig_mesh);
     WriteSharpEdgesVtk("orig_meshFeatureLines.vtk", orig_mesh, orig_featureLines);
 
     MeshFileReader polycube_reader(polycube_filename.c_str());
@@ -408,9 +390,7 @@ int main(int argc, char* argv[]) {
 //    }
     for (const Vertex& v : polycube_mesh.V)
     	if (v.isCorner) ring3vIds.insert(v.id);
-    std::vector<FeatureLine> polycube_featureLines(polycube_mesh.numOfSharpEdges, FeatureLine(polycube_mesh));
-    for (size_t i = 0; i < polycube_mesh.numOfSharpEdges; i++)
-    	polycube_featureLines.at(i).Extract(i);
+    std::vector<FeatureLine> polycube_featureLines = FeatureLine::ExtractAll(polycube_mesh);
     WriteSharpEdgesVtk("polycube_meshFeatureLines.vtk", polycube_mesh, polycube_featureLines);
 
     Slim(argc, argv);
@@ -87,9 +87,7 @@ int main(int argc, char* argv[])
     mesh.ExtractSingularities();
     mesh.SetCosAngleThreshold(cosangle);
     mesh.LabelSurface();
-    mesh.BuildParallelE();
-    mesh.BuildConsecutiveE();
-    mesh.BuildOrthogonalE();
+    mesh.BuildEdgeRelations();
     mesh.GetNormalOfSurfaceFaces();
     mesh.GetNormalOfSurfaceVertices();
     std::cout << "genus = " <<  1 - (mesh.V.size() - mesh.E.size() + mesh.F.size() - mesh.C.size()) << std::endl;
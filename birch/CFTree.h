@@ -741,126 +741,93 @@ public:
 
     //template<typename _iter>
     //template<cfentry_vec_type::iterator _iter>
-    void redist(std::vector<item_type<3u> >::iterator begin, std::vector<item_type<3u> >::iterator end, /*cfentry_vec_type*/std::vector<CFEntry<3u> >& entries, std::vector<int>& out_cid)
+    /** center of a subcluster, redist keeps them sorted by norm */
+    struct subcluster_center
     {
-        using namespace boost::numeric::ublas;
+        float_type center[dim];
+        float_type norm;
+        int id; /* index of the entry */
+        bool operator<(const subcluster_center& rhs) const
+        {
+            return norm < rhs.norm;
+        }
+    };
 
+    void redist(std::vector<item_type<3u> >::iterator begin, std::vector<item_type<3u> >::iterator end, /*cfentry_vec_type*/std::vector<CFEntry<3u> >& entries, std::vector<int>& out_cid)
+    {
         // prepare summaries for each subcluster
-        // summaries = ( center, radius, norm )
-        subsum_vec_type subclusters;
-        subclusters.reserve(entries.size());
+        // summaries = ( center, norm, entry id ), fixed size so that no point allocates
+        std::vector<subcluster_center> subclusters(entries.size());
         for (std::size_t i = 0; i < entries.size(); i++) {
             const CFEntry<dim>& e = entries[i];
-            ublas_vec_type center(dim);
-            std::copy(e.sum, e.sum + dim, center.begin());
-            center /= e.n;
-            subclusters.push_back(subcluster_summary(center, _Radius(e), std::sqrt(inner_prod(center, center))));
-        }
-
-        std::sort(subclusters.begin(), subclusters.end(), subcluster_lessthan_norm());
-
-        // in addition to an individual summary for each subcluster
-        // calculate pairwise euclidean distances of subclusters
-        std::size_t n = subclusters.size();
-        ublas_sym_matrix_type dist_mat(n, n);
-        for (std::size_t i = 0; i < n - 1; i++) {
-            for (std::size_t j = i + 1; j < n; j++) {
-                ublas_vec_type diff = subclusters[i].center - subclusters[j].center;
-                dist_mat(i, j) = inner_prod(diff, diff);
+            subcluster_center& s = subclusters[i];
+            float_type sum_sq = 0.0;
+            for (std::size_t d = 0; d < dim; d++) {
+                s.center[d] = e.sum[d] / e.n;
+                sum_sq += s.center[d] * s.center[d];
             }
+            s.norm = std::sqrt(sum_sq);
+            s.id = (int) i;
         }
 
-        out_cid.clear();
-        out_cid.reserve(end - begin);
-        for (std::vector<item_type<3> >::iterator it = begin; it != end; it++) {
-            ublas_vec_type v(dim);
-            std::copy(&(*it)[0], &(*it)[0] + dim, v.begin());
-            out_cid.push_back(_redist(v, subclusters, dist_mat));
-        }
+        std::sort(subclusters.begin(), subclusters.end());
+
+        const long long n = end - begin;
+        out_cid.assign(n, -1);
+        if (subclusters.empty())
+            return;
+#pragma omp parallel for schedule(static)
+        for (long long i = 0; i < n; i++)
+            out_cid[i] = subclusters[_redist(&begin[i][0], subclusters)].id;
     }
 
 private:
 
-    int _redist(ublas_vec_type& tmpv, subsum_vec_type& subsums, ublas_sym_matrix_type& dist_mat)
+    static float_type _SqrDist(const float_type* lhs, const float_type* rhs)
     {
-        int imin, imax, i, k, n, start, end, median;
-        double d, tmpnorm, idist, tmpdist;
-        ublas_vec_type diff;
-
-        i = 0;
-        n = (int) subsums.size();
-        tmpnorm = std::sqrt(inner_prod(tmpv, tmpv));
-
-        // i=ClosestNorm(tmpnorm,norms,0,n-1);
-        // for efficiency, replace recursion by iteration
-        start = 0;
-        end = n - 1;
-        while (start < end) {
-            if (end - start == 1) {
-                float_type norm_end = subsums[end].norm;
-                float_type norm_start = subsums[start].norm;
-
-                i = tmpnorm > norm_end ? end : tmpnorm < norm_start ? start :
-                    tmpnorm - norm_start < norm_end - tmpnorm ? start : end;
-                start = end = i;
-            } else {
-                median = (start + end) / 2;
-                float_type norm_med = subsums[median].norm;
-                if (tmpnorm > norm_med)
-                    start = median;
-                else
-                    end = median;
-            }
-        }
+        float_type dist = 0.0;
+        for (std::size_t i = 0; i < dim; i++)
+            dist += (lhs[i] - rhs[i]) * (lhs[i] - rhs[i]);
+        return dist;
+    }
 
-        diff = tmpv - subsums[i].center;
-        idist= inner_prod(diff, diff);
-
-        // imin=MinLargerThan(tmpnorm-sqrt(idist),norms,0,n-1);
-        // imax=MaxSmallerThan(tmpnorm+sqrt(idist),norms,0,n-1);
-        // for efficiency, replace recursion by iteration
-
-        tmpdist = tmpnorm - sqrt(idist);
-        start = 0;
-        end = n - 1;
-        while (start < end) {
-            median = (start + end) / 2;
-            float_type norm_med = subsums[median].norm;
-            if (tmpdist > norm_med)
-                start = median + 1;
-            else
-                end = median;
-        }
-        imin = start;
-
-        tmpdist = tmpnorm + sqrt(idist);
-        start = 0;
-        end = n - 1;
-        while (start < end) {
-            median = (start + end + 1) / 2;
-            float_type norm_med = subsums[median].norm;
-            if (tmpdist < norm_med)
-                end = median - 1;
-            else
-                start = median;
+    // |norm(v) - norm(c)| <= dist(v, c), so starting at the closest norm the scan in either direction
+    // stops as soon as the norm gap alone exceeds the closest distance found so far
+    int _redist(const float_type* v, const std::vector<subcluster_center>& subsums) const
+    {
+        const int n = (int) subsums.size();
+        subcluster_center tmp;
+        float_type sum_sq = 0.0;
+        for (std::size_t d = 0; d < dim; d++)
+            sum_sq += v[d] * v[d];
+        tmp.norm = std::sqrt(sum_sq);
+        int i = (int) (std::lower_bound(subsums.begin(), subsums.end(), tmp) - subsums.begin());
+        if (i == n || (i > 0 && tmp.norm - subsums[i - 1].norm < subsums[i].norm - tmp.norm))
+            i--;
+
+        int imin = i;
+        float_type idist = _SqrDist(v, subsums[i].center);
+        for (int k = i + 1; k < n; k++) {
+            const float_type gap = subsums[k].norm - tmp.norm;
+            if (gap > 0 && gap * gap >= idist)
+                break;
+            const float_type d = _SqrDist(v, subsums[k].center);
+            if (d < idist) {
+                idist = d;
+                imin = k;
+            }
         }
-        imax = start;
-
-        // ClosestCenter(i,idist,tmpv,centers,imin,imax,matrix,n);
-        // for efficiency, replace procedure by inline
-        k = imin;
-        while (k <= imax) {
-            if (dist_mat(k, i) <= 4 * idist) {
-                diff = tmpv - subsums[k].center;
-                d = inner_prod(diff, diff);
-                if (d < idist) {
-                    idist = d;
-                    i = k;
-                }
+        for (int k = i - 1; k >= 0; k--) {
+            const float_type gap = tmp.norm - subsums[k].norm;
+            if (gap > 0 && gap * gap >= idist)
+                break;
+            const float_type d = _SqrDist(v, subsums[k].center);
+            if (d < idist) {
+                idist = d;
+                imin = k;
             }
-            k++;
         }
-        return i;
+        return imin;
     }
 /* phase 4 - redistribute actual data points to subclusters */
 //#include "CFTree_Redist.h"
@@ -875,8 +842,6 @@ public:
 
     struct HierarchicalClustering
     {
-        typedef boost::numeric::ublas::symmetric_matrix<float_type> dist_matrix_type;
-
         HierarchicalClustering(int n, dist_func_type& in_dist_func)
                 : size(n), step(-1), ii(n), jj(n), cf(n), dd(n), dist_func(in_dist_func), chain(n + 1), chainptr(-1), stopchain(FALSE)
         {
@@ -885,7 +850,7 @@ public:
         void merge(cfentry_vec_type& entries)
         {
             int nentry = (int) entries.size();
-            int i, j, n1, n2;
+            int i;
 
             int CurI, PrevI, NextI;
             int uncheckcnt = nentry;
@@ -897,13 +862,11 @@ public:
             // positive 1..nentry+1 :     original entries
             // negative -1..-(nentry-1) : merged entries
 
-            // get initial distances
-            // std::vector<float_type> dist(nentry*(nentry-1)/2);
-            dist_matrix_type dist(nentry, nentry);
-
-            for (i = 0; i < nentry - 1; i++)
-                for (j = i + 1; j < nentry; j++)
-                    dist(i, j) = dist_func(entries[i], entries[j]);
+            // no distance matrix, distances to the entry or merged entry at each index are evaluated on demand.
+            // cf is sized up front, so pointers to its elements stay valid
+            cfentry_ptr_vec_type current(nentry);
+            for (i = 0; i < nentry; i++)
+                current[i] = &entries[i];
 
             CurI = rand() % nentry;         // step1
             chain[++chainptr] = CurI;
@@ -920,7 +883,7 @@ public:
                 // step2
                 while (stopchain == FALSE) {
                     CurI = chain[chainptr];
-                    NextI = nearest_neighbor(CurI, nentry, &checked[0], dist);
+                    NextI = nearest_neighbor(CurI, PrevI, nentry, &checked[0], current);
 
                     // it is impossible NextI be -1 because uncheckcnt>1
                     if (NextI == PrevI)
@@ -937,18 +900,11 @@ public:
                 ii[step] = checked[CurI];
                 jj[step] = checked[NextI];
 
-                dd[step] = dist(CurI, NextI);
-
-                bool curr_org = checked[CurI] > 0;
-                bool next_org = checked[NextI] > 0;
+                dd[step] = dist_func(*current[CurI], *current[NextI]);
+                cf[step] = *current[CurI] + *current[NextI];
+                current[CurI] = &cf[step];
+                current[NextI] = NULL;
 
-                CFEntry<dim>& curr_entry = curr_org ? entries[CurI] : cf[-checked[CurI] - 1];
-                CFEntry<dim>& next_entry = next_org ? entries[NextI] : cf[-checked[NextI] - 1];
-                n1 = curr_entry.n;
-                n2 = next_entry.n;
-                cf[step] = curr_entry + next_entry;
-
-                update_distance(n1, n2, CurI, NextI, nentry, &checked[0], dist);
                 uncheckcnt--;
                 checked[CurI] = -(step + 1);
                 checked[NextI] = 0;
@@ -1030,21 +986,32 @@ public:
         }
 
         /* for MergeHierarchy use only */
-        int nearest_neighbor(int CurI, int n, int *checked, dist_matrix_type& dist)
+        int nearest_neighbor(int CurI, int PrevI, int n, int *checked, const cfentry_ptr_vec_type& current)
         {
-            int imin = 0;
-            double d, dmin = (std::numeric_limits<float_type>::max)();
-            for (int i = 0; i < n; i++) {
-                if (i == CurI || checked[i] == 0)
-                    continue;
-
-                d = dist(i, CurI);
-                if (d < dmin) {
-                    dmin = d;
-                    imin = i;
+            // the lowest index wins ties, except PrevI which ends the chain; the geodesic distance is not thread safe
+            int imin = -1;
+            float_type dmin = (std::numeric_limits<float_type>::max)();
+#pragma omp parallel if (n > 256 && dist_func != _DistGeo)
+            {
+                int ilocal = -1;
+                float_type dlocal = (std::numeric_limits<float_type>::max)();
+#pragma omp for schedule(static) nowait
+                for (int i = 0; i < n; i++) {
+                    if (i == CurI || checked[i] == 0)
+                        continue;
+
+                    const float_type d = dist_func(*current[i], *current[CurI]);
+                    if (d < dlocal || (d == dlocal && i == PrevI)) {
+                        dlocal = d;
+                        ilocal = i;
+                    }
+                }
+#pragma omp critical
+                if (ilocal != -1 && (imin == -1 || dlocal < dmin || (dlocal == dmin && ilocal != imin && (ilocal == PrevI || (imin != PrevI && ilocal < imin))))) {
+                    dmin = dlocal;
+                    imin = ilocal;
                 }
             }
-
             return dmin < (std::numeric_limits<float_type>::max)() ? imin : -1;
         }
 
@@ -1058,18 +1025,6 @@ public:
             return -1;
         }
 
-        /* for MergeHierarchy use only */
-        void update_distance(int n1, int n2, int CurI, int NextI, int n, int *checked, dist_matrix_type& dist)
-        {
-            for (int i = 0; i < n; i++) {
-                if (i == CurI || i == NextI)
-                    continue;
-
-                if (checked[i] != 0)
-                    dist(i, CurI) = (n1 * dist(i, CurI) + n2 * dist(i, NextI)) / (n1 + n2);
-            }
-        }
-
         int size;
         int step;
         std::vector<int> ii;
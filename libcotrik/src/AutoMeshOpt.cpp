@@ -9,6 +9,7 @@
 #include "MeshFileReader.h"
 #include "MeshFileWriter.h"
 #include "MeshQuality.h"
+#include "HausdorffDistance.h"
 
 #include <algorithm>
 #include <vector>
@@ -17,8 +18,6 @@
 #include <queue>
 #include <iostream>
 #include <math.h>
-#include <igl/hausdorff.h>
-
 #include <igl/slim.h>
 
 #include <igl/components.h>
@@ -157,22 +156,6 @@ void ConvertHexToTet(const Eigen::MatrixXi& H, Eigen::MatrixXi& T)
                 T(i * 8 + j, k) = H(i, HexToTet[j][k]);
 }
 
-size_t GetClosestBoundaryVertexId(const Vertex& v, const std::vector<Vertex>& V)
-{
-    size_t id = 0;
-    double distance = MAXID;
-    for (size_t i = 0; i < V.size(); i++) {
-        const Vertex& tv = V.at(i);
-        if (tv.isBoundary) {
-            double d = glm::length(v - tv);
-            if (d < distance) {
-                distance = d;
-                id = tv.id;
-            }
-        }
-    }
-    return id;
-}
 void SetConstraints(const Mesh& targetMesh, Eigen::VectorXi& b, Eigen::MatrixXd& bc)
 {
     int numOfVerticesOnBondary = 0;
@@ -237,7 +220,7 @@ void AutoMeshOpt::InversionFreeDeformToTargetMesh()
 //        if (iters == 0)
 //            WriteHexVtk(sData, HEXAHEDRA, result.c_str());
         GetVertices(sData.V_o, mesh.V);
-        if (GetHausdorffError() < m_hausdorffError)
+        if (hausdorffDistance.IsLessThan(m_hausdorffError))
             return;
     }
 }
@@ -246,6 +229,7 @@ AutoMeshOpt::AutoMeshOpt(const Mesh& mesh, const Mesh& origMesh)
 : LocalMeshOpt(mesh)
 , origMesh(origMesh)
 , m_hausdorffError(1e-2)
+, hausdorffDistance(mesh, origMesh)
 {
     // TODO Auto-generated constructor stub
 
@@ -256,46 +240,6 @@ AutoMeshOpt::~AutoMeshOpt()
     // TODO Auto-generated destructor stub
 }
 
-void GetSurfacVertices(const std::vector<Vertex>& V, Eigen::MatrixXd& V_o)
-{
-    size_t numOfSurfaceVertices = 0;
-    for (size_t i = 0; i < V.size(); i++) {
-        const Vertex& v = V.at(i);
-        if (v.isBoundary)
-            numOfSurfaceVertices++;
-    }
-    V_o.resize(numOfSurfaceVertices, 3);
-    numOfSurfaceVertices = 0;
-    for (size_t i = 0; i < V.size(); i++) {
-        const Vertex& v = V.at(i);
-        if (v.isBoundary) {
-            for (size_t j = 0; j < V_o.cols(); j++)
-                V_o(numOfSurfaceVertices, j) = v[j];
-            numOfSurfaceVertices++;
-        }
-    }
-}
-
-void GetSurfaceFaces(const std::vector<Face>& F, Eigen::MatrixXi& F_o)
-{
-    size_t numOfSurfaceFaces = 0;
-    for (size_t i = 0; i < F.size(); i++) {
-        const Face& f = F.at(i);
-        if (f.isBoundary)
-            numOfSurfaceFaces++;
-    }
-    F_o.resize(numOfSurfaceFaces, F[0].Vids.size());
-    numOfSurfaceFaces = 0;
-    for (size_t i = 0; i < F.size(); i++) {
-        const Face& f = F.at(i);
-        if (f.isBoundary) {
-            for (size_t j = 0; j < F_o.cols(); j++)
-                F_o(numOfSurfaceFaces, j) = f.Vids[j];
-            numOfSurfaceFaces++;
-        }
-    }
-}
-
 void AutoMeshOpt::Run()
 {
 
@@ -343,7 +287,7 @@ void AutoMeshOpt::Run()
             std::vector<size_t> badCellIds;
             m_numOfInvertdElements = GetMinScaledJacobian(mesh, minSJ, badCellIds, this->minScaledJacobian);
             if (m_numOfInvertdElements == 0) {
-                if (GetHausdorffError() < m_hausdorffError) {
+                if (hausdorffDistance.IsLessThan(m_hausdorffError)) {
                     std::string filename = std::string("MSJ=") + std::to_string(minSJ) + ".vtk";
                     MeshFileWriter writer(mesh, filename.c_str());
                     writer.WriteFile();
@@ -353,7 +297,7 @@ void AutoMeshOpt::Run()
                     mesh.ProjectTo(origMesh);
                     m_numOfInvertdElements = GetMinScaledJacobian(mesh, minSJ, badCellIds, this->minScaledJacobian);
                     if (m_numOfInvertdElements == 0 && minSJ >= this->minScaledJacobian) {
-                        if (GetHausdorffError() < m_hausdorffError) {
+                        if (hausdorffDistance.IsLessThan(m_hausdorffError)) {
                             std::string filename = std::string("MSJ=") + std::to_string(minSJ) + ".vtk";
                             MeshFileWriter writer(mesh, filename.c_str());
                             writer.WriteFile();
@@ -374,22 +318,11 @@ void AutoMeshOpt::Run()
     }
 }
 
-double AutoMeshOpt::GetHausdorffError() const
+double AutoMeshOpt::GetHausdorffError()
 {
-    double local_hausdorffErr = 0;
-
-    Eigen::MatrixXd VA;
-    Eigen::MatrixXi FA;
-    Eigen::MatrixXd VB;
-    Eigen::MatrixXi FB;
-    GetSurfacVertices(mesh.V, VA);
-    GetSurfaceFaces(mesh.F, FA);
-    GetSurfacVertices(origMesh.V, VB);
-    GetSurfaceFaces(origMesh.F, FB);
-    igl::hausdorff(VA, FA, VB, FB, local_hausdorffErr);
-
-    return local_hausdorffErr;
+    return hausdorffDistance.Get();
 }
+
 void AutoMeshOpt::SetHausdorffError(const double value/* = 1e-2*/)
 {
     m_hausdorffError = value;
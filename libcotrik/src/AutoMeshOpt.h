@@ -10,6 +10,7 @@
 
 #include "Mesh.h"
 #include "LocalMeshOpt.h"
+#include "HausdorffDistance.h"
 
 class AutoMeshOpt : public LocalMeshOpt
 {
@@ -26,11 +27,12 @@ public:
     void SetHausdorffError(const double value = 1e-2);
 
 protected:
-    double GetHausdorffError() const;
+    double GetHausdorffError();
     void InversionFreeDeformToTargetMesh();
 protected:
     const Mesh& origMesh;
     double m_hausdorffError;
+    HausdorffDistance hausdorffDistance;   // boundary of mesh against origMesh
 };
 
 #endif /* AUTO_MESH_OPT_H_ */
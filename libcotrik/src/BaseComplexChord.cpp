@@ -49,54 +49,100 @@ const size_t parallel_edge_ids[3][4][2] = {
 };
 void BaseComplexChord::Extract()
 {
-    std::vector<bool> visited(baseComplex.componentF.size(), false);
+    BuildOppositeComponentFaces();
+    std::vector<size_t> edgeChordIds(baseComplex.componentE.size(), MAXID);
+    std::vector<size_t> faceChordIds(baseComplex.componentF.size(), MAXID);
+    std::vector<size_t> cellChordIds(baseComplex.componentC.size(), MAXID);
     for (auto& componentFace : baseComplex.componentF) {
-        if (visited.at(componentFace.id)) continue;
+        if (faceChordIds.at(componentFace.id) != MAXID) continue;
         std::vector<size_t> chordComponentEdgeIds;
         std::vector<size_t> chordComponentFaceIds;
         std::vector<size_t> chordComponentCellIds;
-        GetParallelComponents(componentFace, chordComponentEdgeIds, chordComponentFaceIds, chordComponentCellIds);
+        GetParallelComponents(componentFace, chords_componentFaceIds.size(), edgeChordIds, faceChordIds, cellChordIds,
+                chordComponentEdgeIds, chordComponentFaceIds, chordComponentCellIds);
         chords_componentEdgeIds.push_back(chordComponentEdgeIds);
         chords_componentFaceIds.push_back(chordComponentFaceIds);
         chords_componentCellIds.push_back(chordComponentCellIds);
+    }
+}
+
+// two faces of a componentCell are opposite if they share no vertex
+static bool IsOpposite(const ComponentFace& f1, const ComponentFace& f2)
+{
+    for (auto vid : f1.Vids)
+        if (std::find(f2.Vids.begin(), f2.Vids.end(), vid) != f2.Vids.end()) return false;
+    return true;
+}
 
-        for (auto id : chordComponentFaceIds) visited.at(id) = true;
+void BaseComplexChord::BuildOppositeComponentFaces()
+{
+    const auto& componentC = baseComplex.componentC;
+    oppositeComponentFaceOffsets.assign(componentC.size() + 1, 0);
+    for (size_t i = 0; i < componentC.size(); i++)
+        oppositeComponentFaceOffsets[i + 1] = oppositeComponentFaceOffsets[i] + componentC[i].Fids.size();
+    oppositeComponentFaceIds.assign(oppositeComponentFaceOffsets.back(), MAXID);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)componentC.size(); i++) {
+        const auto& fids = componentC[i].Fids;
+        for (size_t j = 0; j < fids.size(); j++)
+            for (size_t k = 0; k < fids.size(); k++)
+                if (IsOpposite(baseComplex.componentF.at(fids[j]), baseComplex.componentF.at(fids[k]))) {
+                    oppositeComponentFaceIds[oppositeComponentFaceOffsets[i] + j] = fids[k];
+                    break;
+                }
     }
 }
 
+size_t BaseComplexChord::GetOppositeComponentFaceId(const size_t componentCellId, const size_t componentFaceId) const
+{
+    const auto& fids = baseComplex.componentC.at(componentCellId).Fids;
+    const size_t j = std::find(fids.begin(), fids.end(), componentFaceId) - fids.begin();
+    if (j == fids.size()) return MAXID;
+    if (!oppositeComponentFaceOffsets.empty()) return oppositeComponentFaceIds[oppositeComponentFaceOffsets[componentCellId] + j];
+    for (auto fid : fids)
+        if (IsOpposite(baseComplex.componentF.at(componentFaceId), baseComplex.componentF.at(fid))) return fid;
+    return MAXID;
+}
+
 void BaseComplexChord::GetParallelComponents(const ComponentFace & componentFace,
         std::vector<size_t>& chordComponentEdgeIds, std::vector<size_t>& chordComponentFaceIds, std::vector<size_t>& chordComponentCellIds)
 {
-    std::vector<bool> edge_visited(baseComplex.componentE.size(), false);
-    std::vector<bool> face_visited(baseComplex.componentF.size(), false);
-    std::vector<bool> cell_visited(baseComplex.componentC.size(), false);
-    face_visited.at(componentFace.id) = true;
+    std::vector<size_t> edgeChordIds(baseComplex.componentE.size(), MAXID);
+    std::vector<size_t> faceChordIds(baseComplex.componentF.size(), MAXID);
+    std::vector<size_t> cellChordIds(baseComplex.componentC.size(), MAXID);
+    GetParallelComponents(componentFace, 0, edgeChordIds, faceChordIds, cellChordIds,
+            chordComponentEdgeIds, chordComponentFaceIds, chordComponentCellIds);
+}
+
+void BaseComplexChord::GetParallelComponents(const ComponentFace & componentFace, const size_t chordId,
+        std::vector<size_t>& edgeChordIds, std::vector<size_t>& faceChordIds, std::vector<size_t>& cellChordIds,
+        std::vector<size_t>& chordComponentEdgeIds, std::vector<size_t>& chordComponentFaceIds, std::vector<size_t>& chordComponentCellIds) const
+{
+    faceChordIds.at(componentFace.id) = chordId;
     chordComponentFaceIds.push_back(componentFace.id);
     std::queue<size_t> q;
     q.push(componentFace.id);
     while (!q.empty()) {
-        size_t n = q.size();
-        for (int i = 0; i < n; ++i) {
-            const size_t componentFaceId = q.front();
-            q.pop();
-
-            for (auto neighborComponentCellId : baseComplex.componentF.at(componentFaceId).N_Cids)
-                if (!cell_visited.at(neighborComponentCellId)) {
-                    cell_visited.at(neighborComponentCellId) = true;
-                    chordComponentCellIds.push_back(neighborComponentCellId);
-                    for (auto componentEdgeId : baseComplex.componentC.at(neighborComponentCellId).Eids)
-                        if (!edge_visited.at(componentEdgeId)) {
-                            edge_visited.at(componentEdgeId) = true;
-                            chordComponentEdgeIds.push_back(componentEdgeId);
-                        }
-                }
-            const auto nextComponentFaceIds = GetParallelComponentFaceIds(baseComplex.componentF.at(componentFaceId));
-            for (auto nextComponentFaceId : nextComponentFaceIds)
-                if (!face_visited.at(nextComponentFaceId)) {
-                    face_visited.at(nextComponentFaceId) = true;
-                    chordComponentFaceIds.push_back(nextComponentFaceId);
-                    q.push(nextComponentFaceId);
-                }
+        const size_t componentFaceId = q.front();
+        q.pop();
+
+        for (auto neighborComponentCellId : baseComplex.componentF.at(componentFaceId).N_Cids)
+            if (cellChordIds.at(neighborComponentCellId) != chordId) {
+                cellChordIds.at(neighborComponentCellId) = chordId;
+                chordComponentCellIds.push_back(neighborComponentCellId);
+                for (auto componentEdgeId : baseComplex.componentC.at(neighborComponentCellId).Eids)
+                    if (edgeChordIds.at(componentEdgeId) != chordId) {
+                        edgeChordIds.at(componentEdgeId) = chordId;
+                        chordComponentEdgeIds.push_back(componentEdgeId);
+                    }
+            }
+        for (auto neighborComponentCellId : baseComplex.componentF.at(componentFaceId).N_Cids) {
+            const size_t nextComponentFaceId = GetOppositeComponentFaceId(neighborComponentCellId, componentFaceId);
+            if (nextComponentFaceId != MAXID && faceChordIds.at(nextComponentFaceId) != chordId) {
+                faceChordIds.at(nextComponentFaceId) = chordId;
+                chordComponentFaceIds.push_back(nextComponentFaceId);
+                q.push(nextComponentFaceId);
+            }
         }
     }
 }
@@ -119,14 +165,8 @@ void BaseComplexChord::GetParallelComponents(const ComponentFace & componentFace
 std::vector<size_t> BaseComplexChord::GetParallelComponentFaceIds(const ComponentFace & componentFace) const{
     std::vector<size_t> res;
     for (auto neighborComponentCellId : baseComplex.componentF.at(componentFace.id).N_Cids) {
-        for (auto componentFaceId : baseComplex.componentC.at(neighborComponentCellId).Fids) {
-            auto& componentCellFace = baseComplex.componentF.at(componentFaceId);
-            auto vids = baseComplex.componentF.at(componentFace.id).Vids;
-            std::copy(componentCellFace.Vids.begin(), componentCellFace.Vids.end(), back_inserter(vids));
-            std::sort(vids.begin(), vids.end());
-            auto num = std::distance(vids.begin(), std::unique(vids.begin(), vids.end()));
-            if (num == 8) res.push_back(componentFaceId);
-        }
+        const size_t componentFaceId = GetOppositeComponentFaceId(neighborComponentCellId, componentFace.id);
+        if (componentFaceId != MAXID) res.push_back(componentFaceId);
     }
     return res;
 }
@@ -591,30 +631,26 @@ std::vector<size_t> BaseComplexChord::GetLinkedChordComponentCellIds(const std::
         }
     }
 
-    for (int i = 1; i < linkedChordComponentFaceIds.size(); ++i) {
-        auto id1 = linkedChordComponentFaceIds.at(i - 1);
-        auto id2 = linkedChordComponentFaceIds.at(i);
-        for (auto componentCellId : chordComponentCellIds) {
-            const auto& componentCell = baseComplex.componentC.at(componentCellId);
-            size_t count = 0;
-            for (auto componentFaceId : componentCell.Fids) {
-                if (componentFaceId == id1 || componentFaceId == id2 ) ++count;
-            }
-            if (count == 2) res.push_back(componentCellId);
+    // cells between consecutive faces are the common neighbors of the two faces, kept in chord order
+    std::unordered_map<size_t, size_t> chordPos;
+    for (size_t i = 0; i < chordComponentCellIds.size(); ++i)
+        chordPos[chordComponentCellIds[i]] = i;
+    auto add_cells_between = [&](const size_t id1, const size_t id2) {
+        std::vector<std::pair<size_t, size_t>> cells;
+        const auto& n_cids2 = baseComplex.componentF.at(id2).N_Cids;
+        for (auto componentCellId : baseComplex.componentF.at(id1).N_Cids) {
+            auto iter = chordPos.find(componentCellId);
+            if (iter != chordPos.end() && std::find(n_cids2.begin(), n_cids2.end(), componentCellId) != n_cids2.end())
+                cells.push_back(std::make_pair(iter->second, componentCellId));
         }
-    }
-    if (isLoop && linkedChordComponentFaceIds.size() != 0 && linkedChordComponentFaceIds.size() != 2) {
-        auto id1 = linkedChordComponentFaceIds.front();
-        auto id2 = linkedChordComponentFaceIds.back();
-        for (auto componentCellId : chordComponentCellIds) {
-            const auto& componentCell = baseComplex.componentC.at(componentCellId);
-            size_t count = 0;
-            for (auto componentFaceId : componentCell.Fids) {
-                if (componentFaceId == id1 || componentFaceId == id2 ) ++count;
-            }
-            if (count == 2) res.push_back(componentCellId);
-        }
-    }
+        std::sort(cells.begin(), cells.end());
+        for (auto& cell : cells)
+            res.push_back(cell.second);
+    };
+    for (size_t i = 1; i < linkedChordComponentFaceIds.size(); ++i)
+        add_cells_between(linkedChordComponentFaceIds.at(i - 1), linkedChordComponentFaceIds.at(i));
+    if (isLoop && linkedChordComponentFaceIds.size() != 0 && linkedChordComponentFaceIds.size() != 2)
+        add_cells_between(linkedChordComponentFaceIds.front(), linkedChordComponentFaceIds.back());
     return res;
 }
 
@@ -640,6 +676,7 @@ std::vector<size_t> BaseComplexChord::GetLinkedChordComponentFaceIds(const std::
     while (!st.empty()) {
         auto id = st.top();
         st.pop();
+        if (ids_visited[id]) continue;  // pushed twice by the two neighbors closing a loop
         ids_visited[id] = true;
         res.push_back(id);
         const auto& componentFace = baseComplex.componentF.at(id);
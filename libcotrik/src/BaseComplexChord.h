@@ -44,11 +44,21 @@ public:
     std::vector<glm::dvec3> GetLinkedChordCurveVertices(const std::vector<size_t>& linkedChordComponentFaceIds, const std::vector<size_t>& linkedChordComponentCellIds) const;
     glm::dvec3 GetCenter(const ComponentFace& c) const;
     glm::dvec3 GetCenter(const ComponentCell& c) const;
+private:
+    void BuildOppositeComponentFaces();
+    size_t GetOppositeComponentFaceId(const size_t componentCellId, const size_t componentFaceId) const;
+    // visited flags are the id of the chord that visited, so one set of arrays serves all chords
+    void GetParallelComponents(const ComponentFace & componentFace, const size_t chordId,
+            std::vector<size_t>& edgeChordIds, std::vector<size_t>& faceChordIds, std::vector<size_t>& cellChordIds,
+            std::vector<size_t>& chordComponentEdgeIds, std::vector<size_t>& chordComponentFaceIds, std::vector<size_t>& chordComponentCellIds) const;
 public:
     BaseComplex& baseComplex;
     std::vector<std::vector<size_t>> chords_componentEdgeIds;  // each sheet consists a list of base-complex componentEdge ids;
     std::vector<std::vector<size_t>> chords_componentFaceIds;  // each sheet consists a list of base-complex componentFace ids;
     std::vector<std::vector<size_t>> chords_componentCellIds;  // each sheet consists a list of base-complex componentCell ids;
+private:
+    std::vector<size_t> oppositeComponentFaceOffsets;   // per componentCell, into oppositeComponentFaceIds
+    std::vector<size_t> oppositeComponentFaceIds;       // the face of the componentCell opposite to each of its Fids
 };
 
 #endif /* LIBCOTRIK_SRC_BASECOMPLEXCHORD_H_ */
@@ -0,0 +1,172 @@
+/*
+ * DiagnosticsSink.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "DiagnosticsSink.h"
+#include <fstream>
+#include <iomanip>
+#include <memory>
+
+DiagnosticsSink::DiagnosticsSink(const size_t every/* = 1*/)
+: every(every)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+DiagnosticsSink::~DiagnosticsSink()
+{
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    worker.join();
+}
+
+bool DiagnosticsSink::IsDue(const size_t iter) const
+{
+    return every != 0 && iter % every == 0;
+}
+
+// the thread is started by the first job, optimizers that never write don't pay for it
+void DiagnosticsSink::Post(std::function<void()>&& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    if (!worker.joinable()) worker = std::thread(&DiagnosticsSink::Work, this);
+    wakeup.notify_one();
+}
+
+void DiagnosticsSink::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [&] { return jobs.empty() && !busy; });
+}
+
+void DiagnosticsSink::Work()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeup.wait(lock, [&] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) break;
+        std::function<void()> job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+        job();
+        lock.lock();
+        busy = false;
+        if (jobs.empty()) idle.notify_all();
+    }
+}
+
+std::vector<glm::dvec3> DiagnosticsSink::GetPositions(const std::vector<Vertex>& V)
+{
+    std::vector<glm::dvec3> positions(V.size());
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)V.size(); i++)
+        positions[i] = V[i].xyz();
+    return positions;
+}
+
+void DiagnosticsSink::WriteMesh(const Mesh& mesh, const std::string& filename)
+{
+    WriteCells(mesh, GetPositions(mesh.V), NULL, filename);
+}
+
+void DiagnosticsSink::WriteMesh(const Mesh& mesh, const std::vector<size_t>& cellIds, const std::string& filename)
+{
+    WriteCells(mesh, GetPositions(mesh.V), &cellIds, filename);
+}
+
+void DiagnosticsSink::WriteMesh(const Mesh& mesh, const std::vector<glm::dvec3>& positions, const std::string& filename)
+{
+    WriteCells(mesh, std::vector<glm::dvec3>(positions), NULL, filename);
+}
+
+static int GetVtkCellType(const ElementType m_cellType, const Cell& c)
+{
+    if (m_cellType == HEXAHEDRA) return VTK_HEXAHEDRON;
+    if (m_cellType == TETRAHEDRA) return VTK_TETRA;
+    if (m_cellType == QUAD) return VTK_QUAD;
+    if (m_cellType == TRIANGLE) return VTK_TRIANGLE;
+    if (m_cellType == POLYGON) return VTK_POLYGON;
+    return c.cellType;
+}
+
+void DiagnosticsSink::WriteCells(const Mesh& mesh, std::vector<glm::dvec3>&& points, const std::vector<size_t>* cellIds, const std::string& filename)
+{
+    // vtk CELLS layout, the number of vertices followed by the vertex ids of every cell
+    const size_t numOfCells = cellIds ? cellIds->size() : mesh.C.size();
+    std::shared_ptr<std::vector<size_t>> cells = std::make_shared<std::vector<size_t>>();
+    std::shared_ptr<std::vector<int>> types = std::make_shared<std::vector<int>>(numOfCells);
+    for (size_t i = 0; i < numOfCells; i++) {
+        const Cell& c = mesh.C.at(cellIds ? cellIds->at(i) : i);
+        cells->push_back(c.Vids.size());
+        cells->insert(cells->end(), c.Vids.begin(), c.Vids.end());
+        types->at(i) = GetVtkCellType(mesh.m_cellType, c);
+    }
+    std::shared_ptr<std::vector<glm::dvec3>> V = std::make_shared<std::vector<glm::dvec3>>(std::move(points));
+    Post([=] {
+        std::ofstream ofs(filename.c_str());
+        ofs << "# vtk DataFile Version 3.0\n"
+            << filename << "\n"
+            << "ASCII\n\n"
+            << "DATASET UNSTRUCTURED_GRID\n";
+        ofs << "POINTS " << V->size() << " double\n";
+        ofs << std::fixed << std::setprecision(7);
+        for (const auto& v : *V)
+            ofs << v.x << " " << v.y << " " << v.z << "\n";
+        ofs << "CELLS " << types->size() << " " << cells->size() << "\n";
+        for (size_t k = 0; k < cells->size(); k += cells->at(k) + 1) {
+            ofs << cells->at(k);
+            for (size_t j = 1; j <= cells->at(k); j++)
+                ofs << " " << cells->at(k + j);
+            ofs << "\n";
+        }
+        ofs << "CELL_TYPES " << types->size() << "\n";
+        for (auto type : *types)
+            ofs << type << "\n";
+    });
+}
+
+void DiagnosticsSink::WritePolyData(std::vector<glm::dvec3>&& points, std::vector<size_t>&& vertices, std::vector<size_t>&& lines,
+        std::vector<size_t>&& labels, const std::string& filename)
+{
+    std::shared_ptr<std::vector<glm::dvec3>> P = std::make_shared<std::vector<glm::dvec3>>(std::move(points));
+    std::shared_ptr<std::vector<size_t>> verts = std::make_shared<std::vector<size_t>>(std::move(vertices));
+    std::shared_ptr<std::vector<size_t>> L = std::make_shared<std::vector<size_t>>(std::move(lines));
+    std::shared_ptr<std::vector<size_t>> cellLabels = std::make_shared<std::vector<size_t>>(std::move(labels));
+    Post([=] {
+        std::ofstream ofs(filename.c_str());
+        ofs << "# vtk DataFile Version 2.0\n"
+            << filename << "\n"
+            << "ASCII\n\n"
+            << "DATASET POLYDATA\n";
+        ofs << "POINTS " << P->size() << " double\n";
+        ofs << std::fixed << std::setprecision(7);
+        for (const auto& p : *P)
+            ofs << p.x << " " << p.y << " " << p.z << "\n";
+        if (!verts->empty()) {
+            ofs << "VERTICES " << verts->size() << " " << 2 * verts->size() << "\n";
+            for (auto vid : *verts)
+                ofs << "1 " << vid << "\n";
+        }
+        ofs << "LINES " << L->size() / 2 << " " << 3 * (L->size() / 2) << "\n";
+        for (size_t i = 0; i + 1 < L->size(); i += 2)
+            ofs << "2 " << L->at(i) << " " << L->at(i + 1) << "\n";
+        if (cellLabels->empty()) return;
+        ofs << "CELL_DATA " << cellLabels->size() << "\n"
+            << "SCALARS " << " Label" << " int 1\n"
+            << "LOOKUP_TABLE default\n";
+        for (auto label : *cellLabels)
+            ofs << label << "\n";
+    });
+}
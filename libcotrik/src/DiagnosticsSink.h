@@ -0,0 +1,63 @@
+/*
+ * DiagnosticsSink.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_DIAGNOSTICSSINK_H_
+#define LIBCOTRIK_SRC_DIAGNOSTICSSINK_H_
+
+#include "Mesh.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Per-iteration vtk output of the optimizers. The Write functions copy only the positions and the
+// cells they need and return at once, a background thread serializes the files in the order they
+// were queued. Iteration dumps go through IsDue(iter), so they can be throttled to every K
+// iterations or turned off with every = 0; result files such as opt.vtk are written regardless.
+class DiagnosticsSink
+{
+public:
+    DiagnosticsSink(const size_t every = 1);
+    virtual ~DiagnosticsSink();     // writes everything still queued
+private:
+    DiagnosticsSink(const DiagnosticsSink&);
+    DiagnosticsSink& operator = (const DiagnosticsSink&);
+public:
+    bool IsDue(const size_t iter) const;
+    // all cells of the mesh, or only cellIds, over all of its vertices
+    void WriteMesh(const Mesh& mesh, const std::string& filename);
+    void WriteMesh(const Mesh& mesh, const std::vector<size_t>& cellIds, const std::string& filename);
+    // same as above at the given positions, e.g. a kept copy of an earlier iterate
+    void WriteMesh(const Mesh& mesh, const std::vector<glm::dvec3>& positions, const std::string& filename);
+    // polydata: vertices are point ids, lines are pairs of point ids; one label per vertex and line or none
+    void WritePolyData(std::vector<glm::dvec3>&& points, std::vector<size_t>&& vertices, std::vector<size_t>&& lines,
+            std::vector<size_t>&& labels, const std::string& filename);
+    void Post(std::function<void()>&& job);
+    // blocks until the queue is empty
+    void Flush();
+
+    static std::vector<glm::dvec3> GetPositions(const std::vector<Vertex>& V);
+
+private:
+    void WriteCells(const Mesh& mesh, std::vector<glm::dvec3>&& points, const std::vector<size_t>* cellIds, const std::string& filename);
+    void Work();
+
+public:
+    size_t every;
+
+private:
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable idle;
+    bool busy = false;
+    bool stopping = false;
+    std::thread worker;
+};
+
+#endif /* LIBCOTRIK_SRC_DIAGNOSTICSSINK_H_ */
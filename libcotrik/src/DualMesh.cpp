@@ -1,5 +1,4 @@
 #include "DualMesh.h"
-#include "MeshFileWriter.h"
 #include <iostream>
 #include <set>
 #include <map>
@@ -111,70 +110,33 @@ std::vector<size_t> get_link_fids(const Mesh& mesh, const Vertex& v, std::map<si
 	return ringFids;
 }
 
-std::vector<size_t> get_link_cids(const Mesh& mesh, const Edge& e) {
-	if (e.isBoundary) return {};
-	auto cids = e.N_Cids;
-	std::vector<size_t> ringCids;
-	ringCids.push_back(cids.back());
-	cids.pop_back();
-	while (ringCids.size() < e.N_Cids.size()) {
-		auto last_cid = ringCids.back();
-		int j = 0;
-		for (auto next_cid : cids) {
-			auto& last_c = mesh.C.at(last_cid);
-			std::set<size_t> vids(last_c.Vids.begin(), last_c.Vids.end());
-			auto& next_c = mesh.C.at(next_cid);
-			vids.insert(next_c.Vids.begin(), next_c.Vids.end());
-			if (vids.size() == last_c.Vids.size() + next_c.Vids.size() - 4) {
-				ringCids.push_back(next_cid);
-				cids.erase(cids.begin() + j);
-				break;
-			}
-			++j;
-		}
-	}
-	return ringCids;
-}
-
-std::vector<size_t> get_link_cids(const Mesh& mesh, const Edge& e, std::vector<size_t>& ringCids) {
-	if (!e.isBoundary) return {};
-	auto cids = e.N_Cids;
-	for (auto iter = cids.begin(); iter != cids.end(); ++iter)
-		if (*iter == ringCids.back()) {
-			cids.erase(iter);
-			break;
-		}
-	while (ringCids.size() < e.N_Cids.size()) {
-		auto last_cid = ringCids.back();
-		int j = 0;
-		for (auto next_cid : cids) {
-			auto& last_c = mesh.C.at(last_cid);
-			std::set<size_t> vids(last_c.Vids.begin(), last_c.Vids.end());
-			auto& next_c = mesh.C.at(next_cid);
-			vids.insert(next_c.Vids.begin(), next_c.Vids.end());
-			if (vids.size() == last_c.Vids.size() + next_c.Vids.size() - 4) {
-				ringCids.push_back(next_cid);
-				cids.erase(cids.begin() + j);
-				break;
-			}
-			++j;
+// Writes the cells around e to ringCids in the order of the walk through the faces of e and returns how many.
+// Starts like the former search: from the last cell of e.N_Cids towards its neighbor that comes first in e.N_Cids,
+// or for a boundary edge from the cell of its first boundary face.
+static size_t get_link_cids(const Mesh& mesh, const Edge& e, const size_t startCid, size_t* ringCids) {
+	auto position = [&](const size_t cid) {
+		return std::find(e.N_Cids.begin(), e.N_Cids.end(), cid) - e.N_Cids.begin();
+	};
+	size_t n = 0;
+	size_t prevCid = MAXID;
+	size_t cid = startCid;
+	while (cid != MAXID && n < e.N_Cids.size()) {
+		ringCids[n++] = cid;
+		size_t nextCid = MAXID;
+		for (auto fid : e.N_Fids) {
+			auto& f = mesh.F.at(fid);
+			if (f.N_Cids.size() != 2) continue;
+			const size_t ncid = f.N_Cids[0] == cid ? f.N_Cids[1] : (f.N_Cids[1] == cid ? f.N_Cids[0] : MAXID);
+			if (ncid == MAXID || ncid == prevCid || ncid == startCid) continue;
+			if (nextCid == MAXID || position(ncid) < position(nextCid)) nextCid = ncid;
 		}
+		prevCid = cid;
+		cid = nextCid;
 	}
-	return ringCids;
-}
-
-std::vector<size_t> get_link_cids(const Mesh& mesh, const Edge& e, std::map<size_t, size_t>& boundaryFid_dualVid) {
-	std::vector<size_t> ringCids;
-	std::vector<size_t> boundaryFids;
-	for (auto fid : e.N_Fids) {
-		auto& f = mesh.F.at(fid);
-		if (f.isBoundary) boundaryFids.push_back(f.id);
-	}
-	ringCids.push_back(mesh.F.at(boundaryFids.front()).N_Cids.front());
-	get_link_cids(mesh, e, ringCids);
-	ringCids.push_back(boundaryFid_dualVid[boundaryFids.back()]);
-	ringCids.push_back(boundaryFid_dualVid[boundaryFids.front()]);
-	return ringCids;
+	// not a manifold fan, keep the remaining cells in their order
+	for (auto ncid : e.N_Cids)
+		if (n < e.N_Cids.size() && std::find(ringCids, ringCids + n, ncid) == ringCids + n) ringCids[n++] = ncid;
+	return n;
 }
 
 void DualMesh::Build(const Mesh& mesh) {
@@ -193,17 +155,17 @@ void DualMesh::Build(const Mesh& mesh) {
 		BuildC(mesh);
 	} else if (mesh.m_cellType == TETRAHEDRA || mesh.m_cellType == HEXAHEDRA) {
 		m_cellType = POLYHEDRA;
-		size_t numOfBoundaryF = 0;	
-		for (auto& f : mesh.F) if (f.isBoundary) ++numOfBoundaryF;
-		std::map<size_t, size_t> boundaryFid_dualVid;
-		std::map<size_t, size_t> vid_dualFid;
+		size_t numOfBoundaryF = 0;
+		std::vector<size_t> boundaryFid_dualVid(mesh.F.size(), MAXID);
+		for (auto& f : mesh.F)
+			if (f.isBoundary) boundaryFid_dualVid[f.id] = mesh.C.size() + numOfBoundaryF++;
+		std::vector<size_t> vid_dualFid(mesh.V.size(), MAXID);
 		V.resize(mesh.C.size() + numOfBoundaryF);
 		BuildV(mesh);
-		BuildF(mesh, boundaryFid_dualVid, vid_dualFid);
-		C.reserve(mesh.V.size());
-		BuildC(mesh, boundaryFid_dualVid, vid_dualFid);
-		MeshFileWriter writer(V, F, "F.vtk", POLYGON);
-		writer.WriteFacesVtk();
+		std::vector<size_t> linkOffsets, linkVids;
+		BuildLinks(mesh, boundaryFid_dualVid, linkOffsets, linkVids);
+		BuildF(mesh, boundaryFid_dualVid, linkOffsets, linkVids, vid_dualFid);
+		BuildC(mesh, linkOffsets, linkVids, vid_dualFid);
 	}
 	//} else if (mesh.m_cellType == TETRAHEDRA || mesh.m_cellType == HEXAHEDRA) {
 	//	m_cellType = POLYHEDRA;
@@ -319,46 +281,64 @@ void DualMesh::BuildBoundaryV(const Mesh& mesh) {
 	}
 }
 
-void DualMesh::BuildF(const Mesh& mesh, std::map<size_t, size_t>& boundaryFid_dualVid, std::map<size_t, size_t>& vid_dualFid) {
-	size_t numOfBoundaryF = 0;
-	//std::map<size_t, size_t> boundaryFid_dualVid;
-	for (auto& f : mesh.F)
-		if (f.isBoundary) boundaryFid_dualVid[f.id] = mesh.C.size() + numOfBoundaryF++;
-	std::map<size_t, std::vector<size_t>> eid_dualCids;
-	for (auto& e : mesh.E) {
-		if (!e.isBoundary) eid_dualCids[e.id] = get_link_cids(mesh, e);
-		else eid_dualCids[e.id] = get_link_cids(mesh, e, boundaryFid_dualVid);
+// every edge's ring of dual vertices, evaluated once: linkVids[linkOffsets[eid], linkOffsets[eid + 1]),
+// a boundary edge's ring is closed by the dual vertices of its last and first boundary face
+void DualMesh::BuildLinks(const Mesh& mesh, const std::vector<size_t>& boundaryFid_dualVid, std::vector<size_t>& linkOffsets, std::vector<size_t>& linkVids) {
+	linkOffsets.assign(mesh.E.size() + 1, 0);
+	for (size_t i = 0; i < mesh.E.size(); ++i) {
+		auto& e = mesh.E.at(i);
+		linkOffsets[i + 1] = linkOffsets[i] + e.N_Cids.size() + (e.isBoundary ? 2 : 0);
 	}
-	size_t numOfBoundaryV = 0;
-	std::map<size_t, std::vector<size_t>> vid_dualFids;
-	//std::map<size_t, size_t> vid_dualFid;
+	linkVids.assign(linkOffsets.back(), MAXID);
+#pragma omp parallel for
+	for (long long i = 0; i < (long long)mesh.E.size(); ++i) {
+		auto& e = mesh.E[i];
+		size_t* ring = linkVids.data() + linkOffsets[i];
+		if (!e.isBoundary) {
+			get_link_cids(mesh, e, e.N_Cids.back(), ring);
+			continue;
+		}
+		size_t frontFid = MAXID, backFid = MAXID;
+		for (auto fid : e.N_Fids)
+			if (mesh.F.at(fid).isBoundary) {
+				if (frontFid == MAXID) frontFid = fid;
+				backFid = fid;
+			}
+		const size_t n = get_link_cids(mesh, e, mesh.F.at(frontFid).N_Cids.front(), ring);
+		ring[n] = boundaryFid_dualVid[backFid];
+		ring[n + 1] = boundaryFid_dualVid[frontFid];
+	}
+}
+
+void DualMesh::BuildF(const Mesh& mesh, const std::vector<size_t>& boundaryFid_dualVid, const std::vector<size_t>& linkOffsets, const std::vector<size_t>& linkVids,
+	std::vector<size_t>& vid_dualFid) {
+	std::vector<size_t> boundaryVids;
 	for (auto& v : mesh.V)
 		if (v.isBoundary) {
-			vid_dualFids[v.id] = get_link_fids_boundary(mesh, v);
-			vid_dualFid[v.id] = mesh.E.size() + numOfBoundaryV++;
+			vid_dualFid[v.id] = mesh.E.size() + boundaryVids.size();
+			boundaryVids.push_back(v.id);
 		}
-	size_t id = 0;
 	for (auto& f : mesh.F) {
 		if (!f.isBoundary) continue;
-		auto& v = V.at(mesh.C.size() + id);
-		v.id = mesh.C.size() + id++;
+		auto& v = V.at(boundaryFid_dualVid[f.id]);
+		v.id = boundaryFid_dualVid[f.id];
 		for (auto vid : f.Vids) v += mesh.V.at(vid).xyz();
 		v /= f.Vids.size();
 	}
-	F.reserve(mesh.E.size() + numOfBoundaryV);
-	Face f;
-	for (auto& item : eid_dualCids) {
-		f.id = item.first;
-		f.Vids = item.second;
-		F.push_back(f);
+	F.resize(mesh.E.size() + boundaryVids.size());
+#pragma omp parallel for
+	for (long long i = 0; i < (long long)mesh.E.size(); ++i) {
+		auto& f = F[i];
+		f.id = i;
+		f.Vids.assign(linkVids.begin() + linkOffsets[i], linkVids.begin() + linkOffsets[i + 1]);
 	}
-	id = mesh.E.size();
-	for (auto& item : vid_dualFids) {
-		f.id = id++;
-		f.Vids = item.second;
+#pragma omp parallel for
+	for (long long i = 0; i < (long long)boundaryVids.size(); ++i) {
+		auto& f = F[mesh.E.size() + i];
+		f.id = mesh.E.size() + i;
+		f.Vids = get_link_fids_boundary(mesh, mesh.V.at(boundaryVids[i]));
 		for (auto& vid : f.Vids)
 			vid = boundaryFid_dualVid[vid];
-		F.push_back(f);
 	}
 }
 
@@ -384,25 +364,20 @@ void DualMesh::BuildC(const Mesh& mesh) {
 	}
 }
 
-void DualMesh::BuildC(const Mesh& mesh, std::map<size_t, size_t>& boundaryFid_dualVid, std::map<size_t, size_t>& vid_dualFid) {
-	Cell c;
-	for (auto& v : mesh.V) {
+void DualMesh::BuildC(const Mesh& mesh, const std::vector<size_t>& linkOffsets, const std::vector<size_t>& linkVids, const std::vector<size_t>& vid_dualFid) {
+	C.resize(mesh.V.size());
+#pragma omp parallel for
+	for (long long i = 0; i < (long long)mesh.V.size(); ++i) {
+		auto& v = mesh.V[i];
+		auto& c = C[i];
 		c.id = v.id;
 		c.cellType = VTK_POLYHEDRON;
-		std::set<size_t> vids;
-		c.Fids.clear();
-		for (auto eid : v.N_Eids) {
-			auto& e = mesh.E.at(eid);
-			std::vector<size_t> linkVids;
-			if (!e.isBoundary) linkVids = get_link_cids(mesh, e);
-			else linkVids = get_link_cids(mesh, e, boundaryFid_dualVid);
-			vids.insert(linkVids.begin(), linkVids.end());
-			c.Fids.push_back(e.id);
-		}
-		c.Vids.clear();
-		std::copy(vids.begin(), vids.end(), std::back_inserter(c.Vids));
+		c.Fids = v.N_Eids;
+		for (auto eid : v.N_Eids)
+			c.Vids.insert(c.Vids.end(), linkVids.begin() + linkOffsets[eid], linkVids.begin() + linkOffsets[eid + 1]);
+		std::sort(c.Vids.begin(), c.Vids.end());
+		c.Vids.resize(std::distance(c.Vids.begin(), std::unique(c.Vids.begin(), c.Vids.end())));
 		if (v.isBoundary) c.Fids.push_back(vid_dualFid[v.id]);
-		C.push_back(c);
 	}
 }
 
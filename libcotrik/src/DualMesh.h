@@ -10,9 +10,11 @@ public:
 	void Build(const Mesh& mesh);
 	void BuildV(const Mesh& mesh);
 	void BuildBoundaryV(const Mesh& mesh);
-	void BuildF(const Mesh& mesh, std::map<size_t, size_t>& boundaryFid_dualVid, std::map<size_t, size_t>& vid_dualFid);
+	void BuildLinks(const Mesh& mesh, const std::vector<size_t>& boundaryFid_dualVid, std::vector<size_t>& linkOffsets, std::vector<size_t>& linkVids);
+	void BuildF(const Mesh& mesh, const std::vector<size_t>& boundaryFid_dualVid, const std::vector<size_t>& linkOffsets, const std::vector<size_t>& linkVids,
+		std::vector<size_t>& vid_dualFid);
 	void BuildC(const Mesh& mesh);
-	void BuildC(const Mesh& mesh, std::map<size_t, size_t>& boundaryFid_dualVid, std::map<size_t, size_t>& vid_dualFid);
+	void BuildC(const Mesh& mesh, const std::vector<size_t>& linkOffsets, const std::vector<size_t>& linkVids, const std::vector<size_t>& vid_dualFid);
 	void Build_skip_singularities(const Mesh& mesh);
 	//virtual void FixOrientation(const Mesh& mesh);
 	virtual void FixOrientation(Mesh& mesh);
@@ -187,7 +187,7 @@ size_t EdgeLine::BuildFrom(const Mesh& mesh, size_t startVId, size_t startEdgeId
 void EdgeLines::Build()
 {
     size_t edgelineId = 0;
-    std::vector<size_t> visitedEdgeIds;
+    std::vector<bool> visitedEdges(mesh.E.size(), false);
     std::vector<size_t> edgesLabels(mesh.E.size(), MAXID);
     for (size_t i = 0; i < mesh.F.size(); i++) {
         const Face& face = mesh.F.at(i);
@@ -198,16 +198,16 @@ void EdgeLines::Build()
                 const size_t startEdgeId = face.N_Ortho_4Eids.at(j).at(k);
                 const Edge& startEdge = mesh.E.at(startEdgeId);
                 const size_t startVId = mesh.V.at(startEdge.Vids.at(0)).isBoundary ? startEdge.Vids.at(0) : startEdge.Vids.at(1);
-                if (!Util::Find(visitedEdgeIds, startEdgeId)) {
-                    visitedEdgeIds.push_back(startEdgeId);
+                if (!visitedEdges.at(startEdgeId)) {
+                    visitedEdges.at(startEdgeId) = true;
                     EdgeLine edgeline;
                     edgeline.id = edgelineId++;
                     const size_t endEdgeId = edgeline.BuildFrom(mesh, startVId, startEdgeId, face.id);
                     for (size_t k = 0; k < edgeline.Eids.size(); k++)
                         edgesLabels.at(edgeline.Eids.at(k)) = edgeline.id;
                     edgeLines.push_back(edgeline);
-                    if (!Util::Find(visitedEdgeIds, endEdgeId)) {
-                        visitedEdgeIds.push_back(endEdgeId);
+                    if (!visitedEdges.at(endEdgeId)) {
+                        visitedEdges.at(endEdgeId) = true;
                     }
                 }
             }
@@ -224,16 +224,16 @@ void EdgeLines::Build()
             const size_t startVId = v1.isSingularity ? v1Id : v2Id;
             const Vertex& v = mesh.V.at(startVId);
             if (v.isSingularity)
-            if (!Util::Find(visitedEdgeIds, startEdgeId)) {
-                visitedEdgeIds.push_back(startEdgeId);
+            if (!visitedEdges.at(startEdgeId)) {
+                visitedEdges.at(startEdgeId) = true;
                 EdgeLine edgeline;
                 edgeline.id = edgelineId++;
                 const size_t endEdgeId = edgeline.BuildFrom(mesh, startVId, startEdgeId);
                 for (size_t k = 0; k < edgeline.Eids.size(); k++)
                     edgesLabels.at(edgeline.Eids.at(k)) = edgeline.id;
                 edgeLines.push_back(edgeline);
-                if (!Util::Find(visitedEdgeIds, endEdgeId)) {
-                    visitedEdgeIds.push_back(endEdgeId);
+                if (!visitedEdges.at(endEdgeId)) {
+                    visitedEdges.at(endEdgeId) = true;
                 }
             }
         }
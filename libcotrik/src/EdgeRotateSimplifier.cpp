@@ -6,6 +6,7 @@
  */
 
 #include "EdgeRotateSimplifier.h"
+#include "SortedIds.h"
 
 EdgeRotateSimplifier::EdgeRotateSimplifier(Mesh& mesh) : Simplifier(mesh) {
     // TODO Auto-generated constructor stub
@@ -97,11 +98,14 @@ std::set<size_t> EdgeRotateSimplifier::GetRotateEids(const Vertex& v, const std:
     for (auto& p : pairs) {
         auto& f0 = mesh.F.at(fids.at(p[0]));
         auto& f1 = mesh.F.at(fids.at(p[1]));
-        std::set<size_t> f0eids(f0.Eids.begin(), f0.Eids.end());
-        std::set<size_t> f1eids(f1.Eids.begin(), f1.Eids.end());
-        auto intersect_eids = Util::get_intersect(f0eids, f1eids);
+        SmallIds<4> f0eids(f0.Eids.begin(), f0.Eids.end());
+        SmallIds<4> f1eids(f1.Eids.begin(), f1.Eids.end());
+        SortIds(f0eids);
+        SortIds(f1eids);
+        SmallIds<4> intersect_eids;
+        IntersectIds(f0eids, f1eids, intersect_eids);
         if (intersect_eids.size() == 1) {
-            auto& e = mesh.E.at(*intersect_eids.begin());
+            auto& e = mesh.E.at(intersect_eids.front());
             auto vid = (v.id == e.Vids[0]) ? e.Vids[1] : e.Vids[0];
             if (mesh.V.at(vid).type == CORNER) continue;
             res.insert(e.id);
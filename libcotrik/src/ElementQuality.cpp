@@ -0,0 +1,353 @@
+/*
+ * ElementQuality.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "ElementQuality.h"
+#include "verdict.h"
+#include "VerdictVector.hpp"
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+
+// origin, xi, eta and zeta of the Jacobian at each corner, same frames as v_hex_scaled_jacobian
+static const int HexCornerFrames[8][4] =
+{
+    {0, 1, 3, 4},
+    {1, 2, 0, 5},
+    {2, 3, 1, 6},
+    {3, 0, 2, 7},
+    {4, 7, 5, 0},
+    {5, 4, 6, 1},
+    {6, 5, 7, 2},
+    {7, 6, 4, 3}
+};
+
+//                            sj      condition  shape  oddy  relative size
+static const double Lower[] = {0.0,    1.0,       0.3,   0.0,  0.5};
+static const double Upper[] = {DBL_MAX, 8.0,      1.0,   0.5,  1.0};
+static const double HistogramLower[] = {-1.0, 1.0, 0.0, 0.0, 0.0};
+static const double HistogramUpper[] = {1.0,  8.0, 1.0, 1.0, 1.0};
+
+QualityContext::QualityContext()
+{
+    std::copy(Lower, Lower + QUALITY_METRIC_COUNT, lower);
+    std::copy(Upper, Upper + QUALITY_METRIC_COUNT, upper);
+    std::copy(HistogramLower, HistogramLower + QUALITY_METRIC_COUNT, histogramLower);
+    std::copy(HistogramUpper, HistogramUpper + QUALITY_METRIC_COUNT, histogramUpper);
+}
+
+static double Clamp(const double value)
+{
+    return value > 0 ? std::min(value, (double)VERDICT_DBL_MAX) : std::max(value, (double)-VERDICT_DBL_MAX);
+}
+
+static double OddyComp(const VerdictVector& xxi, const VerdictVector& xet, const VerdictVector& xze, const double det)
+{
+    if (det <= VERDICT_DBL_MIN) return VERDICT_DBL_MAX;
+    const double g11 = xxi % xxi, g12 = xxi % xet, g13 = xxi % xze;
+    const double g22 = xet % xet, g23 = xet % xze, g33 = xze % xze;
+    const double normGSquared = g11 * g11 + 2.0 * g12 * g12 + 2.0 * g13 * g13 + g22 * g22 + 2.0 * g23 * g23 + g33 * g33;
+    const double normJSquared = g11 + g22 + g33;
+    return (normGSquared - 1.0 / 3.0 * normJSquared * normJSquared) / pow(det, 4.0 / 3.0);
+}
+
+void GetHexQuality(const double coordinates[8][3], const unsigned metrics, const QualityContext& context, double values[QUALITY_METRIC_COUNT])
+{
+    VerdictVector p[8];
+    for (int i = 0; i < 8; i++)
+        p[i].set(coordinates[i][0], coordinates[i][1], coordinates[i][2]);
+
+    // principal axes at the center, used by the scaled jacobian and oddy
+    bool degenerate = false;
+    double minScaledJacobian = VERDICT_DBL_MAX, maxCondition = 0, minShape = 1.0, maxOddy = 0, sumDet = 0;
+    if (metrics & (QUALITY_BIT(QUALITY_SCALED_JACOBIAN) | QUALITY_BIT(QUALITY_ODDY))) {
+        const VerdictVector xxi = p[1] + p[2] + p[5] + p[6] - p[0] - p[3] - p[4] - p[7];
+        const VerdictVector xet = p[2] + p[3] + p[6] + p[7] - p[0] - p[1] - p[4] - p[5];
+        const VerdictVector xze = p[4] + p[5] + p[6] + p[7] - p[0] - p[1] - p[2] - p[3];
+        const double det = xxi % (xet * xze);
+        const double l1 = xxi.length_squared(), l2 = xet.length_squared(), l3 = xze.length_squared();
+        if (l1 <= VERDICT_DBL_MIN || l2 <= VERDICT_DBL_MIN || l3 <= VERDICT_DBL_MIN) degenerate = true;
+        else minScaledJacobian = det / sqrt(l1 * l2 * l3);
+        maxOddy = std::max(maxOddy, OddyComp(xxi, xet, xze, det));
+    }
+
+    bool flat = false;
+    for (int n = 0; n < 8; n++) {
+        const int* f = HexCornerFrames[n];
+        const VerdictVector xxi = p[f[1]] - p[f[0]];
+        const VerdictVector xet = p[f[2]] - p[f[0]];
+        const VerdictVector xze = p[f[3]] - p[f[0]];
+        const double det = xxi % (xet * xze);
+        const double l1 = xxi.length_squared(), l2 = xet.length_squared(), l3 = xze.length_squared();
+        sumDet += det;
+        if (metrics & QUALITY_BIT(QUALITY_SCALED_JACOBIAN)) {
+            if (l1 <= VERDICT_DBL_MIN || l2 <= VERDICT_DBL_MIN || l3 <= VERDICT_DBL_MIN) degenerate = true;
+            else minScaledJacobian = std::min(minScaledJacobian, det / sqrt(l1 * l2 * l3));
+        }
+        if (metrics & QUALITY_BIT(QUALITY_CONDITION)) {
+            double condition = VERDICT_DBL_MAX;
+            if (det > VERDICT_DBL_MIN) {
+                const VerdictVector c1 = xxi * xet, c2 = xet * xze, c3 = xze * xxi;
+                condition = sqrt((l1 + l2 + l3) * ((c1 % c1) + (c2 % c2) + (c3 % c3))) / det;
+            }
+            maxCondition = std::max(maxCondition, condition);
+        }
+        if (det <= VERDICT_DBL_MIN) flat = true;
+        else if (metrics & QUALITY_BIT(QUALITY_SHAPE)) minShape = std::min(minShape, 3 * pow(det, 2.0 / 3.0) / (l1 + l2 + l3));
+        if (metrics & QUALITY_BIT(QUALITY_ODDY)) maxOddy = std::max(maxOddy, OddyComp(xxi, xet, xze, det));
+    }
+
+    if (metrics & QUALITY_BIT(QUALITY_SCALED_JACOBIAN))
+        values[QUALITY_SCALED_JACOBIAN] = degenerate ? VERDICT_DBL_MAX : Clamp(minScaledJacobian);
+    if (metrics & QUALITY_BIT(QUALITY_CONDITION))
+        values[QUALITY_CONDITION] = Clamp(maxCondition / 3.0);
+    if (metrics & QUALITY_BIT(QUALITY_SHAPE))
+        values[QUALITY_SHAPE] = flat || minShape <= VERDICT_DBL_MIN ? 0.0 : Clamp(minShape);
+    if (metrics & QUALITY_BIT(QUALITY_ODDY))
+        values[QUALITY_ODDY] = Clamp(maxOddy);
+    if (metrics & QUALITY_BIT(QUALITY_RELATIVE_SIZE_SQUARED)) {
+        // weighted Jacobian of v_hex_get_weight
+        const double scale = context.hexSize == 0 ? 0 : pow(context.hexSize, 0.33333333333);
+        const double detw = scale * (scale * scale);
+        double size = 0;
+        if (detw >= VERDICT_DBL_MIN && sumDet > VERDICT_DBL_MIN) {
+            const double tau = sumDet / (8 * detw);
+            size = std::min(tau, 1.0 / tau) * std::min(tau, 1.0 / tau);
+        }
+        values[QUALITY_RELATIVE_SIZE_SQUARED] = Clamp(size);
+    }
+}
+
+void GetQuadQuality(const double coordinates[4][3], const unsigned metrics, const QualityContext& context, double values[QUALITY_METRIC_COUNT])
+{
+    // collapsed quads are triangles for verdict, these calls do not touch its global sizes
+    double c[4][3];
+    std::copy(&coordinates[0][0], &coordinates[0][0] + 12, &c[0][0]);
+    const bool collapsed = c[3][0] == c[2][0] && c[3][1] == c[2][1] && c[3][2] == c[2][2];
+
+    VerdictVector e[4];
+    for (int i = 0; i < 4; i++)
+        e[i].set(c[(i + 1) % 4][0] - c[i][0], c[(i + 1) % 4][1] - c[i][1], c[(i + 1) % 4][2] - c[i][2]);
+    VerdictVector normal = (e[0] - e[2]) * (e[1] - e[3]);
+    normal.normalize();
+    double areas[4], lengthSquared[4];
+    for (int i = 0; i < 4; i++) {
+        areas[i] = normal % (e[(i + 3) % 4] * e[i]);
+        lengthSquared[i] = e[i].length_squared();
+    }
+
+    if (metrics & QUALITY_BIT(QUALITY_SCALED_JACOBIAN)) {
+        double minScaledJacobian = VERDICT_DBL_MAX;
+        double length[4];
+        bool degenerate = false;
+        for (int i = 0; i < 4; i++) {
+            length[i] = e[i].length();
+            if (length[i] < VERDICT_DBL_MIN) degenerate = true;
+        }
+        for (int i = 0; i < 4 && !degenerate; i++)
+            minScaledJacobian = std::min(minScaledJacobian, areas[i] / (length[i] * length[(i + 3) % 4]));
+        values[QUALITY_SCALED_JACOBIAN] = collapsed ? v_quad_scaled_jacobian(4, c) : degenerate ? 0.0 : Clamp(minScaledJacobian);
+    }
+    if (metrics & QUALITY_BIT(QUALITY_CONDITION)) {
+        double maxCondition = 0;
+        for (int i = 0; i < 4; i++)
+            maxCondition = std::max(maxCondition, areas[i] < VERDICT_DBL_MIN ? VERDICT_DBL_MAX : (lengthSquared[i] + lengthSquared[(i + 3) % 4]) / areas[i]);
+        values[QUALITY_CONDITION] = collapsed ? v_quad_condition(4, c) : Clamp(maxCondition / 2);
+    }
+    if (metrics & QUALITY_BIT(QUALITY_SHAPE)) {
+        double minShape = VERDICT_DBL_MAX;
+        bool degenerate = false;
+        for (int i = 0; i < 4; i++)
+            if (lengthSquared[i] <= VERDICT_DBL_MIN) degenerate = true;
+        for (int i = 0; i < 4 && !degenerate; i++)
+            minShape = std::min(minShape, areas[i] / (lengthSquared[i] + lengthSquared[(i + 3) % 4]));
+        minShape *= 2;
+        values[QUALITY_SHAPE] = degenerate || minShape < VERDICT_DBL_MIN ? 0.0 : Clamp(minShape);
+    }
+    if (metrics & QUALITY_BIT(QUALITY_ODDY)) {
+        double maxOddy = 0;
+        for (int i = 0; i < 4; i++) {
+            const VerdictVector first = -e[i];
+            const VerdictVector& second = e[(i + 3) % 4];
+            const double g11 = first % first, g12 = first % second, g22 = second % second;
+            const double g = g11 * g22 - g12 * g12;
+            maxOddy = std::max(maxOddy, g < VERDICT_DBL_MIN ? VERDICT_DBL_MAX : ((g11 - g22) * (g11 - g22) + 4. * g12 * g12) / 2. / g);
+        }
+        values[QUALITY_ODDY] = Clamp(maxOddy);
+    }
+    if (metrics & QUALITY_BIT(QUALITY_RELATIVE_SIZE_SQUARED)) {
+        // v_quad_relative_size_squared overwrites the size with the area of the quad itself, this uses context.quadSize
+        const double area = Clamp(0.25 * (areas[0] + areas[1] + areas[2] + areas[3]));
+        const double scale = sqrt(context.quadSize);
+        const double avgArea = scale * scale;
+        double size = 0;
+        if (avgArea > VERDICT_DBL_MIN) {
+            const double w = area / avgArea;
+            if (w > VERDICT_DBL_MIN) size = std::min(w, 1 / w) * std::min(w, 1 / w);
+        }
+        values[QUALITY_RELATIVE_SIZE_SQUARED] = Clamp(size);
+    }
+}
+
+void GetTetQuality(const double coordinates[4][3], const unsigned metrics, const QualityContext& context, double values[QUALITY_METRIC_COUNT])
+{
+    VerdictVector p[4];
+    for (int i = 0; i < 4; i++)
+        p[i].set(coordinates[i][0], coordinates[i][1], coordinates[i][2]);
+    const VerdictVector side0 = p[1] - p[0], side1 = p[2] - p[1], side2 = p[0] - p[2];
+    const VerdictVector side3 = p[3] - p[0], side4 = p[3] - p[1], side5 = p[3] - p[2];
+    const double jacobian = side3 % (side2 * side0);
+
+    if (metrics & QUALITY_BIT(QUALITY_SCALED_JACOBIAN)) {
+        const double l0 = side0.length_squared(), l1 = side1.length_squared(), l2 = side2.length_squared();
+        const double l3 = side3.length_squared(), l4 = side4.length_squared(), l5 = side5.length_squared();
+        const double lengthSquared[4] = {l0 * l2 * l3, l0 * l1 * l4, l1 * l2 * l5, l3 * l4 * l5};
+        const double lengthProduct = std::max(sqrt(*std::max_element(lengthSquared, lengthSquared + 4)), fabs(jacobian));
+        values[QUALITY_SCALED_JACOBIAN] = lengthProduct < VERDICT_DBL_MIN ? VERDICT_DBL_MAX : sqrt(2.0) * jacobian / lengthProduct;
+    }
+    if (metrics & QUALITY_BIT(QUALITY_CONDITION)) {
+        const VerdictVector c1 = side0;
+        const VerdictVector c2 = (-2 * side2 - side0) / sqrt(3.0);
+        const VerdictVector c3 = (3 * side3 + side2 - side0) / sqrt(6.0);
+        const VerdictVector c12 = c1 * c2, c23 = c2 * c3, c13 = c1 * c3;
+        const double term1 = c1 % c1 + c2 % c2 + c3 % c3;
+        const double term2 = c12 % c12 + c23 % c23 + c13 % c13;
+        const double det = c1 % (c2 * c3);
+        values[QUALITY_CONDITION] = fabs(det) <= VERDICT_DBL_MIN ? VERDICT_DBL_MAX : sqrt(term1 * term2) / (3.0 * det);
+    }
+    if (metrics & QUALITY_BIT(QUALITY_SHAPE)) {
+        double shape = 0;
+        if (jacobian >= VERDICT_DBL_MIN) {
+            const double num = 3 * pow(sqrt(2.0) * jacobian, 2.0 / 3.0);
+            const double den = 1.5 * (side0 % side0 + side2 % side2 + side3 % side3) - (side0 % -side2 + -side2 % side3 + side3 % side0);
+            if (den >= VERDICT_DBL_MIN) shape = std::max(num / den, 0.0);
+        }
+        values[QUALITY_SHAPE] = shape;
+    }
+    if (metrics & QUALITY_BIT(QUALITY_RELATIVE_SIZE_SQUARED)) {
+        // weighted Jacobian of v_tet_get_weight
+        VerdictVector w1(1, 0, 0), w2(0.5, 0.5 * sqrt(3.0), 0), w3(0.5, sqrt(3.0) / 6.0, sqrt(2.0) / sqrt(3.0));
+        const double scale = pow(6. * context.tetSize / (w1 % (w2 * w3)), 0.3333333333333);
+        w1 *= scale;
+        w2 *= scale;
+        w3 *= scale;
+        const double avgVolume = (w1 % (w2 * w3)) / 6.0;
+        double size = 0;
+        if (avgVolume >= VERDICT_DBL_MIN) {
+            size = jacobian / 6.0 / avgVolume;
+            if (size <= VERDICT_DBL_MIN) size = 0;
+            else if (size > 1) size = 1 / size;
+        }
+        values[QUALITY_RELATIVE_SIZE_SQUARED] = size * size;
+    }
+}
+
+// volume of v_hex_volume, area of v_quad_area or volume of v_tet_volume
+static double GetSize(const double coordinates[8][3], const ElementType type)
+{
+    VerdictVector p[8];
+    const int n = type == HEXAHEDRA ? 8 : 4;
+    for (int i = 0; i < n; i++)
+        p[i].set(coordinates[i][0], coordinates[i][1], coordinates[i][2]);
+    if (type == HEXAHEDRA) {
+        const VerdictVector xxi = p[1] + p[2] + p[5] + p[6] - p[0] - p[3] - p[4] - p[7];
+        const VerdictVector xet = p[2] + p[3] + p[6] + p[7] - p[0] - p[1] - p[4] - p[5];
+        const VerdictVector xze = p[4] + p[5] + p[6] + p[7] - p[0] - p[1] - p[2] - p[3];
+        return Clamp(xxi % (xet * xze) / 64.0);
+    }
+    if (type == TETRAHEDRA)
+        return (p[3] - p[0]) % ((p[0] - p[2]) * (p[1] - p[0])) / 6.0;
+    VerdictVector e[4];
+    for (int i = 0; i < 4; i++)
+        e[i] = p[(i + 1) % 4] - p[i];
+    VerdictVector normal = (e[0] - e[2]) * (e[1] - e[3]);
+    normal.normalize();
+    double area = 0;
+    for (int i = 0; i < 4; i++)
+        area += normal % (e[(i + 3) % 4] * e[i]);
+    return Clamp(0.25 * area);
+}
+
+void GetQualityStatistics(const Mesh& mesh, const unsigned metrics, const QualityContext& context, std::vector<QualityStatistics>& statistics)
+{
+    statistics.assign(QUALITY_METRIC_COUNT, QualityStatistics());
+    const ElementType type = mesh.m_cellType;
+    if (type != HEXAHEDRA && type != TETRAHEDRA && type != QUAD) return;
+    const long long n = type == QUAD ? mesh.F.size() : mesh.C.size();
+    const size_t numOfBins = std::max(context.numOfBins, (size_t)1);
+    const unsigned requested = type == TETRAHEDRA ? metrics & ~QUALITY_BIT(QUALITY_ODDY) : metrics;
+    auto getCoordinates = [&](const long long i, double coordinates[8][3]) {
+        const std::vector<size_t>& vids = type == QUAD ? mesh.F[i].Vids : mesh.C[i].Vids;
+        for (size_t j = 0; j < vids.size() && j < 8; j++) {
+            const Vertex& v = mesh.V[vids[j]];
+            coordinates[j][0] = v.x;
+            coordinates[j][1] = v.y;
+            coordinates[j][2] = v.z;
+        }
+    };
+
+    // the average size only when the relative size needs it and it is not given
+    QualityContext ctx(context);
+    double& size = type == HEXAHEDRA ? ctx.hexSize : type == TETRAHEDRA ? ctx.tetSize : ctx.quadSize;
+    if ((requested & QUALITY_BIT(QUALITY_RELATIVE_SIZE_SQUARED)) && size == 0 && n > 0) {
+        double sum = 0;
+#pragma omp parallel for reduction(+:sum)
+        for (long long i = 0; i < n; i++) {
+            double coordinates[8][3];
+            getCoordinates(i, coordinates);
+            sum += GetSize(coordinates, type);
+        }
+        size = sum / n;
+    }
+
+    for (int m = 0; m < QUALITY_METRIC_COUNT; m++)
+        if (requested & QUALITY_BIT(m)) {
+            statistics[m].numOfElements = n;
+            statistics[m].minValue = DBL_MAX;
+            statistics[m].maxValue = -DBL_MAX;
+            statistics[m].histogram.assign(numOfBins, 0);
+        }
+#pragma omp parallel
+    {
+        std::vector<QualityStatistics> local(statistics);
+        double values[QUALITY_METRIC_COUNT];
+#pragma omp for schedule(static)
+        for (long long i = 0; i < n; i++) {
+            double coordinates[8][3];
+            getCoordinates(i, coordinates);
+            if (type == HEXAHEDRA) GetHexQuality(coordinates, requested, ctx, values);
+            else if (type == TETRAHEDRA) GetTetQuality(coordinates, requested, ctx, values);
+            else GetQuadQuality(coordinates, requested, ctx, values);
+            for (int m = 0; m < QUALITY_METRIC_COUNT; m++) {
+                if (!(requested & QUALITY_BIT(m))) continue;
+                QualityStatistics& s = local[m];
+                const double value = values[m];
+                s.minValue = std::min(s.minValue, value);
+                s.maxValue = std::max(s.maxValue, value);
+                s.avgValue += value;
+                const double t = (value - ctx.histogramLower[m]) / (ctx.histogramUpper[m] - ctx.histogramLower[m]);
+                s.histogram[t > 0 ? std::min((size_t)(t * numOfBins), numOfBins - 1) : 0]++;
+                if (value < ctx.lower[m] || value > ctx.upper[m]) s.badElementIds.push_back(i);
+            }
+        }
+#pragma omp critical
+        for (int m = 0; m < QUALITY_METRIC_COUNT; m++) {
+            if (!(requested & QUALITY_BIT(m))) continue;
+            QualityStatistics& s = statistics[m];
+            s.minValue = std::min(s.minValue, local[m].minValue);
+            s.maxValue = std::max(s.maxValue, local[m].maxValue);
+            s.avgValue += local[m].avgValue;
+            for (size_t b = 0; b < numOfBins; b++)
+                s.histogram[b] += local[m].histogram[b];
+            s.badElementIds.insert(s.badElementIds.end(), local[m].badElementIds.begin(), local[m].badElementIds.end());
+        }
+    }
+    for (int m = 0; m < QUALITY_METRIC_COUNT; m++) {
+        if (!(requested & QUALITY_BIT(m)) || n == 0) continue;
+        statistics[m].avgValue /= n;
+        std::sort(statistics[m].badElementIds.begin(), statistics[m].badElementIds.end());
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * ElementQuality.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_ELEMENTQUALITY_H_
+#define LIBCOTRIK_SRC_ELEMENTQUALITY_H_
+
+#include "Mesh.h"
+
+// Fused verdict metrics, all requested metrics of an element are computed from one set of corner Jacobians.
+// The formulas are the ones of v_hex_*, v_quad_* and v_tet_*; oddy is not defined for tets.
+enum QualityMetric
+{
+    QUALITY_SCALED_JACOBIAN = 0,
+    QUALITY_CONDITION,              // max aspect Frobenius
+    QUALITY_SHAPE,
+    QUALITY_ODDY,
+    QUALITY_RELATIVE_SIZE_SQUARED,
+    QUALITY_METRIC_COUNT
+};
+
+#define QUALITY_BIT(metric) (1u << (metric))
+#define QUALITY_ALL ((1u << QUALITY_METRIC_COUNT) - 1)
+
+// Replaces verdict's global v_set_hex_size/v_set_quad_size/v_set_tet_size, so evaluations can run concurrently.
+struct QualityContext
+{
+    QualityContext();
+    double hexSize = 0;     // average volume for the relative size, 0 uses the mesh average like vtkMeshQuality
+    double quadSize = 0;    // average area
+    double tetSize = 0;     // average volume
+    // an element is bad for a metric if its value is outside [lower, upper]; the defaults are verdict's acceptable
+    // ranges of hexes, except that a scaled jacobian is bad only below 0
+    double lower[QUALITY_METRIC_COUNT];
+    double upper[QUALITY_METRIC_COUNT];
+    // numOfBins bins over [histogramLower, histogramUpper], values outside go to the first or the last bin
+    double histogramLower[QUALITY_METRIC_COUNT];
+    double histogramUpper[QUALITY_METRIC_COUNT];
+    size_t numOfBins = 10;
+};
+
+struct QualityStatistics
+{
+    size_t numOfElements = 0;
+    double minValue = 0;
+    double maxValue = 0;
+    double avgValue = 0;
+    std::vector<size_t> histogram;
+    std::vector<size_t> badElementIds;  // sorted
+};
+
+// per element kernels, only the entries of values selected by metrics are written
+void GetHexQuality(const double coordinates[8][3], const unsigned metrics, const QualityContext& context, double values[QUALITY_METRIC_COUNT]);
+void GetQuadQuality(const double coordinates[4][3], const unsigned metrics, const QualityContext& context, double values[QUALITY_METRIC_COUNT]);
+void GetTetQuality(const double coordinates[4][3], const unsigned metrics, const QualityContext& context, double values[QUALITY_METRIC_COUNT]);
+
+// one parallel pass over the cells of a hex or tet mesh, or the faces of a quad mesh;
+// statistics is indexed by QualityMetric, metrics that are not requested stay empty
+void GetQualityStatistics(const Mesh& mesh, const unsigned metrics, const QualityContext& context, std::vector<QualityStatistics>& statistics);
+
+#endif /* LIBCOTRIK_SRC_ELEMENTQUALITY_H_ */
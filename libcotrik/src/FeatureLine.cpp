@@ -30,85 +30,100 @@ FeatureLine::~FeatureLine()
     // TODO Auto-generated destructor stub
 }
 
+// per-vertex CSR of the sharp edges in eids
+static void BuildSharpAdjacency(const Mesh& mesh, const std::vector<size_t>& eids, std::vector<size_t>& sharpOffsets, std::vector<size_t>& sharpEids)
+{
+    sharpOffsets.assign(mesh.V.size() + 1, 0);
+    for (auto eid : eids)
+        for (auto vid : mesh.E.at(eid).Vids)
+            sharpOffsets[vid + 1]++;
+    for (size_t i = 0; i < mesh.V.size(); i++)
+        sharpOffsets[i + 1] += sharpOffsets[i];
+    std::vector<size_t> cursor(sharpOffsets.begin(), sharpOffsets.end() - 1);
+    sharpEids.resize(sharpOffsets.back());
+    for (auto eid : eids)
+        for (auto vid : mesh.E.at(eid).Vids)
+            sharpEids[cursor[vid]++] = eid;
+}
+
 void FeatureLine::Extract(const size_t label)
 {
     for (size_t i = 0; i < mesh.E.size(); i++) {
         const Edge& edge = mesh.E.at(i);
-        if (edge.isSharpFeature && edge.label == label) {
+        if (edge.isSharpFeature && edge.label == label)
             Eids.push_back(edge.id);
-            Vids.push_back(edge.Vids[0]);
-            Vids.push_back(edge.Vids[1]);
-        }
-    }
-    {
-        std::sort(Vids.begin(), Vids.end());
-        std::vector<size_t>::iterator iter = std::unique(Vids.begin(), Vids.end());
-        Vids.resize(std::distance(Vids.begin(), iter));
     }
-    {
-        std::sort(Eids.begin(), Eids.end());
-        std::vector<size_t>::iterator iter = std::unique(Eids.begin(), Eids.end());
-        Eids.resize(std::distance(Eids.begin(), iter));
+    std::vector<size_t> sharpOffsets, sharpEids;
+    BuildSharpAdjacency(mesh, Eids, sharpOffsets, sharpEids);
+    std::vector<char> visitedE(mesh.E.size(), 0);
+    Chain(sharpOffsets, sharpEids, visitedE);
+}
+
+std::vector<FeatureLine> FeatureLine::ExtractAll(const Mesh& mesh)
+{
+    std::vector<FeatureLine> featureLines(mesh.numOfSharpEdges, FeatureLine(mesh));
+    std::vector<size_t> sharpEids;
+    for (auto& edge : mesh.E)
+        if (edge.isSharpFeature && edge.label < featureLines.size()) {
+            featureLines[edge.label].Eids.push_back(edge.id);
+            sharpEids.push_back(edge.id);
+        }
+    // each edge belongs to exactly one label and a line only reads and writes the flags of its own edges,
+    // so the lines can share the adjacency and the visited flags
+    std::vector<size_t> sharpOffsets, sharpAdjacency;
+    BuildSharpAdjacency(mesh, sharpEids, sharpOffsets, sharpAdjacency);
+    std::vector<char> visitedE(mesh.E.size(), 0);
+#pragma omp parallel for schedule(dynamic)
+    for (long long i = 0; i < (long long)featureLines.size(); i++)
+        featureLines[i].Chain(sharpOffsets, sharpAdjacency, visitedE);
+    return featureLines;
+}
+
+// Orders Eids (sorted, same label) into a polyline: starts at the first corner, otherwise at an end of the line,
+// otherwise (closed loop) at the smallest vid, and walks the unvisited sharp edges of the label.
+void FeatureLine::Chain(const std::vector<size_t>& sharpOffsets, const std::vector<size_t>& sharpEids, std::vector<char>& visitedE)
+{
+    if (Eids.empty()) return;
+    const size_t label = mesh.E.at(Eids.front()).label;
+    Vids.clear();
+    for (auto eid : Eids) {
+        const Edge& edge = mesh.E.at(eid);
+        Vids.push_back(edge.Vids[0]);
+        Vids.push_back(edge.Vids[1]);
     }
-    Vertex* pCorner = NULL;
+    std::sort(Vids.begin(), Vids.end());
+    size_t startVid = MAXID;
+    size_t endVid = MAXID;
     for (size_t i = 0; i < Vids.size(); i++) {
-        const Vertex& v = mesh.V.at(Vids.at(i));
-        if (v.isCorner) {
-            pCorner = (Vertex*)&v;
+        const size_t vid = Vids[i];
+        if (i > 0 && Vids[i - 1] == vid) continue;
+        if (mesh.V.at(vid).isCorner) {
+            startVid = vid;
             break;
         }
+        if (endVid == MAXID && (i + 1 == Vids.size() || Vids[i + 1] != vid)) endVid = vid;
     }
-    std::vector<size_t> newVids;
+    if (startVid == MAXID) startVid = endVid != MAXID ? endVid : Vids.front();
+
+    std::vector<size_t> newVids(1, startVid);
     std::vector<size_t> newEids;
-    std::vector<bool> visited(Vids.size(), false);
-    //if (pCorner != NULL)
-    {
-        // begin with corner
-        Vertex* pVertex = pCorner != NULL ? pCorner : (Vertex*)&mesh.V.at(Vids.at(0));
-        size_t vid = pVertex->id;
-        //if (pCorner != NULL)
-        {
-            for (size_t i = 0; i < Vids.size(); i++) {
-                if (Vids[i] == vid) {
-                    visited[i] = true;
-                    break;
-                }
-            }
-            newVids.push_back(vid);
-        }
-        bool allVisited = false;
-        while (!allVisited) {
-            size_t eid = MAXID;
-            vid = FindNextVid(vid, visited, eid);
-            if (vid != MAXID)
-                newVids.push_back(vid);
-            newEids.push_back(eid);
-            allVisited = true;
-            for (size_t i = 0; i < Vids.size(); i++) {
-                if (!visited[i]) {
-                    allVisited = false;
-                    break;
-                }
-            }
+    newVids.reserve(Eids.size() + 1);
+    newEids.reserve(Eids.size());
+    for (size_t vid = startVid; vid != MAXID;) {
+        size_t nextVid = MAXID;
+        for (size_t i = sharpOffsets[vid]; i < sharpOffsets[vid + 1]; i++) {
+            const Edge& edge = mesh.E.at(sharpEids[i]);
+            if (edge.label != label || visitedE[edge.id]) continue;  // only touch the flags of this label
+            visitedE[edge.id] = 1;
+            nextVid = edge.Vids[0] == vid ? edge.Vids[1] : edge.Vids[0];
+            newEids.push_back(edge.id);
+            newVids.push_back(nextVid);
+            break;
         }
-        if (pCorner == NULL)
-            newVids.push_back(newVids[0]);
+        vid = nextVid;
     }
+    if (newEids.size() != Eids.size())
+        std::cout << "Error in FeatureLine::Chain! label = " << label << " is not a single line" << std::endl;
     Vids = newVids;
     Eids = newEids;
 }
-
-size_t FeatureLine::FindNextVid(const size_t vid, std::vector<bool>& visited, size_t& nextEid)
-{
-    const Vertex& v = mesh.V.at(vid);
-    for (size_t i = 0; i < v.N_Vids.size(); i++)
-        for (size_t j = 0; j < Vids.size(); j++)
-            if (Vids[j] == v.N_Vids[i] && !visited[j]){
-                nextEid = v.N_Eids[i];
-                visited[j] = true;
-                return v.N_Vids[i];
-            }
-
-    std::cout << "Error in FindNextVid! vid = " << vid << std::endl;
-    return MAXID;
-}
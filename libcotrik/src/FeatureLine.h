@@ -21,7 +21,10 @@ private:
     FeatureLine& operator = (const FeatureLine& r);
 public:
     void Extract(const size_t label = 0);
-    size_t FindNextVid(const size_t vid, std::vector<bool>& visited, size_t& nextEid);
+    // extracts the lines of all labels 0 .. mesh.numOfSharpEdges - 1 with a single pass over mesh.E
+    static std::vector<FeatureLine> ExtractAll(const Mesh& mesh);
+private:
+    void Chain(const std::vector<size_t>& sharpOffsets, const std::vector<size_t>& sharpEids, std::vector<char>& visitedE);
 public:
     std::vector<size_t> Vids;  // consecutive vertex ID set
     std::vector<size_t> Eids;  // consecutive edge   ID set
@@ -10,6 +10,7 @@
 #include "MeshFileReader.h"
 #include "MeshFileWriter.h"
 #include "MeshQuality.h"
+#include "SortedIds.h"
 
 #include <algorithm>
 #include <vector>
@@ -32,6 +33,8 @@ FrameOpt::FrameOpt(const Mesh& mesh, const FrameField& framefield, const PolyLin
 , useAverageTargetLength(false)
 , recoverable(true)
 , m_numOfInvertdElements(MAXID)
+, targetLengthSolver(mesh)
+, diagnostics(1)
 {
     // TODO Auto-generated constructor stub
 
@@ -61,6 +64,7 @@ void FrameOpt::Run(const size_t iters/* = 1*/) {
     bool converged = false;
     double initStepSize = stepSize;
     bool initUseAverageTargetLength = useAverageTargetLength;
+    std::vector<glm::dvec3> prevPositions;   // the previous iterate, written as opt.vtk on regression
     //if (useAverageTargetLength)
         ComputeMeshTargetLength();
     while (!converged && iter++ < iters) {
@@ -75,42 +79,35 @@ void FrameOpt::Run(const size_t iters/* = 1*/) {
             useAverageTargetLength = false;
         stepSize *= initStepSize;
 
-        std::string filename = std::string("FrameOpt.") + std::to_string(iter) + ".vtk";
-        framefield.WriteColorFile(filename.c_str());
-
-        filename = std::string("MeshOpt.") + std::to_string(iter) + ".vtk";
-        MeshFileWriter writer(mesh, filename.c_str());
-        writer.WriteFile();
-
         double minimumScaledJacobian = 0.0;
         double averageScaledJacobian = 0.0;
-        double maximumScaledJacobian = 0.0;
         std::vector<size_t> badCellIds;
-        m_numOfInvertdElements = GetQuality(filename.c_str(), minimumScaledJacobian, averageScaledJacobian, maximumScaledJacobian, badCellIds);
-        filename = std::string("BadCells.") + std::to_string(iter) + ".vtk";
-        OutputBadCells(badCellIds, filename.c_str());
-        filename = std::string("FrameOfBadCells.") + std::to_string(iter) + ".vtk";
-        OutputFramesOfBadCells(badCellIds, filename.c_str());
+        m_numOfInvertdElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, averageScaledJacobian, badCellIds);
+        std::cout << "iter = " << iter << " #inverted = " << m_numOfInvertdElements << " MSJ = " << minimumScaledJacobian << std::endl;
+        if (diagnostics.IsDue(iter)) {
+            OutputFrameField((std::string("FrameOpt.") + std::to_string(iter) + ".vtk").c_str());
+            diagnostics.WriteMesh(mesh, std::string("MeshOpt.") + std::to_string(iter) + ".vtk");
+            OutputBadCells(badCellIds, (std::string("BadCells.") + std::to_string(iter) + ".vtk").c_str());
+            OutputFramesOfBadCells(badCellIds, (std::string("FrameOfBadCells.") + std::to_string(iter) + ".vtk").c_str());
+        }
         if (prevMinimumScaledJacobian > 0 && minimumScaledJacobian < prevMinimumScaledJacobian)
         {
-            filename = std::string("MeshOpt.") + std::to_string(iter - 1) + ".vtk";
             std::cout << "*************************" << std::endl;
-            std::cout << "Best Mesh is " << filename << std::endl;
+            std::cout << "Best Mesh is iteration " << iter - 1 << ", written to opt.vtk" << std::endl;
             std::cout << "*************************" << std::endl;
-            MeshFileReader reader(filename.c_str());
-            const Mesh& bestmesh = reader.GetMesh();
-            MeshFileWriter optwriter(bestmesh, "opt.vtk");
-            optwriter.WriteFile();
+            diagnostics.WriteMesh(mesh, prevPositions, "opt.vtk");
             break;
         }
         else if (converged)
         {
             std::cout << "*************************" << std::endl;
-            std::cout << "Converged at " << filename << std::endl;
+            std::cout << "Converged at iteration " << iter << std::endl;
             std::cout << "*************************" << std::endl;
         }
         prevMinimumScaledJacobian = minimumScaledJacobian;
+        prevPositions = DiagnosticsSink::GetPositions(mesh.V);
     }
+    diagnostics.Flush();
 }
 
 bool FrameOpt::Optimize() {
@@ -229,13 +226,10 @@ bool FrameOpt::OptimizeFrame() {
             framefield.frameNodes[i].z = stepSize * X[3 * i + 2] + (1.0 - stepSize) * framefield.frameNodes[i].z;
         }
 
-        MeshFileWriter writer(mesh, "temp.vtk");
-        writer.WriteFile();
         double minimumScaledJacobian = 0.0;
         double averageScaledJacobian = 0.0;
-        double maximumScaledJacobian = 0.0;
         std::vector<size_t> badCellIds1;
-        size_t InvertedElements = GetQuality("temp.vtk", minimumScaledJacobian, averageScaledJacobian, maximumScaledJacobian, badCellIds1);
+        size_t InvertedElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, averageScaledJacobian, badCellIds1);
 
         if (InvertedElements > m_numOfInvertdElements){
             for (size_t i = 0; i < mesh.V.size(); i++)
@@ -613,60 +607,10 @@ void FrameOpt::UpdateFrameFieldFromMesh() {
 
 void FrameOpt::ComputeMeshTargetLength() {
     std::cout << "=============================\n";
-    std::vector<Trip> coefficients;
-    std::vector<float> b;
-    size_t row  = 0;
-    size_t numOfparallelEids = 0;
-    size_t numOfconsecutiveEids = 0;
-    for (size_t i = 0; i < mesh.E.size(); i++)
-    {
-        coefficients.push_back(Trip(row, i, 1));
-        if (mesh.E[i].isBoundary)
-            b.push_back(mesh.E[i].length);
-//        else if (mesh.E[i].isSingularity)
-//            b.push_back(0.5 * avgMeshEdgeLength);
-        else
-            b.push_back(avgMeshEdgeLength);
-        row++;
-
-        for (size_t j = 0; j < mesh.E[i].parallelEids.size(); j++)
-        {
-            size_t N_Eid = mesh.E[i].parallelEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfparallelEids++;
-            row++;
-        }
-        for (size_t j = 0; j < mesh.E[i].consecutiveEids.size(); j++)
-        {
-            size_t N_Eid = mesh.E[i].consecutiveEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfconsecutiveEids++;
-            row++;
-        }
-    }
-
-    size_t col = mesh.E.size();
-//    std::cout << "Edge Length Row = " << row << std::endl;
-//    std::cout << "Edge Length Col = " << col << std::endl;
-//    std::cout << "numOfparallelEids = " << numOfparallelEids << std::endl;
-//    std::cout << "numOfconsecutiveEids = " << numOfconsecutiveEids << std::endl;
-
-    Eigen::SparseMatrix<float> A(row, col);
-    A.setFromTriplets(coefficients.begin(), coefficients.end());
-    Eigen::SparseMatrix<float> A_T = A.transpose();
-    Eigen::SparseMatrix<float> ATA = A_T * A;
-    //  MatrixXf ;
-    VectorXf X(col), B(row);
-    for (size_t i = 0; i < row; i++)
-        B(i) = b[i];
-
-    VectorXf ATB = A_T * B;
-    Eigen::SparseLU<SpMat> chol(ATA);
-    X = chol.solve(ATB);
+    if (!targetLengthSolver.IsBuilt())
+        targetLengthSolver.Build();
+    std::vector<double> X;
+    targetLengthSolver.Solve(avgMeshEdgeLength, X);
     for (size_t i = 0; i < mesh.E.size(); i++)
         mesh.E[i].length = X[i];
 
@@ -694,25 +638,23 @@ void FrameOpt::ComputeMeshTargetLength() {
         if (!frame2.isBoundary)
             hs.push_back(frame2.id);
 
-        std::vector<size_t> es_f;
-        std::vector<size_t> vs_f;
-        for (size_t j = 0; j < 4; j++) {
-            es_f.push_back(mesh.F[shared_fid].Eids[j]);
-            vs_f.push_back(mesh.F[shared_fid].Vids[j]);
-        }
+        SmallIds<4> es_f(mesh.F[shared_fid].Eids.begin(), mesh.F[shared_fid].Eids.begin() + 4);
+        SmallIds<4> vs_f(mesh.F[shared_fid].Vids.begin(), mesh.F[shared_fid].Vids.begin() + 4);
+        SortIds(es_f);
+        SortIds(vs_f);
 
         for (size_t j = 0; j < hs.size(); j++) {
             double ave_len = 0;
-            std::vector<size_t> es;
+            SmallIds<24> es;
             for (size_t k = 0; k < 6; k++)
                 for (size_t m = 0; m < 4; m++)
                     es.push_back(mesh.F[mesh.C[hs[j]].Fids[k]].Eids[m]);
-			Util::set_redundent_clearn(es);
-            std::vector<size_t> es_left;
-			Util::set_exclusion(es, es_f, es_left);
+            SortIds(es);
+            SmallIds<24> es_left;
+            SubtractIds(es, es_f, es_left);
             es.clear();
             for (size_t k = 0; k < es_left.size(); k++) {
-                if (Util::set_contain(vs_f, mesh.E[es_left[k]].Vids[0]) || Util::set_contain(vs_f, mesh.E[es_left[k]].Vids[1]))
+                if (ContainsId(vs_f, mesh.E[es_left[k]].Vids[0]) || ContainsId(vs_f, mesh.E[es_left[k]].Vids[1]))
                     es.push_back(es_left[k]);
             }
             for (size_t k = 0; k < es.size(); k++)
@@ -767,15 +709,28 @@ void FrameOpt::SetAllowBigStep(bool value) {
 }
 
 void FrameOpt::OutputBadCells(const std::vector<size_t>& badCellIds, const char* filename) {
-    std::vector<Cell> cells(badCellIds.size());
-    for (size_t i = 0; i < badCellIds.size(); i++)
-        cells.at(i) = mesh.C.at(badCellIds.at(i));
-    MeshFileWriter writer(mesh.V, cells, filename);
-    writer.WriteFile();
+    diagnostics.WriteMesh(mesh, badCellIds, filename);
+}
+
+// same output as FrameField::WriteColorFile
+void FrameOpt::OutputFrameField(const char* filename) {
+    const std::vector<Frame>& frameNodes = framefield.frameNodes;
+    const std::vector<FrameEdge>& frameEdges = framefield.frameEdges;
+    std::vector<glm::dvec3> points(frameNodes.size());
+    for (size_t i = 0; i < frameNodes.size(); i++)
+        points[i] = glm::dvec3(frameNodes[i].x, frameNodes[i].y, frameNodes[i].z);
+    std::vector<size_t> lines(2 * frameEdges.size());
+    std::vector<size_t> labels(frameEdges.size());
+    for (size_t i = 0; i < frameEdges.size(); i++) {
+        lines[2 * i] = frameEdges[i].Vids[0];
+        lines[2 * i + 1] = frameEdges[i].Vids[1];
+        labels[i] = frameEdges[i].polylineId;
+    }
+    diagnostics.WritePolyData(std::move(points), std::vector<size_t>(), std::move(lines), std::move(labels), filename);
 }
 
+// same output as FrameField::WriteFile(filename, frameIds)
 void FrameOpt::OutputFramesOfBadCells(const std::vector<size_t>& badCellIds, const char* filename) {
-    std::vector<Cell> cells(badCellIds.size());
     std::vector<size_t> frameIds;
     for (size_t i = 0; i < badCellIds.size(); i++) {
         const Cell& cell = mesh.C.at(badCellIds.at(i));
@@ -791,5 +746,30 @@ void FrameOpt::OutputFramesOfBadCells(const std::vector<size_t>& badCellIds, con
     std::vector<size_t>::iterator iter = std::unique(frameIds.begin(), frameIds.end());
     frameIds.resize(std::distance(frameIds.begin(), iter));
 
-    framefield.WriteFile(filename, frameIds);
+    const std::vector<Frame>& frameNodes = framefield.frameNodes;
+    const std::vector<FrameEdge>& frameEdges = framefield.frameEdges;
+    std::vector<size_t> frameEdgeIds;
+    for (size_t i = 0; i < frameIds.size(); i++) {
+        const Frame& frame = frameNodes.at(frameIds.at(i));
+        std::copy(frame.N_Eids.begin(), frame.N_Eids.end(), back_inserter(frameEdgeIds));
+    }
+    std::sort(frameEdgeIds.begin(), frameEdgeIds.end());
+    frameEdgeIds.resize(std::distance(frameEdgeIds.begin(), std::unique(frameEdgeIds.begin(), frameEdgeIds.end())));
+
+    std::vector<glm::dvec3> points(frameNodes.size());
+    for (size_t i = 0; i < frameNodes.size(); i++)
+        points[i] = glm::dvec3(frameNodes[i].x, frameNodes[i].y, frameNodes[i].z);
+    std::vector<size_t> vertices, lines, labels;
+    for (auto frameEdgeId : frameEdgeIds)
+        for (auto vid : frameEdges.at(frameEdgeId).Vids)
+            if (frameNodes.at(vid).isBoundary) {
+                vertices.push_back(vid);
+                labels.push_back(0);
+            }
+    for (auto frameEdgeId : frameEdgeIds) {
+        lines.push_back(frameEdges.at(frameEdgeId).Vids[0]);
+        lines.push_back(frameEdges.at(frameEdgeId).Vids[1]);
+        labels.push_back(frameEdges.at(frameEdgeId).polylineId);
+    }
+    diagnostics.WritePolyData(std::move(points), std::move(vertices), std::move(lines), std::move(labels), filename);
 }
@@ -9,6 +9,8 @@
 #define FRAME_OPT_H_
 
 #include "PolyLine.h"
+#include "TargetLengthSolver.h"
+#include "DiagnosticsSink.h"
 
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
@@ -59,6 +61,7 @@ private:
     void OptimizeBoundary(std::vector<Trip>& coefficients, std::vector<float>& B, size_t& m_id);
 
     void OutputBadCells(const std::vector<size_t>& badCellIds, const char* filename);
+    void OutputFrameField(const char* filename);
     void OutputFramesOfBadCells(const std::vector<size_t>& badCellIds, const char* filename);
 
 private:
@@ -77,6 +80,11 @@ private:
     bool recoverable;
     bool allowBigStep;
     size_t m_numOfInvertdElements;
+
+    TargetLengthSolver targetLengthSolver;  // built on the first ComputeMeshTargetLength()
+
+public:
+    DiagnosticsSink diagnostics;    // FrameOpt.N, MeshOpt.N, BadCells.N and FrameOfBadCells.N every diagnostics.every iterations
 };
 
 #endif /* FRAME_OPT_H_ */
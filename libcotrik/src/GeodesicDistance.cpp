@@ -2,6 +2,7 @@
 #define GEODESIC_DISTANCE_CPP
 
 #include "GeodesicDistance.h"
+#include <algorithm>
 //GeodesicDistance gd;
 
 GeodesicDistance::GeodesicDistance()
@@ -27,6 +28,7 @@ GeodesicDistance::GeodesicDistance()
     /*static double*/ smoothness = -1.;
     /*static double*/ boundaryConditions = -1.;
     /*static char*/ verbose = 0;
+    isBuilt = false;
 }
 GeodesicDistance::~GeodesicDistance()
 {
@@ -79,6 +81,7 @@ void GeodesicDistance::Init()
    hmContextInitialize( &context );
    hmTriMeshInitialize( &surface );
    hmTriDistanceInitialize( &distance );
+   isBuilt = false;
 
    /* read surface */
    readMesh( &distance, &surface, inputMesh );
@@ -113,54 +116,173 @@ void GeodesicDistance::Init()
 }
 double GeodesicDistance::GetGeodesicDistance(size_t vid1, size_t vid2)
 {
-    sourceSets = (hmVectorSizeT*) malloc(nSourceSets * sizeof(hmVectorDouble));
-    hmVectorSizeT* sourceSetsBegin = sourceSets;
-    hmVectorSizeT* sourceSetsEnd = sourceSetsBegin + nSourceSets;
-    for (hmVectorSizeT*s = sourceSetsBegin; s != sourceSetsEnd; s++) {
-        /* get the set size */
-        int setSize = 1;
-        /* allocate space for the set */
-        hmVectorSizeTInitialize(s);
-        hmVectorSizeTResize(s, setSize);
+    Build();
+    hmClearArrayDouble(distance.isSource.values, surface.nVertices, 0.);
+    distance.isSource.values[vid1] = 1.;
+    hmTriDistanceUpdate(&distance);
 
-        /* read the set indices */
-        for (int i = 0; i < setSize; i++) {
-            s->entries[i] = 1;
+    return distance.distance.values[vid2];
+}
 
-            /* convert 1-based indices to 0-based indices */
-            s->entries[i]--;
+void GeodesicDistance::Build()
+{
+    if (isBuilt) return;
+    hmTriDistanceBuild(&distance);
+    isBuilt = true;
+}
+
+void GeodesicDistance::GetGeodesicDistances(size_t vid, std::vector<double>& distances)
+{
+    Build();
+    hmClearArrayDouble(distance.isSource.values, surface.nVertices, 0.);
+    distance.isSource.values[vid] = 1.;
+    hmTriDistanceUpdate(&distance);
+
+    distances.assign(distance.distance.values, distance.distance.values + surface.nVertices);
+}
+
+std::vector<size_t> GeodesicDistance::GetLandmarks(size_t k, std::vector<std::vector<double> >& landmarkDistances, size_t seedVid)
+{
+    const size_t nVertices = surface.nVertices;
+    if (k > nVertices) k = nVertices;
+    std::vector<size_t> landmarks;
+    landmarks.reserve(k);
+    landmarkDistances.clear();
+    landmarkDistances.reserve(k);
+    if (k == 0) return landmarks;
+
+    std::vector<double> minDistances(nVertices, HUGE_VAL);
+    size_t vid = seedVid < nVertices ? seedVid : 0;
+    while (landmarks.size() < k) {
+        landmarks.push_back(vid);
+        landmarkDistances.push_back(std::vector<double>());
+        GetGeodesicDistances(vid, landmarkDistances.back());
+
+        const std::vector<double>& d = landmarkDistances.back();
+        size_t farthestVid = vid;
+        double farthestDistance = -1.0;
+        for (size_t i = 0; i < nVertices; i++) {
+            if (d[i] < minDistances[i]) minDistances[i] = d[i];
+            if (minDistances[i] > farthestDistance) {
+                farthestDistance = minDistances[i];
+                farthestVid = i;
+            }
         }
+        if (farthestDistance <= 0.0) break;
+        vid = farthestVid;
     }
+    return landmarks;
+}
 
-    /* compute distance */
-    hmTriDistanceBuild(&distance);
-    //for (i = 0; i < nSourceSets; i++)
-    {
-        /* set current source set */
-        setSources(&distance, sourceSets, 0);
+// members nearest the embedding mean of a cluster that compete with its medoid
+static const size_t MedoidCandidates = 32;
 
-        /* udpate distance function */
-        hmTriDistanceUpdate(&distance);
+// landmark approximation of the geodesic distance, the triangle inequality bound max_l |d_l(i) - d_l(j)|;
+// exact when i is a landmark, as the medoids are
+static double GetLandmarkDistance(const std::vector<std::vector<double> >& fields, const size_t i, const size_t j)
+{
+    double res = 0.0;
+    for (size_t l = 0; l < fields.size(); l++)
+        res = std::max(res, fabs(fields[l][i] - fields[l][j]));
+    return res;
+}
 
-//        /* write solution as plain text file */
-//        if (outputDistancePrefix != NULL) {
-//            writeDistances(&distance, outputDistancePrefix, i);
-//        }
-//
-//        /* write solution as vertex coordinates */
-//        if (outputMeshPrefix != NULL) {
-//            writeMesh(&distance, outputMeshPrefix, i);
-//        }
-    }
+void GeodesicDistance::ClusterByLandmarks(size_t k, std::vector<int>& cids, std::vector<size_t>& medoids, size_t maxIters)
+{
+    const size_t nVertices = surface.nVertices;
+    std::vector<std::vector<double> > fields;
+    medoids = GetLandmarks(k, fields);
+    k = medoids.size();
+    cids.assign(nVertices, -1);
+    if (k == 0) return;
+
+    for (size_t iter = 0; iter < maxIters; iter++) {
+        // assign every vertex to its geodesically closest medoid
+#pragma omp parallel for
+        for (long long i = 0; i < (long long)nVertices; i++) {
+            int cid = 0;
+            for (size_t c = 1; c < k; c++)
+                if (fields[c][i] < fields[cid][i]) cid = c;
+            cids[i] = cid;
+        }
 
-//    /* compare with reference distances */
-//    if (inputReference != NULL && nSourceSets == 1) {
-//        compareDistance(&distance, nReferenceColumns, referenceValues, referenceNames, outputMeshPrefix);
-//    }
+        // embedding mean of each cluster; the landmark fields act as coordinates
+        std::vector<std::vector<double> > means(k, std::vector<double>(k, 0.0));
+        std::vector<size_t> counts(k, 0);
+        for (size_t i = 0; i < nVertices; i++) {
+            std::vector<double>& mean = means[cids[i]];
+            for (size_t c = 0; c < k; c++)
+                mean[c] += fields[c][i];
+            counts[cids[i]]++;
+        }
+        for (size_t c = 0; c < k; c++)
+            if (counts[c] != 0)
+                for (size_t d = 0; d < k; d++)
+                    means[c][d] /= counts[c];
+
+        // members of each cluster by a counting sort
+        std::vector<size_t> offsets(k + 1, 0);
+        for (size_t c = 0; c < k; c++)
+            offsets[c + 1] = offsets[c] + counts[c];
+        std::vector<size_t> members(nVertices);
+        std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < nVertices; i++)
+            members[cursor[cids[i]]++] = i;
+
+        // new medoid minimizes the summed landmark distance to the members of its cluster; the candidates are
+        // the current medoid and the members nearest the cluster mean, which keeps this O(V * k) per iteration
+        std::vector<size_t> newMedoids(medoids);
+#pragma omp parallel for schedule(dynamic)
+        for (long long c = 0; c < (long long)k; c++) {
+            const size_t* clusterVids = members.data() + offsets[c];
+            const size_t n = offsets[c + 1] - offsets[c];
+            if (n == 0) continue;
+            std::vector<std::pair<double, size_t> > meanDistances(n);
+            for (size_t m = 0; m < n; m++) {
+                double dist = 0.0;
+                for (size_t d = 0; d < k; d++) {
+                    const double diff = fields[d][clusterVids[m]] - means[c][d];
+                    dist += diff * diff;
+                }
+                meanDistances[m] = std::make_pair(dist, clusterVids[m]);
+            }
+            const size_t numOfCandidates = std::min(n, MedoidCandidates);
+            std::partial_sort(meanDistances.begin(), meanDistances.begin() + numOfCandidates, meanDistances.end());
+            std::vector<size_t> candidates(1, medoids[c]);
+            for (size_t m = 0; m < numOfCandidates; m++)
+                if (meanDistances[m].second != medoids[c]) candidates.push_back(meanDistances[m].second);
+
+            // ties keep the current medoid, so the iteration settles
+            double bestSum = HUGE_VAL;
+            for (auto candidate : candidates) {
+                double sum = 0.0;
+                for (size_t m = 0; m < n && sum < bestSum; m++)
+                    sum += GetLandmarkDistance(fields, candidate, clusterVids[m]);
+                if (sum < bestSum) {
+                    bestSum = sum;
+                    newMedoids[c] = candidate;
+                }
+            }
+        }
 
-    destroySourceSets( nSourceSets, &sourceSets );
+        // only moved medoids need a new solve
+        bool changed = false;
+        for (size_t c = 0; c < k; c++) {
+            if (newMedoids[c] == medoids[c]) continue;
+            medoids[c] = newMedoids[c];
+            GetGeodesicDistances(medoids[c], fields[c]);
+            changed = true;
+        }
+        if (!changed) break;
+    }
 
-    return distance.distance.values[vid2];
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)nVertices; i++) {
+        int cid = 0;
+        for (size_t c = 1; c < k; c++)
+            if (fields[c][i] < fields[cid][i]) cid = c;
+        cids[i] = cid;
+    }
 }
 
 void GeodesicDistance::Destroy()
@@ -171,6 +293,7 @@ void GeodesicDistance::Destroy()
    hmContextDestroy( &context );
    //destroySourceSets( nSourceSets, &sourceSets );
    destroyReferenceValues( nReferenceColumns, &referenceValues, &referenceNames );
+   isBuilt = false;
 }
 
 int GeodesicDistance::parseCommandLineArguments( int argc, char** argv,
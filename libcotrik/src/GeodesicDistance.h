@@ -5,6 +5,7 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
+#include <vector>
 #include "hmTriDistance.h"
 #include "hmContext.h"
 #include "hmUtility.h"
@@ -31,6 +32,16 @@ public:
     void Destroy();
     double GetGeodesicDistance(size_t vid1, size_t vid2);
 
+    // Factorizes the heat/Poisson operators once; every later solve only backsubstitutes.
+    void Build();
+    // One heat-method solve from source vid, distances to all vertices.
+    void GetGeodesicDistances(size_t vid, std::vector<double>& distances);
+    // Farthest point sampling; landmarkDistances[i] is the distance field of the i-th landmark.
+    std::vector<size_t> GetLandmarks(size_t k, std::vector<std::vector<double> >& landmarkDistances, size_t seedVid = 0);
+    // Geodesic k-medoids seeded by farthest point sampling, O(V*k) memory and O(k) solves per iteration;
+    // medoids minimize the summed geodesic distance to their members, approximated through the medoid fields.
+    void ClusterByLandmarks(size_t k, std::vector<int>& cids, std::vector<size_t>& medoids, size_t maxIters = 10);
+
     /* main data */
     hmContext context;
     hmTriMesh surface;
@@ -52,6 +63,8 @@ public:
     double smoothness;// = -1.;
     double boundaryConditions;// = -1.;
     char verbose;// = 0;
+
+    bool isBuilt;// = false;
 };
 
 //extern GeodesicDistance gd;
@@ -16,16 +16,14 @@ GlobalSheetSimplifier::~GlobalSheetSimplifier() {
     // TODO Auto-generated destructor stub
 }
 
-void GlobalSheetSimplifier::Run(std::set<size_t>& canceledFids) {
+void GlobalSheetSimplifier::Run(std::set<size_t>& canceledFids, const bool batch, const bool smallestFirst) {
     BaseComplexQuad baseComplex(mesh);
     baseComplex.Build();
 
     BaseComplexSheetQuad baseComplexSheets(baseComplex);
     baseComplexSheets.Extract();
 
-    auto key_edgeId = get_key_edgeId(mesh);
-    auto key_faceId = get_key_faceId(mesh);
-
+    std::vector<SheetCollapse> sheets;
     size_t id = -1;
     for (const auto& link : baseComplex.separatedVertexIdsLink) {
         const auto& linkEids = baseComplex.separatedEdgeIdsLink.at(++id);
@@ -35,17 +33,13 @@ void GlobalSheetSimplifier::Run(std::set<size_t>& canceledFids) {
         if (v_front.isBoundary || v_back.isBoundary) continue;
         if ((v_front.N_Fids.size() == 3 && v_back.N_Fids.size() > 4) || (v_front.N_Fids.size() > 4 && v_back.N_Fids.size() == 3)) {
             // auto parallelEids = GetAllParallelEdgeIds(linkEids.front());
-            std::map<size_t, size_t> canceledFaceIds;
-            std::set<size_t> canceledEdgeIds = GetCanceledEdgeIds(linkEids, canceledFaceIds);
-            if (!CanCollapseWithFeaturePreserved(baseComplexSheets, canceledFaceIds)) continue;
-            if (!can_collapse_vids_with_feature_preserved(canceledEdgeIds)) continue;
-            {
-                std::cout << "collapse sheet " << id << "\n";
-                collapse_with_feature_preserved(key_edgeId, key_faceId, canceledFaceIds, canceledEdgeIds);
-                for (auto& item : canceledFaceIds)
-                    canceledFids.insert(item.first);
-                return;
-            }
+            SheetCollapse sheet;
+            sheet.sheetId = id;
+            sheet.canceledEdgeIds = GetCanceledEdgeIds(linkEids, sheet.canceledFaceIds);
+            if (!CanCollapseWithFeaturePreserved(baseComplexSheets, sheet.canceledFaceIds)) continue;
+            if (!can_collapse_vids_with_feature_preserved(sheet.canceledEdgeIds)) continue;
+            sheets.push_back(sheet);
+            if (!batch && !smallestFirst) break;
         } else if (COLLAPSE && v_front.N_Fids.size() == 3 && v_back.N_Fids.size() == 3) {
             ;
         } else if (Simplifier::SPLIT && v_front.N_Fids.size() == 5 && v_back.N_Fids.size() == 5) {
@@ -54,6 +48,7 @@ void GlobalSheetSimplifier::Run(std::set<size_t>& canceledFids) {
             ;
         }
     }
+    CollapseSheets(sheets, batch, smallestFirst, canceledFids);
 }
 
 std::set<size_t> GlobalSheetSimplifier::GetCanceledEdgeIds(const std::vector<size_t>& linkEids, std::map<size_t, size_t>& canceledFaceIds) {
@@ -18,7 +18,7 @@ private:
     GlobalSheetSimplifier(const GlobalSheetSimplifier&);
     GlobalSheetSimplifier& operator = (const GlobalSheetSimplifier&);
 public:
-    void Run(std::set<size_t>& canceledFids);
+    void Run(std::set<size_t>& canceledFids, const bool batch = false, const bool smallestFirst = false);
     std::set<size_t> GetCanceledEdgeIds(const std::vector<size_t>& linkEids, std::map<size_t, size_t>& canceledFaceIds);
     bool CanCollapseWithFeaturePreserved(const BaseComplexSheetQuad& baseComplexSheets, std::map<size_t, size_t>& canceledFaceIds);
 };
@@ -0,0 +1,154 @@
+/*
+ * HausdorffDistance.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "HausdorffDistance.h"
+#include <igl/point_simplex_squared_distance.h>
+#include <algorithm>
+#include <atomic>
+#include <float.h>
+#include <math.h>
+
+HausdorffDistance::HausdorffDistance(const Mesh& mesh, const Mesh& refMesh)
+: mesh(mesh)
+, refMesh(refMesh)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+HausdorffDistance::~HausdorffDistance()
+{
+    // TODO Auto-generated destructor stub
+}
+
+// boundary faces as triangles over the vertices they use, polygons are split into fans
+void HausdorffDistance::GetBoundary(const Mesh& mesh, std::vector<size_t>& vids, Eigen::MatrixXi& T)
+{
+    const bool surface = mesh.m_cellType == TRIANGLE || mesh.m_cellType == QUAD || mesh.m_cellType == POLYGON;
+    std::vector<size_t> rowIds(mesh.V.size(), MAXID);
+    std::vector<size_t> fids;
+    size_t numOfTriangles = 0;
+    vids.clear();
+    for (auto& f : mesh.F) {
+        if (!surface && !f.isBoundary) continue;
+        if (f.Vids.size() < 3) continue;
+        fids.push_back(f.id);
+        numOfTriangles += f.Vids.size() - 2;
+        for (auto vid : f.Vids)
+            if (rowIds[vid] == MAXID) {
+                rowIds[vid] = vids.size();
+                vids.push_back(vid);
+            }
+    }
+    T.resize(numOfTriangles, 3);
+    numOfTriangles = 0;
+    for (auto fid : fids) {
+        const auto& fvids = mesh.F.at(fid).Vids;
+        for (size_t j = 1; j + 1 < fvids.size(); j++, numOfTriangles++) {
+            T(numOfTriangles, 0) = rowIds[fvids[0]];
+            T(numOfTriangles, 1) = rowIds[fvids[j]];
+            T(numOfTriangles, 2) = rowIds[fvids[j + 1]];
+        }
+    }
+}
+
+void HausdorffDistance::Build()
+{
+    GetBoundary(mesh, vids, T);
+    V.resize(vids.size(), 3);
+    closestRefTids.assign(vids.size(), -1);
+
+    std::vector<size_t> refVids;
+    GetBoundary(refMesh, refVids, refT);
+    refV.resize(refVids.size(), 3);
+    for (size_t i = 0; i < refVids.size(); i++)
+        for (int j = 0; j < 3; j++)
+            refV(i, j) = refMesh.V.at(refVids[i])[j];
+    closestTids.assign(refVids.size(), -1);
+    if (refT.rows() > 0) refTree.init(refV, refT);
+    else refTree.deinit();
+    tree.deinit();
+    built = true;
+}
+
+bool HausdorffDistance::IsBuilt() const
+{
+    return built;
+}
+
+void HausdorffDistance::UpdatePositions()
+{
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)vids.size(); i++)
+        for (int j = 0; j < 3; j++)
+            V(i, j) = mesh.V.at(vids[i])[j];
+}
+
+double HausdorffDistance::Get()
+{
+    return sqrt(Evaluate(DBL_MAX));
+}
+
+bool HausdorffDistance::IsLessThan(const double threshold)
+{
+    return Evaluate(threshold * threshold) < threshold * threshold;
+}
+
+double HausdorffDistance::Evaluate(const double sqrThreshold)
+{
+    if (!built) Build();
+    UpdatePositions();
+    const size_t n = V.rows();
+    const size_t m = refV.rows();
+    if (T.rows() == 0 || refT.rows() == 0)
+        return (T.rows() == 0 && refT.rows() == 0) ? 0.0 : DBL_MAX;
+    const bool exact = sqrThreshold == DBL_MAX;
+
+    // rows [0, n) are the points of V measured against refT, rows [n, n + m) the points of refV against T
+    auto getPoint = [&](const size_t k) -> Eigen::RowVector3d {
+        return k < n ? Eigen::RowVector3d(V.row(k)) : Eigen::RowVector3d(refV.row(k - n));
+    };
+    auto getClosestTid = [&](const size_t k) -> int& {
+        return k < n ? closestRefTids[k] : closestTids[k - n];
+    };
+
+    // an upper bound from the triangle that was closest last time, points below the threshold are done
+    std::vector<double> sqrDistances(n + m);
+    std::vector<char> pending(n + m);
+#pragma omp parallel for
+    for (long long k = 0; k < (long long)(n + m); k++) {
+        const int tid = getClosestTid(k);
+        double sqrD = DBL_MAX;
+        if (tid >= 0) {
+            Eigen::RowVector3d c;
+            if (k < (long long)n) igl::point_simplex_squared_distance<3>(getPoint(k), refV, refT, tid, sqrD, c);
+            else igl::point_simplex_squared_distance<3>(getPoint(k), V, T, tid, sqrD, c);
+        }
+        sqrDistances[k] = sqrD;
+        pending[k] = exact || sqrD >= sqrThreshold;
+    }
+    if (std::find(pending.begin() + n, pending.end(), 1) != pending.end()) tree.init(V, T);
+
+    std::atomic<bool> exceeded(false);
+    double exceededSqrD = 0;
+#pragma omp parallel for schedule(dynamic, 64)
+    for (long long k = 0; k < (long long)(n + m); k++) {
+        if (!pending[k] || exceeded.load(std::memory_order_relaxed)) continue;
+        int& tid = getClosestTid(k);
+        int i = tid;
+        Eigen::RowVector3d c;
+        const double sqrD = k < (long long)n
+                ? refTree.squared_distance(refV, refT, getPoint(k), sqrDistances[k], i, c)
+                : tree.squared_distance(V, T, getPoint(k), sqrDistances[k], i, c);
+        tid = i;
+        sqrDistances[k] = sqrD;
+        if (!exact && sqrD >= sqrThreshold && !exceeded.exchange(true))
+            exceededSqrD = sqrD;
+    }
+    if (exceeded) return exceededSqrD;
+    return *std::max_element(sqrDistances.begin(), sqrDistances.end());
+}
@@ -0,0 +1,58 @@
+/*
+ * HausdorffDistance.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_HAUSDORFFDISTANCE_H_
+#define LIBCOTRIK_SRC_HAUSDORFFDISTANCE_H_
+
+#include "Mesh.h"
+#include <Eigen/Dense>
+#include <igl/AABB.h>
+
+// Two sided Hausdorff distance between the boundary of a deforming mesh and a fixed reference surface,
+// measured like igl::hausdorff from the vertices of each side to the triangles of the other side.
+// The reference tree and the boundary extraction of mesh are built once, every evaluation only copies
+// the current positions. Both directions run in one parallel loop and every point first tries the
+// triangle that was closest last time, which is usually enough to decide a threshold query.
+class HausdorffDistance
+{
+public:
+    HausdorffDistance(const Mesh& mesh, const Mesh& refMesh);
+    virtual ~HausdorffDistance();
+private:
+    HausdorffDistance();
+    HausdorffDistance(const HausdorffDistance&);
+    HausdorffDistance& operator = (const HausdorffDistance&);
+public:
+    // extracts the boundary faces of both meshes, call again after the topology of mesh changed
+    void Build();
+    bool IsBuilt() const;
+    double Get();
+    // true if the distance is less than threshold, stops at the first point that is not
+    bool IsLessThan(const double threshold);
+
+private:
+    static void GetBoundary(const Mesh& mesh, std::vector<size_t>& vids, Eigen::MatrixXi& T);
+    void UpdatePositions();
+    // squared distance of the larger side, or of the first point found at or beyond sqrThreshold
+    double Evaluate(const double sqrThreshold);
+
+private:
+    const Mesh& mesh;
+    const Mesh& refMesh;
+    std::vector<size_t> vids;           // boundary vertices of mesh, rows of V
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi T;                  // boundary faces of mesh split into triangles
+    Eigen::MatrixXd refV;
+    Eigen::MatrixXi refT;
+    igl::AABB<Eigen::MatrixXd, 3> refTree;
+    igl::AABB<Eigen::MatrixXd, 3> tree; // rebuilt only when a point of refV needs it
+    std::vector<int> closestRefTids;    // last closest triangle of refT per row of V
+    std::vector<int> closestTids;       // last closest triangle of T per row of refV
+    bool built = false;
+};
+
+#endif /* LIBCOTRIK_SRC_HAUSDORFFDISTANCE_H_ */
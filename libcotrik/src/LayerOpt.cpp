@@ -29,6 +29,7 @@ LayerOpt::LayerOpt(const Mesh& mesh,
 , useAverageTargetLength(false)
 , recoverable(true)
 , m_numOfInvertdElements(1000000000)
+, targetLengthSolver(mesh)
 {
     // TODO Auto-generated constructor stub
 
@@ -66,11 +67,11 @@ void LayerOpt::Run(const size_t iters/* = 1*/)
     bool converged = false;
     double initStepSize = stepSize;
     bool initUseAverageTargetLength = useAverageTargetLength;
+    std::vector<glm::dvec3> prevPositions;   // the previous iterate, written as opt.vtk on regression
     while (!converged && iter++ < iters)
     {
-        std::string filename = std::string("EdgesEnergy.") + std::to_string(iter) + ".vtk";
-        MeshFileWriter edgeWriter(mesh, filename.c_str());
-        edgeWriter.WriteEdgesVtk();
+        if (diagnostics.IsDue(iter))
+            OutputEdges((std::string("EdgesEnergy.") + std::to_string(iter) + ".vtk").c_str());
 
         if (!initUseAverageTargetLength  && iter == 1)
             useAverageTargetLength = true;
@@ -85,38 +86,34 @@ void LayerOpt::Run(const size_t iters/* = 1*/)
         //stepSize = initStepSize - (initStepSize - 0.1) / iters;
         stepSize *= initStepSize;
 
-        filename = std::string("MeshOpt.") + std::to_string(iter) + ".vtk";
-        MeshFileWriter writer(mesh, filename.c_str());
-        writer.WriteFile();
-
         double minimumScaledJacobian = 0.0;
         double averageScaledJacobian = 0.0;
-        double maximumScaledJacobian = 0.0;
         std::vector<size_t> badCellIds;
-        m_numOfInvertdElements = GetQuality(filename.c_str(), minimumScaledJacobian, averageScaledJacobian, maximumScaledJacobian, badCellIds);
-        filename = std::string("BadCells.") + std::to_string(iter) + ".vtk";
-        OutputBadCells(badCellIds, filename.c_str());
+        m_numOfInvertdElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, averageScaledJacobian, badCellIds);
+        std::cout << "iter = " << iter << " #inverted = " << m_numOfInvertdElements << " MSJ = " << minimumScaledJacobian << std::endl;
+        if (diagnostics.IsDue(iter)) {
+            diagnostics.WriteMesh(mesh, std::string("MeshOpt.") + std::to_string(iter) + ".vtk");
+            OutputBadCells(badCellIds, (std::string("BadCells.") + std::to_string(iter) + ".vtk").c_str());
+        }
 
         if (prevMinimumScaledJacobian > 0 && minimumScaledJacobian <= prevMinimumScaledJacobian)
         {
-            filename = std::string("MeshOpt.") + std::to_string(iter - 1) + ".vtk";
             std::cout << "*************************" << std::endl;
-            std::cout << "Best Mesh is " << filename << std::endl;
+            std::cout << "Best Mesh is iteration " << iter - 1 << ", written to opt.vtk" << std::endl;
             std::cout << "*************************" << std::endl;
-            MeshFileReader reader(filename.c_str());
-            const Mesh& bestmesh = reader.GetMesh();
-            MeshFileWriter optwriter(bestmesh, "opt.vtk");
-            optwriter.WriteFile();
+            diagnostics.WriteMesh(mesh, prevPositions, "opt.vtk");
             break;
         }
         else if (converged)
         {
             std::cout << "*************************" << std::endl;
-            std::cout << "Converged at " << filename << std::endl;
+            std::cout << "Converged at iteration " << iter << std::endl;
             std::cout << "*************************" << std::endl;
         }
         prevMinimumScaledJacobian = minimumScaledJacobian;
+        prevPositions = DiagnosticsSink::GetPositions(mesh.V);
     }
+    diagnostics.Flush();
 
     std::vector<double> E_total(ESingularity.size());
     for (size_t i = 0; i < ESingularity.size(); i++)
@@ -215,13 +212,10 @@ bool LayerOpt::Optimize()
             mesh.V[i].z = stepSize * X[3 * i + 2] + (1.0 - stepSize) * mesh.V[i].z;
         }
 
-        MeshFileWriter writer(mesh, "temp.vtk");
-        writer.WriteFile();
         double minimumScaledJacobian = 0.0;
         double averageScaledJacobian = 0.0;
-        double maximumScaledJacobian = 0.0;
         std::vector<size_t> badCellIds1;
-        size_t InvertedElements = GetQuality("temp.vtk", minimumScaledJacobian, averageScaledJacobian, maximumScaledJacobian, badCellIds1);
+        size_t InvertedElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, averageScaledJacobian, badCellIds1);
 
         if (InvertedElements > m_numOfInvertdElements){
             std::cout << "Recover previous mesh\n";
@@ -617,60 +611,10 @@ void LayerOpt::ComputeMeshTargetLength()
 //    double avgMeshEdgeLength = sumEdgeLength / numOfBoundaryEdges;
 //    std::cout << "Average Surface Edge Length = " << avgMeshEdgeLength << std::endl;
 
-    std::vector<Trip> coefficients;
-    std::vector<float> b;
-    size_t row  = 0;
-    size_t numOfparallelEids = 0;
-    size_t numOfconsecutiveEids = 0;
-    for (size_t i = 0; i < mesh.E.size(); i++)
-    {
-        coefficients.push_back(Trip(row, i, 1));
-        if (mesh.E[i].isBoundary)
-            b.push_back(mesh.E[i].length);
-//        else if (mesh.E[i].isSingularity)
-//            b.push_back(0.5 * avgMeshEdgeLength);
-        else
-            b.push_back(avgMeshEdgeLength);
-        row++;
-
-        for (size_t j = 0; j < mesh.E[i].parallelEids.size(); j++)
-        {
-            size_t N_Eid = mesh.E[i].parallelEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfparallelEids++;
-            row++;
-        }
-        for (size_t j = 0; j < mesh.E[i].consecutiveEids.size(); j++)
-        {
-            size_t N_Eid = mesh.E[i].consecutiveEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfconsecutiveEids++;
-            row++;
-        }
-    }
-
-    size_t col = mesh.E.size();
-//    std::cout << "Edge Length Row = " << row << std::endl;
-//    std::cout << "Edge Length Col = " << col << std::endl;
-//    std::cout << "numOfparallelEids = " << numOfparallelEids << std::endl;
-//    std::cout << "numOfconsecutiveEids = " << numOfconsecutiveEids << std::endl;
-
-    Eigen::SparseMatrix<float> A(row, col);
-    A.setFromTriplets(coefficients.begin(), coefficients.end());
-    Eigen::SparseMatrix<float> A_T = A.transpose();
-    Eigen::SparseMatrix<float> ATA = A_T * A;
-    //  MatrixXf ;
-    VectorXf X(col), B(row);
-    for (size_t i = 0; i < row; i++)
-        B(i) = b[i];
-
-    VectorXf ATB = A_T * B;
-    Eigen::SparseLU<SpMat> chol(ATA);
-    X = chol.solve(ATB);
+    if (!targetLengthSolver.IsBuilt())
+        targetLengthSolver.Build();
+    std::vector<double> X;
+    targetLengthSolver.Solve(avgMeshEdgeLength, X);
     for (size_t i = 0; i < mesh.E.size(); i++)
         mesh.E[i].length = X[i];
 
@@ -714,9 +658,16 @@ void LayerOpt::SetRecoverable(bool value)
 
 void LayerOpt::OutputBadCells(const std::vector<size_t>& badCellIds, const char* filename)
 {
-    std::vector<Cell> cells(badCellIds.size());
-    for (size_t i = 0; i < badCellIds.size(); i++)
-        cells.at(i) = mesh.C.at(badCellIds.at(i));
-    MeshFileWriter writer(mesh.V, cells, filename);
-    writer.WriteFile();
+    diagnostics.WriteMesh(mesh, badCellIds, filename);
+}
+
+// same output as MeshFileWriter::WriteEdgesVtk
+void LayerOpt::OutputEdges(const char* filename)
+{
+    std::vector<size_t> lines(2 * mesh.E.size());
+    for (size_t i = 0; i < mesh.E.size(); i++) {
+        lines[2 * i] = mesh.E[i].Vids[0];
+        lines[2 * i + 1] = mesh.E[i].Vids[1];
+    }
+    diagnostics.WritePolyData(DiagnosticsSink::GetPositions(mesh.V), std::vector<size_t>(), std::move(lines), std::vector<size_t>(), filename);
 }
@@ -9,6 +9,8 @@
 #define LAYER_OPT_H_
 
 #include "Mesh.h"
+#include "TargetLengthSolver.h"
+#include "DiagnosticsSink.h"
 
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
@@ -55,6 +57,7 @@ private:
     void OptimizeEdgeComformalty(std::vector<Trip>& coefficients, std::vector<float>& B, size_t& m_id);    // * gamma
 
     void OutputBadCells(const std::vector<size_t>& badCellIds, const char* filename);
+    void OutputEdges(const char* filename);
     void OutputFramesOfBadCells(const std::vector<size_t>& badCellIds, const char* filename);
 
 private:
@@ -74,6 +77,11 @@ private:
     std::vector<double> ESingularity;
     std::vector<double> EOrthogonality;
     std::vector<double> EStraightness;
+
+    TargetLengthSolver targetLengthSolver;  // built on the first ComputeMeshTargetLength()
+
+public:
+    DiagnosticsSink diagnostics;    // EdgesEnergy.N, MeshOpt.N and BadCells.N every diagnostics.every iterations
 };
 
 #endif /* LAYER_OPT_H_ */
@@ -9,6 +9,7 @@
 #include "MeshFileReader.h"
 #include "MeshFileWriter.h"
 #include "MeshQuality.h"
+#include "QualityTracker.h"
 
 #include <algorithm>
 #include <vector>
@@ -90,9 +91,7 @@ void LocalMeshOpt::Untangle(const std::vector<size_t>& cellIds, const size_t loc
     localMesh.ExtractSingularities();
     localMesh.SetCosAngleThreshold(0.984807753);
     localMesh.LabelSurface();
-    localMesh.BuildParallelE();
-    localMesh.BuildConsecutiveE();
-    localMesh.BuildOrthogonalE();
+    localMesh.BuildEdgeRelations();
     localMesh.GetNormalOfSurfaceFaces();
     localMesh.GetNormalOfSurfaceVertices();
     localMesh.ExtractTwoRingNeighborSurfaceFaceIdsForEachVertex(2);
@@ -158,34 +157,50 @@ void LocalMeshOpt::ModifyMeshFrom(const Mesh& localMesh, const std::vector<size_
 
 void LocalMeshOpt::Run(const size_t iters/* = 1*/, const size_t localIters/* = 20*/)
 {
+    // Untangle only moves the vertices of the cells it is given, so only the cells around them are evaluated again
+    QualityTracker qualityTracker(mesh);
+    qualityTracker.Build(this->minScaledJacobian);
     int iter = 0;
     while (iter++ != iters) {
-        double minimumScaledJacobian = 0.0;
         std::vector<size_t> badCellIds;
-        m_numOfInvertdElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, badCellIds, this->minScaledJacobian);
+        m_numOfInvertdElements = qualityTracker.GetNumOfInvertedElements();
         if (m_numOfInvertdElements == 0) break;
+        qualityTracker.GetBadCellIds(badCellIds);
 
+        std::vector<size_t> untangledCellIds;
         if (!useSmallBlock) {
-            std::vector<size_t> cellIds = GetBadCellsAndExtendCells(badCellIds, blockSize);
-            Untangle(cellIds, localIters);
+            untangledCellIds = GetBadCellsAndExtendCells(badCellIds, blockSize);
+            Untangle(untangledCellIds, localIters);
         }
         else {
             std::vector<std::vector<size_t> > regions;
             DivideIntoMultipleRegions(badCellIds, regions, blockSize);
             std::cout << "#badCellIds = " << badCellIds.size() << " #regions = " << regions.size() << "\n";
+            std::vector<std::vector<size_t> > regionCellIds(regions.size());
             if (parallel) {
 #pragma omp parallel for
                 for (int i = 0; i < regions.size(); i++) {
-                    std::vector<size_t> cellIds = GetBadCellsAndExtendCells(regions[i]);
-                    Untangle(cellIds, localIters);
+                    regionCellIds[i] = GetBadCellsAndExtendCells(regions[i]);
+                    Untangle(regionCellIds[i], localIters);
                 }
             } else {
                 for (int i = 0; i < regions.size(); i++) {
-                    std::vector<size_t> cellIds = GetBadCellsAndExtendCells(regions[i]);
-                    Untangle(cellIds, localIters);
+                    regionCellIds[i] = GetBadCellsAndExtendCells(regions[i]);
+                    Untangle(regionCellIds[i], localIters);
                 }
             }
+            for (auto& cellIds : regionCellIds)
+                untangledCellIds.insert(untangledCellIds.end(), cellIds.begin(), cellIds.end());
         }
+
+        std::vector<size_t> movedVids;
+        for (auto cellId : untangledCellIds) {
+            const Cell& cell = mesh.C.at(cellId);
+            movedVids.insert(movedVids.end(), cell.Vids.begin(), cell.Vids.end());
+        }
+        std::sort(movedVids.begin(), movedVids.end());
+        movedVids.resize(std::distance(movedVids.begin(), std::unique(movedVids.begin(), movedVids.end())));
+        qualityTracker.UpdateVertices(movedVids);
     }
 
     std::string filename = std::string("BestLocalOpt.vtk");
@@ -168,9 +168,7 @@ void LocalMeshASJOpt::Run(const size_t iters/* = 1*/, const size_t localIters/*
             localMesh.ExtractSingularities();
             localMesh.SetCosAngleThreshold(0.984807753);
             localMesh.LabelSurface();
-            localMesh.BuildParallelE();
-            localMesh.BuildConsecutiveE();
-            localMesh.BuildOrthogonalE();
+            localMesh.BuildEdgeRelations();
             localMesh.GetNormalOfSurfaceFaces();
             localMesh.GetNormalOfSurfaceVertices();
 
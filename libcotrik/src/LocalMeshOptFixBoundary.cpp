@@ -140,9 +140,7 @@ void LocalMeshOptFixBoundary::Run(const size_t iters/* = 1*/, const size_t local
             localMesh.ExtractSingularities();
             localMesh.SetCosAngleThreshold(0.984807753);
             localMesh.LabelSurface();
-            localMesh.BuildParallelE();
-            localMesh.BuildConsecutiveE();
-            localMesh.BuildOrthogonalE();
+            localMesh.BuildEdgeRelations();
             localMesh.GetNormalOfSurfaceFaces();
             localMesh.GetNormalOfSurfaceVertices();
 
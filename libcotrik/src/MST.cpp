@@ -271,75 +271,125 @@ std::vector<size_t> Graph::GetShortestPath(const adjacency_list_t& adjacency_lis
     return path_vids;
 }
 
-CycleExtractor::CycleExtractor(const Mesh& mesh, const std::vector<size_t>& eids) {
-	const auto N = mesh.V.size() > eids.size() ? mesh.V.size() + 1 : eids.size() + 1;
-	graph.resize(N);
-	cycles.resize(N);
-	for (auto eid : eids)
-		addEdge(mesh.E[eid].Vids[0] + 1, mesh.E[eid].Vids[1] + 1);
-
-	std::vector<size_t> color(N, 0); // arrays required to color the graph, 
-	std::vector<size_t> par(N, 0);   // store the parent of node 
-	std::vector<size_t> mark(N, 0);  // mark with unique numbers 
-
-	size_t cyclenumber = 0;                   // store the numbers of cycle 
-	auto start_vid = mesh.E.at(eids.front()).Vids.front();
-	dfs_cycle(start_vid, 0, color, mark, par, cyclenumber); // call DFS to mark the cycles 
-	std::cout << "cyclenumber = " << cyclenumber << std::endl;
-	auto res = getCycleVids(eids.size() - 1, mark, cyclenumber);
-	graph.clear();
-	cycles.clear();
+CycleExtractor::CycleExtractor(const Mesh& mesh, const std::vector<size_t>& eids, bool parallel) {
+	if (eids.empty()) return;
+	addEdges(mesh, eids);
+	if (!parallel) {
+		std::vector<size_t> stack;
+		for (size_t root = 0; root < vids.size(); ++root)
+			if (color[root] == 0) dfs_cycle(root, stack, cycleVids);
+	} else {
+		// components are disjoint in color/par/parEdge/next, so they can be searched concurrently;
+		// roots are the smallest local ids, so the result matches the serial order
+		auto roots = getComponentRoots();
+		std::vector<std::vector<std::vector<size_t>>> componentCycles(roots.size());
+#pragma omp parallel
+		{
+			std::vector<size_t> stack;
+#pragma omp for schedule(dynamic)
+			for (long long i = 0; i < (long long)roots.size(); ++i)
+				dfs_cycle(roots[i], stack, componentCycles[i]);
+		}
+		for (auto& cycles : componentCycles)
+			for (auto& cycle : cycles)
+				cycleVids.push_back(std::move(cycle));
+	}
+	std::cout << "cyclenumber = " << cycleVids.size() << std::endl;
 }
 
 CycleExtractor::~CycleExtractor() {
-	graph.clear();
-	cycles.clear();
 	cycleVids.clear();
 }
 
-void CycleExtractor::addEdge(size_t u, size_t v) {
-	graph[u].push_back(v);
-	graph[v].push_back(u);
+// builds the CSR adjacency over the vertices touched by eids only
+void CycleExtractor::addEdges(const Mesh& mesh, const std::vector<size_t>& eids) {
+	vids.reserve(2 * eids.size());
+	for (auto eid : eids) {
+		auto& e = mesh.E.at(eid);
+		vids.push_back(e.Vids[0]);
+		vids.push_back(e.Vids[1]);
+	}
+	std::sort(vids.begin(), vids.end());
+	vids.erase(std::unique(vids.begin(), vids.end()), vids.end());
+	auto local = [&](size_t vid) { return size_t(std::lower_bound(vids.begin(), vids.end(), vid) - vids.begin()); };
+
+	const auto n = vids.size();
+	std::vector<size_t> ends(2 * eids.size());
+	offsets.assign(n + 1, 0);
+	for (size_t i = 0; i < eids.size(); ++i) {
+		auto& e = mesh.E.at(eids[i]);
+		ends[2 * i] = local(e.Vids[0]);
+		ends[2 * i + 1] = local(e.Vids[1]);
+		++offsets[ends[2 * i] + 1];
+		++offsets[ends[2 * i + 1] + 1];
+	}
+	for (size_t i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+	next.assign(offsets.begin(), offsets.end() - 1);
+	adj.resize(offsets.back());
+	adjEdges.resize(offsets.back());
+	for (size_t i = 0; i < eids.size(); ++i) {
+		auto u = ends[2 * i], v = ends[2 * i + 1];
+		adj[next[u]] = v;
+		adjEdges[next[u]++] = i;
+		adj[next[v]] = u;
+		adjEdges[next[v]++] = i;
+	}
+	next.assign(offsets.begin(), offsets.end() - 1);
+	color.assign(n, 0);
+	par.assign(n, MAXID);
+	parEdge.assign(n, MAXID);
 }
 
-// Function to mark the vertex with different colors for different cycles 
-void CycleExtractor::dfs_cycle(size_t u, size_t p, std::vector<size_t>& color, std::vector<size_t>& mark, std::vector<size_t>& par, 
-	size_t& cyclenumber) {
-	// already (completely) visited vertex. 
-	if (color[u] == 2) return;
-
-	// seen vertex, but was not completely visited -> cycle detected. backtrack based on parents to find the complete cycle. 
-	if (color[u] == 1) {
-		cyclenumber++;
-		int cur = p;
-		mark[cur] = cyclenumber;
-		// backtrack the vertex which are in the current cycle thats found 
-		while (cur != u) {
-			cur = par[cur];
-			mark[cur] = cyclenumber;
+// Every non-tree edge of an undirected dfs joins a vertex to one of its ancestors (still on the stack),
+// the tree path between them closes one basis cycle. Cycles are listed from the ancestor down.
+void CycleExtractor::dfs_cycle(size_t root, std::vector<size_t>& stack, std::vector<std::vector<size_t>>& res) {
+	stack.clear();
+	stack.push_back(root);
+	color[root] = 1;
+	while (!stack.empty()) {
+		auto u = stack.back();
+		if (next[u] == offsets[u + 1]) {
+			color[u] = 2; // completely visited.
+			stack.pop_back();
+			continue;
+		}
+		auto k = next[u]++;
+		auto w = adj[k];
+		if (adjEdges[k] == parEdge[u]) continue;
+		if (color[w] == 0) {
+			color[w] = 1; // partially visited.
+			par[w] = u;
+			parEdge[w] = adjEdges[k];
+			stack.push_back(w);
+		} else if (color[w] == 1) {
+			// back edge -> cycle detected. backtrack based on parents to find the complete cycle.
+			std::vector<size_t> cycle;
+			for (auto cur = u; cur != w; cur = par[cur]) cycle.push_back(vids[cur]);
+			cycle.push_back(vids[w]);
+			std::reverse(cycle.begin(), cycle.end());
+			res.push_back(cycle);
 		}
-		return;
-	}
-	par[u] = p;
-	color[u] = 1; // partially visited. 
-
-					// simple dfs on graph 
-	for (auto v : graph[u]) {
-		// if it has not been visited previously 
-		if (v == par[u]) continue;
-		dfs_cycle(v, u, color, mark, par, cyclenumber);
 	}
-
-	color[u] = 2; // completely visited. 
 }
 
-std::vector<std::vector<size_t>> CycleExtractor::getCycleVids(size_t edges, std::vector<size_t>& mark, size_t& cyclenumber) {
-	for (size_t i = 1; i <= edges; ++i)
-		if (mark[i] != 0) cycles[mark[i]].push_back(i);
-	std::vector<std::vector<size_t>> res(cyclenumber);
-	for (int i = 1; i <= cyclenumber; ++i) {
-		res[i - 1] = cycles[i];
-		for (auto& x : res[i - 1]) --x;
+std::vector<size_t> CycleExtractor::getComponentRoots() {
+	std::vector<size_t> roots;
+	std::vector<char> visited(vids.size(), 0);
+	std::vector<size_t> q;
+	for (size_t root = 0; root < vids.size(); ++root) {
+		if (visited[root]) continue;
+		roots.push_back(root);
+		visited[root] = 1;
+		q.assign(1, root);
+		while (!q.empty()) {
+			auto u = q.back();
+			q.pop_back();
+			for (auto k = offsets[u]; k < offsets[u + 1]; ++k)
+				if (!visited[adj[k]]) {
+					visited[adj[k]] = 1;
+					q.push_back(adj[k]);
+				}
+		}
 	}
-	return res;
+	return roots;
 }
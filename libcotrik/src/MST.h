@@ -54,16 +54,25 @@ struct Graph {
 	std::vector<size_t> GetShortestPath(const adjacency_list_t& adjacency_list, size_t src, size_t dest);
 };
 
+// Extracts a cycle basis (one cycle per non-tree edge of a DFS forest) of the graph formed by eids.
+// Only the vertices touched by eids are allocated; the DFS uses an explicit stack.
 struct CycleExtractor {
-	std::vector<std::vector<size_t>> graph;
-	std::vector<std::vector<size_t>> cycles;
 	std::vector<std::vector<size_t>> cycleVids;
 
-	CycleExtractor(const Mesh& mesh, const std::vector<size_t>& eids);
+	CycleExtractor(const Mesh& mesh, const std::vector<size_t>& eids, bool parallel = false);
 	~CycleExtractor();
-	void addEdge(size_t u, size_t v);
-	// Function to mark the vertex with different colors for different cycles 
-	void dfs_cycle(size_t u, size_t p, std::vector<size_t>& color, std::vector<size_t>& mark, std::vector<size_t>& par, 
-		size_t& cyclenumber);
-	std::vector<std::vector<size_t>> getCycleVids(size_t edges, std::vector<size_t>& mark, size_t& cyclenumber);
+private:
+	void addEdges(const Mesh& mesh, const std::vector<size_t>& eids);
+	// iterative dfs from root, appends the cycles of root's connected component to res
+	void dfs_cycle(size_t root, std::vector<size_t>& stack, std::vector<std::vector<size_t>>& res);
+	std::vector<size_t> getComponentRoots();
+
+	std::vector<size_t> vids;       // local id -> mesh vid
+	std::vector<size_t> offsets;    // CSR adjacency over local ids
+	std::vector<size_t> adj;        // neighbor local id
+	std::vector<size_t> adjEdges;   // position of the edge in eids
+	std::vector<char> color;        // 0 unvisited, 1 on the dfs stack, 2 finished
+	std::vector<size_t> par;        // parent local id in the dfs forest
+	std::vector<size_t> parEdge;    // edge to the parent
+	std::vector<size_t> next;       // next adjacency position to visit
 };
@@ -9,9 +9,11 @@
 #include "MeshFileReader.h"
 #include "MeshFileWriter.h"
 #include "FeatureLine.h"
+#include "SortedIds.h"
 //#include "MeshQuality.h"
 #include "glm/gtx/intersect.hpp"
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <iostream>
 
@@ -93,6 +95,7 @@ Mesh::Mesh(const Mesh& r)
 , cellScalarFields(r.cellScalarFields)
 , avgEdgeLength(r.avgEdgeLength)
 , numOfSharpEdges(r.numOfSharpEdges)
+, edgeRelationsStamp(r.edgeRelationsStamp)
 {
     m_refIds.resize(V.size());
     for (size_t i = 0; i < V.size(); ++i) m_refIds[i] = i;
@@ -246,113 +249,140 @@ void Mesh::BuildE() {
     }
 }
 
-void Mesh::BuildParallelE() {
-    if (m_cellType == HEXAHEDRA) {
-        for (size_t i = 0; i < F.size(); i++)
-            for (size_t j = 0; j < F[i].N_Ortho_4Eids.size(); j++)
-                for (size_t k = 0; k < 4; k++)
-                    for (size_t m = 0; m < 4; m++)
-                        if (k != m)
-                            E[F[i].N_Ortho_4Eids[j][k]].parallelEids.push_back(F[i].N_Ortho_4Eids[j][m]);
-
-        for (size_t i = 0; i < E.size(); i++)
-			Util::set_redundent_clearn(E[i].parallelEids);
-    } else //if (m_cellType == QUAD) 
-	{
-        for (auto& e : E) {
-            for (auto& fid : e.N_Fids)
-				if (F.at(fid).Eids.size() == 4)
-                for (auto& edgeid : F.at(fid).Eids) {
-                    auto& edge = E.at(edgeid);
-                    if (edge.Vids[0] != e.Vids[0] && edge.Vids[1] != e.Vids[1] && edge.Vids[0] != e.Vids[1] && edge.Vids[1] != e.Vids[0]) e.parallelEids.push_back(edgeid);
+// hex: edge -> groups of 4 parallel edges (Face::N_Ortho_4Eids) containing it, as CSR
+static void GetParallelGroups(const Mesh& mesh, std::vector<const std::vector<size_t>*>& groups, std::vector<size_t>& offsets, std::vector<size_t>& groupIds) {
+    groups.clear();
+    for (auto& f : mesh.F)
+        for (auto& g : f.N_Ortho_4Eids)
+            groups.push_back(&g);
+    offsets.assign(mesh.E.size() + 1, 0);
+    for (auto g : groups)
+        for (auto eid : *g) ++offsets[eid + 1];
+    for (size_t i = 0; i < mesh.E.size(); i++) offsets[i + 1] += offsets[i];
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    groupIds.resize(offsets.back());
+    for (size_t i = 0; i < groups.size(); i++)
+        for (auto eid : *groups[i]) groupIds[cursor[eid]++] = i;
+}
+
+static size_t GetNumOfSharedVids(const Edge& e1, const Edge& e2) {
+    size_t count = 0;
+    for (auto vid : e1.Vids)
+        if (vid == e2.Vids[0] || vid == e2.Vids[1]) ++count;
+    return count;
+}
+
+static void SortAndUnique(std::vector<size_t>& eids) {
+    std::sort(eids.begin(), eids.end());
+    eids.erase(std::unique(eids.begin(), eids.end()), eids.end());
+}
+
+// unique over all meshes, so an assigned mesh never inherits a stamp a solver has seen for other relations
+static size_t NextEdgeRelationsStamp() {
+    static std::atomic<size_t> stamp(0);
+    return ++stamp;
+}
+
+// each Get*Eids clears res first, so the Build*E sweeps replace the relations of an earlier call
+static void GetParallelEids(const Mesh& mesh, const Edge& e, const std::vector<const std::vector<size_t>*>& groups,
+        const std::vector<size_t>& offsets, const std::vector<size_t>& groupIds, std::vector<size_t>& res) {
+    res.clear();
+    if (mesh.m_cellType == HEXAHEDRA) {
+        for (size_t i = offsets[e.id]; i < offsets[e.id + 1]; i++)
+            for (auto eid : *groups[groupIds[i]])
+                if (eid != e.id) res.push_back(eid);
+    } else {
+        // the edge in a quad that shares no vertex with e
+        for (auto fid : e.N_Fids)
+            if (mesh.F.at(fid).Eids.size() == 4)
+                for (auto edgeid : mesh.F.at(fid).Eids)
+                    if (GetNumOfSharedVids(mesh.E.at(edgeid), e) == 0) res.push_back(edgeid);
+    }
+    SortAndUnique(res);
+}
+
+static void GetConsecutiveEids(const Mesh& mesh, const Edge& e, std::vector<size_t>& res) {
+    res.clear();
+    if (mesh.m_cellType == HEXAHEDRA) {
+        // edges at either end that are not on a face of e
+        std::vector<size_t> fes;
+        for (auto fid : e.N_Fids)
+            fes.insert(fes.end(), mesh.F[fid].Eids.begin(), mesh.F[fid].Eids.end());
+        SortAndUnique(fes);
+        for (auto vid : e.Vids)
+            for (auto eid : mesh.V[vid].N_Eids)
+                if (!std::binary_search(fes.begin(), fes.end(), eid)) res.push_back(eid);
+    } else {
+        // edges at a regular end of e, on a face around that end that holds only one vertex of e,
+        // and sharing no face with e
+        for (auto vid : e.Vids) {
+            if (mesh.V[vid].isSingularity) continue;
+            for (auto fid : mesh.V[vid].N_Fids) {
+                if (std::find(e.N_Fids.begin(), e.N_Fids.end(), fid) != e.N_Fids.end()) continue;
+                const Face& f = mesh.F.at(fid);
+                int count = 0;
+                for (auto fvid : f.Vids)
+                    if (fvid == e.Vids[0] || fvid == e.Vids[1]) ++count;
+                if (count > 1) continue;
+                for (auto edgeid : f.Eids) {
+                    const Edge& edge = mesh.E.at(edgeid);
+                    if (GetNumOfSharedVids(edge, e) == 0) continue;
+                    bool sharesFace = false;
+                    for (auto nfid : edge.N_Fids)
+                        if (std::find(e.N_Fids.begin(), e.N_Fids.end(), nfid) != e.N_Fids.end()) sharesFace = true;
+                    if (!sharesFace) res.push_back(edgeid);
                 }
+            }
         }
     }
+    SortAndUnique(res);
+}
+
+static void GetOrthogonalEids(const Mesh& mesh, const Edge& e, std::vector<size_t>& res) {
+    // the face edges sharing exactly one vertex with e
+    res.clear();
+    for (auto fid : e.N_Fids)
+        for (auto edgeid : mesh.F[fid].Eids)
+            if (GetNumOfSharedVids(mesh.E.at(edgeid), e) == 1) res.push_back(edgeid);
+    SortAndUnique(res);
+}
+
+void Mesh::BuildParallelE() {
+    std::vector<const std::vector<size_t>*> groups;
+    std::vector<size_t> offsets, groupIds;
+    if (m_cellType == HEXAHEDRA) GetParallelGroups(*this, groups, offsets, groupIds);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)E.size(); i++)
+        GetParallelEids(*this, E[i], groups, offsets, groupIds, E[i].parallelEids);
+    edgeRelationsStamp = NextEdgeRelationsStamp();
 }
 
 void Mesh::BuildConsecutiveE() {
-	if (m_cellType == HEXAHEDRA) {
-		for (size_t i = 0; i < E.size(); i++) {
-			std::vector<size_t> fes;
-			for (size_t j = 0; j < E[i].N_Fids.size(); j++) {
-				size_t fid = E[i].N_Fids[j];
-				for (size_t k = 0; k < 4; k++)
-					fes.push_back(F[fid].Eids[k]);
-			}
-			Util::set_redundent_clearn(fes);
-			for (size_t j = 0; j < 2; j++) {
-				int vid = E[i].Vids[j];
-				std::vector<size_t> leftes;
-				Util::set_exclusion(V[vid].N_Eids, fes, leftes);
-				std::copy(leftes.begin(), leftes.end(), back_inserter(E[i].consecutiveEids));
-			}
-			Util::set_redundent_clearn(E[i].consecutiveEids);
-		}
-	} else //if (m_cellType == QUAD) 
-	{
-		for (auto& e : E) {
-			std::set<size_t> fids;
-			for (auto vid : e.Vids)
-				if (!V[vid].isSingularity) fids.insert(V[vid].N_Fids.begin(), V[vid].N_Fids.end());
-			for (auto fid : e.N_Fids)
-				fids.erase(fid);
-
-			std::set<size_t> consecutive_eids;
-			for (auto fid : fids) {
-				//if (F.at(fid).Eids.size() != 4) break;
-				int count = 0;
-				for (auto vid : F.at(fid).Vids)
-					if (vid == e.Vids[0] || vid == e.Vids[1]) ++count;
-				if (count > 1) continue;
-				for (auto edgeid : F.at(fid).Eids) {
-					auto& edge = E.at(edgeid);
-					//if (edge.N_Fids[0] != e.N_Fids[0] && edge.N_Fids[1] != e.N_Fids[1] && edge.N_Fids[0] != e.Vids[1] && edge.N_Fids[1] != e.N_Fids[0])
-					//	consecutive_eids.insert(edgeid);
-					if (edge.Vids[0] == e.Vids[0] || edge.Vids[1] == e.Vids[1] || edge.Vids[0] == e.Vids[1] || edge.Vids[1] == e.Vids[0]) {
-						bool found = true;
-						for (auto nfid : edge.N_Fids) {
-							for (auto nnfid : e.N_Fids)
-								if (nnfid == nfid) {
-									found = false;
-									break;
-								}
-							if (!found)
-								break;
-						}
-						if (!found) continue;
-						consecutive_eids.insert(edgeid);
-					}
-				}
-			}
-			for (auto eid : consecutive_eids)
-				e.consecutiveEids.push_back(eid);
-		}
-	}
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)E.size(); i++)
+        GetConsecutiveEids(*this, E[i], E[i].consecutiveEids);
+    edgeRelationsStamp = NextEdgeRelationsStamp();
 }
 
 void Mesh::BuildOrthogonalE() {
-    for (size_t i = 0; i < E.size(); i++) {
-        Edge& edge = E.at(i);
-        std::vector<size_t> faceEdges;
-        for (size_t j = 0; j < E[i].N_Fids.size(); j++) {
-            size_t fid = E[i].N_Fids[j];
-            for (size_t k = 0; k < 4; k++)
-                faceEdges.push_back(F[fid].Eids[k]);
-        }
-		Util::set_redundent_clearn(faceEdges);
-        size_t vid1 = edge.Vids[0];
-        size_t vid2 = edge.Vids[1];
-        for (size_t j = 0; j < faceEdges.size(); j++) {
-            bool hasVid1 = false;
-            bool hasVid2 = false;
-            const Edge& faceEdge = E.at(faceEdges.at(j));
-            for (size_t k = 0; k < faceEdge.Vids.size(); k++) {
-                if (faceEdge.Vids.at(k) == vid1) hasVid1 = true;
-                if (faceEdge.Vids.at(k) == vid2) hasVid2 = true;
-            }
-            if (hasVid1 ^ hasVid2) edge.orthogonalEids.push_back(faceEdge.id);
-        }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)E.size(); i++)
+        GetOrthogonalEids(*this, E[i], E[i].orthogonalEids);
+    edgeRelationsStamp = NextEdgeRelationsStamp();
+}
+
+void Mesh::BuildEdgeRelations() {
+    std::vector<const std::vector<size_t>*> groups;
+    std::vector<size_t> offsets, groupIds;
+    if (m_cellType == HEXAHEDRA) GetParallelGroups(*this, groups, offsets, groupIds);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)E.size(); i++) {
+        Edge& e = E[i];
+        GetParallelEids(*this, e, groups, offsets, groupIds, e.parallelEids);
+        GetConsecutiveEids(*this, e, e.consecutiveEids);
+        GetOrthogonalEids(*this, e, e.orthogonalEids);
     }
+    edgeRelationsStamp = NextEdgeRelationsStamp();
 }
 
 void Mesh::GetNormalOfSurfaceFaces() {
@@ -2050,24 +2080,12 @@ glm::dvec3 Mesh::LapLace(const Vertex& v, const bool treatSharpFeatureAsRegular/
 //        return v.xyz();
 //}
 
-static void set_cross(const std::vector<size_t>& set1, const std::vector<size_t>& set2, std::vector<size_t> &result_set) {
+// ids of set1 that are also in set2, in the order of set1; for the few unsorted ids around one element
+template <typename Ids1, typename Ids2, typename Out>
+static void set_cross(const Ids1& set1, const Ids2& set2, Out& result_set) {
     result_set.clear();
-    for (size_t i = 0; i < set1.size(); i++) {
-        bool inside = false;
-        for (size_t j = 0; j < set2.size(); j++)
-            if (set2[j] == set1[i]) {
-                inside = true;
-                break;
-            }
-        if (inside) result_set.push_back(set1[i]);
-    }
-}
-
-std::vector<size_t> unique(const std::vector<size_t>& s) {
-	std::vector<size_t> res;
-	std::set<size_t> ss(s.begin(), s.end());
-	std::copy(ss.begin(), ss.end(), std::back_inserter(res));
-	return res;
+    for (auto id : set1)
+        if (std::find(set2.begin(), set2.end(), id) != set2.end()) result_set.push_back(id);
 }
 
 void Mesh::BuildF()
@@ -2422,7 +2440,7 @@ void Mesh::BuildF()
             std::vector<size_t> N_4Eids(4);
             for (size_t j = 1; j < F[i].N_Ortho_4Vids.size(); j++) {
                 for (size_t k = 0; k < 4; k++) {
-                    std::vector<size_t> sharedEids;
+                    SmallIds<4> sharedEids;
                     set_cross(V[F[i].N_Ortho_4Vids[j - 1][k]].N_Eids, V[F[i].N_Ortho_4Vids[j][k]].N_Eids, sharedEids);
                     N_4Eids[k] = sharedEids[0];
                 }
@@ -2488,7 +2506,7 @@ void Mesh::BuildF()
 		}
 
 		for (auto& f : F)
-			f.N_Cids = unique(f.N_Cids);
+			SortIds(f.N_Cids);
 
 		for (auto& f : F) {
 			for (size_t j = 0; j < f.Vids.size(); j++) {
@@ -3121,7 +3139,7 @@ void Mesh::ExtractBoundary() {
             for (size_t j = 0; j < neighborhs.size(); j++) {
                 if (tags[j]) continue;
 
-                std::vector<size_t> fs_pre, fs_cur;
+                SmallIds<6> fs_pre, fs_cur;
                 if (m_cellType == HEXAHEDRA) for (int k = 0; k < 6; k++) {
                     fs_pre.push_back(C[pre_].Fids[k]);
                     fs_cur.push_back(C[neighborhs[j]].Fids[k]);
@@ -3130,7 +3148,7 @@ void Mesh::ExtractBoundary() {
                     fs_pre.push_back(C[pre_].Fids[k]);
                     fs_cur.push_back(C[neighborhs[j]].Fids[k]);
                 }
-                std::vector<size_t> sharedf;
+                SmallIds<6> sharedf;
                 set_cross(fs_pre, fs_cur, sharedf);
                 if (sharedf.size()) {
                     E[i].N_Cids.push_back(neighborhs[j]);
@@ -3175,116 +3193,95 @@ void Mesh::ExtractBoundary() {
     }
 }
 
-size_t Mesh::ExtractLayers() {
-    std::vector<bool> savedCellBoundary(C.size(), false);
+// depth of a cell = number of face adjacent steps to the nearest boundary cell, by one multi source BFS;
+// layers[k] holds the cells of depth k and innerLayers[k] the cells deeper than k, which is what peeling the
+// boundary cells off the remaining submesh again and again gives
+size_t Mesh::ExtractLayers(const bool writeFiles/* = true*/) {
+    std::vector<size_t> depths(C.size(), MAXID);
+    std::vector<size_t> front;
     for (size_t i = 0; i < C.size(); i++)
-        savedCellBoundary.at(i) = C[i].isBoundary;
-
-    std::vector<Cell> surfaceCells;
-    std::vector<Cell> innerCells;
-
-    int layerCount = 1;
-    for (size_t i = 0; i < C.size(); i++) {
-        if (C[i].isBoundary) surfaceCells.push_back(C[i]);
-        else innerCells.push_back(C[i]);
-    }
-    while (!innerCells.empty()) {
-        // -------------------------------------------------------
-        // build outLayer
-        {
-            Layer layer;
-            for (size_t i = 0; i < surfaceCells.size(); i++)
-                layer.Cids.push_back(surfaceCells[i].id);
-
-            for (size_t i = 0; i < layer.Cids.size(); i++) {
-                const Cell& cell = C[layer.Cids[i]];
-                for (size_t j = 0; j < cell.Fids.size(); j++)
-                    layer.Fids.push_back(cell.Fids[j]);
-                for (size_t j = 0; j < cell.Eids.size(); j++)
-                    layer.Eids.push_back(cell.Eids[j]);
-                for (size_t j = 0; j < cell.Vids.size(); j++)
-                    layer.Vids.push_back(cell.Vids[j]);
-            }
-            std::sort(layer.Fids.begin(), layer.Fids.end());
-            std::vector<size_t>::iterator iterF = std::unique(layer.Fids.begin(), layer.Fids.end());
-            layer.Fids.resize(std::distance(layer.Fids.begin(), iterF));
-
-            std::sort(layer.Eids.begin(), layer.Eids.end());
-            std::vector<size_t>::iterator iterE = std::unique(layer.Eids.begin(), layer.Eids.end());
-            layer.Eids.resize(std::distance(layer.Eids.begin(), iterE));
-
-            std::sort(layer.Vids.begin(), layer.Vids.end());
-            std::vector<size_t>::iterator iterV = std::unique(layer.Vids.begin(), layer.Vids.end());
-            layer.Vids.resize(std::distance(layer.Vids.begin(), iterV));
-
-            layer.fixed.resize(layer.Vids.size(), false);
-            for (size_t i = 0; i < layer.Vids.size(); i++)
-                if (V[layer.Vids[i]].isBoundary) layer.fixed.at(i) = true;
-            layers.push_back(layer);
-        }
-        // build innerLayer
-        {
-            Layer layer;
-            for (size_t i = 0; i < innerCells.size(); i++)
-                layer.Cids.push_back(innerCells[i].id);
-
-            for (size_t i = 0; i < layer.Cids.size(); i++){
-                const Cell& cell = C[layer.Cids[i]];
-                for (size_t j = 0; j < cell.Fids.size(); j++)
-                    layer.Fids.push_back(cell.Fids[j]);
-                for (size_t j = 0; j < cell.Eids.size(); j++)
-                    layer.Eids.push_back(cell.Eids[j]);
-                for (size_t j = 0; j < cell.Vids.size(); j++)
-                    layer.Vids.push_back(cell.Vids[j]);
-            }
-            std::sort(layer.Fids.begin(), layer.Fids.end());
-            std::vector<size_t>::iterator iterF = std::unique(layer.Fids.begin(), layer.Fids.end());
-            layer.Fids.resize(std::distance(layer.Fids.begin(), iterF));
-
-            std::sort(layer.Eids.begin(), layer.Eids.end());
-            std::vector<size_t>::iterator iterE = std::unique(layer.Eids.begin(), layer.Eids.end());
-            layer.Eids.resize(std::distance(layer.Eids.begin(), iterE));
-
-            std::sort(layer.Vids.begin(), layer.Vids.end());
-            std::vector<size_t>::iterator iterV = std::unique(layer.Vids.begin(), layer.Vids.end());
-            layer.Vids.resize(std::distance(layer.Vids.begin(), iterV));
-
-            layer.fixed.resize(layer.Vids.size(), false);
-            for (size_t i = 0; i < layer.Vids.size(); i++)
-                if (V[layer.Vids[i]].isBoundary) layer.fixed.at(i) = true;
-            innerLayers.push_back(layer);
-        }
-        // -------------------------------------------------------
-        std::string surfaceCellsFileName = std::string("OutLayer") + std::to_string(layerCount) + ".vtk";
-        MeshFileWriter surfaceCellsWriter(V, surfaceCells, surfaceCellsFileName.c_str(), HEXAHEDRA);
-        surfaceCellsWriter.SetFixFlag(true);
-        surfaceCellsWriter.WriteFile();
-
-        std::string innerCellsFileName = std::string("InnerLayer") + std::to_string(layerCount) + ".vtk";
-        MeshFileWriter innerCellsWriter(V, innerCells, innerCellsFileName.c_str(), HEXAHEDRA);
-        innerCellsWriter.SetFixFlag(true);
-        innerCellsWriter.WriteFile();
-
-        MeshFileReader innerCellsReader(innerCellsFileName.c_str());
-        Mesh& mesh = (Mesh&)innerCellsReader.GetMesh();
-        mesh.BuildAllConnectivities();
-        mesh.ExtractBoundary();
-
-        std::vector<Cell> newC = innerCells;
-        surfaceCells.clear();
-        innerCells.clear();
-        for (size_t i = 0; i < newC.size(); i++) {
-            if (mesh.C[i].isBoundary) surfaceCells.push_back(newC[i]);
-            else innerCells.push_back(newC[i]);
-        }
-
-        layerCount++;
-    }
-
+        if (C[i].isBoundary) {
+            depths[i] = 0;
+            front.push_back(i);
+        }
+    size_t maxDepth = 0;
+    while (!front.empty()) {
+        std::vector<size_t> next;
+        for (auto cid : front)
+            for (auto fid : C[cid].Fids)
+                for (auto ncid : F[fid].N_Cids)
+                    if (depths[ncid] == MAXID) {
+                        depths[ncid] = depths[cid] + 1;
+                        next.push_back(ncid);
+                    }
+        if (!next.empty()) maxDepth = depths[next.front()];
+        front.swap(next);
+    }
+
+    // bucket the cells by depth with a counting sort, cells not reached from the boundary go last;
+    // within a bucket the cell ids stay ascending
+    const size_t numOfLayers = maxDepth;
+    std::vector<size_t> depthOffsets(maxDepth + 3, 0);
+    for (auto depth : depths)
+        depthOffsets[(depth == MAXID ? maxDepth + 1 : depth) + 1]++;
+    for (size_t d = 0; d + 1 < depthOffsets.size(); d++)
+        depthOffsets[d + 1] += depthOffsets[d];
+    std::vector<size_t> depthCids(C.size());
+    std::vector<size_t> cursor(depthOffsets.begin(), depthOffsets.end() - 1);
     for (size_t i = 0; i < C.size(); i++)
-        C[i].isBoundary = savedCellBoundary.at(i);
-
-    return layerCount;
+        depthCids[cursor[depths[i] == MAXID ? maxDepth + 1 : depths[i]]++] = i;
+
+    const size_t begin = layers.size();
+    layers.resize(begin + numOfLayers);
+    innerLayers.resize(begin + numOfLayers);
+    auto buildLayer = [&](Layer& layer) {
+        for (auto cid : layer.Cids) {
+            const Cell& cell = C[cid];
+            layer.Fids.insert(layer.Fids.end(), cell.Fids.begin(), cell.Fids.end());
+            layer.Eids.insert(layer.Eids.end(), cell.Eids.begin(), cell.Eids.end());
+            layer.Vids.insert(layer.Vids.end(), cell.Vids.begin(), cell.Vids.end());
+        }
+        std::sort(layer.Fids.begin(), layer.Fids.end());
+        layer.Fids.resize(std::distance(layer.Fids.begin(), std::unique(layer.Fids.begin(), layer.Fids.end())));
+        std::sort(layer.Eids.begin(), layer.Eids.end());
+        layer.Eids.resize(std::distance(layer.Eids.begin(), std::unique(layer.Eids.begin(), layer.Eids.end())));
+        std::sort(layer.Vids.begin(), layer.Vids.end());
+        layer.Vids.resize(std::distance(layer.Vids.begin(), std::unique(layer.Vids.begin(), layer.Vids.end())));
+        layer.fixed.resize(layer.Vids.size(), false);
+        for (size_t i = 0; i < layer.Vids.size(); i++)
+            if (V[layer.Vids[i]].isBoundary) layer.fixed.at(i) = true;
+    };
+#pragma omp parallel for schedule(dynamic)
+    for (long long k = 0; k < (long long)numOfLayers; k++) {
+        Layer& outLayer = layers[begin + k];
+        Layer& innerLayer = innerLayers[begin + k];
+        outLayer.Cids.assign(depthCids.begin() + depthOffsets[k], depthCids.begin() + depthOffsets[k + 1]);
+        innerLayer.Cids.assign(depthCids.begin() + depthOffsets[k + 1], depthCids.end());
+        std::sort(innerLayer.Cids.begin(), innerLayer.Cids.end());
+        buildLayer(outLayer);
+        buildLayer(innerLayer);
+    }
+
+    if (writeFiles)
+        for (size_t k = 0; k < numOfLayers; k++) {
+            std::vector<Cell> surfaceCells, innerCells;
+            for (auto cid : layers[begin + k].Cids)
+                surfaceCells.push_back(C[cid]);
+            for (auto cid : innerLayers[begin + k].Cids)
+                innerCells.push_back(C[cid]);
+
+            std::string surfaceCellsFileName = std::string("OutLayer") + std::to_string(k + 1) + ".vtk";
+            MeshFileWriter surfaceCellsWriter(V, surfaceCells, surfaceCellsFileName.c_str(), HEXAHEDRA);
+            surfaceCellsWriter.SetFixFlag(true);
+            surfaceCellsWriter.WriteFile();
+
+            std::string innerCellsFileName = std::string("InnerLayer") + std::to_string(k + 1) + ".vtk";
+            MeshFileWriter innerCellsWriter(V, innerCells, innerCellsFileName.c_str(), HEXAHEDRA);
+            innerCellsWriter.SetFixFlag(true);
+            innerCellsWriter.WriteFile();
+        }
+
+    return numOfLayers + 1;
 }
 
 //size_t Mesh::ExtractLayers()
@@ -494,12 +494,13 @@ public:
     inline bool HasBoundary() const;
 	inline bool IsSurfaceMesh() const;
 	inline bool IsVolumetricMesh() const;
-    size_t ExtractLayers();
+    size_t ExtractLayers(const bool writeFiles = true); // needs ExtractBoundary
     void ExtractSingularities();
     void ExtractTwoRingNeighborSurfaceFaceIdsForEachVertex(int N = 2);
     void BuildParallelE();
     void BuildConsecutiveE();
     void BuildOrthogonalE();
+    void BuildEdgeRelations(); // parallel, consecutive and orthogonal edges of every Edge in one sweep, each list sorted and unique
     void GetNormalOfSurfaceFaces();             // must ExtractBoundary(); first
     void GetNormalOfSurfaceVertices();          // must ExtractBoundary(); first
     void RemoveUselessVertices();
@@ -608,6 +609,7 @@ public:
     size_t numberOfPatches = 0;
 
     bool hasBoundary = false;
+    size_t edgeRelationsStamp = 0;  // changes on every Build*E/BuildEdgeRelations, caches built on the relations compare it
 };
 
 #endif /* MESH_H_ */
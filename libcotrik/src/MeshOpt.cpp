@@ -34,6 +34,9 @@ MeshOpt::MeshOpt(const Mesh& mesh)
 , allowBigStep(false)
 , changeBoundary(false)
 , m_numOfInvertdElements(MAXID)
+, targetLengthSolver(mesh)
+, qualityTracker(mesh)
+, diagnostics(0)
 {
     // TODO Auto-generated constructor stub
 
@@ -83,8 +86,9 @@ size_t MeshOpt::Run(const size_t iters/* = 1*/)
 //                                        badCellIdsT, true, this->minScaledJacobian);
 //    m_numOfInvertdElements = GetMinScaledJacobian(mesh, minimumScaledJacobianT, badCellIdsT, this->minScaledJacobian);
     //----------------------------------------------
-    double minimumScaledJacobian = 0.0;
-    m_numOfInvertdElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, this->minScaledJacobian);
+    qualityTracker.Build(this->minScaledJacobian);
+    double minimumScaledJacobian = qualityTracker.GetMinScaledJacobian();
+    m_numOfInvertdElements = qualityTracker.GetNumOfInvertedElements();
     std::cout << "iter = " << 0 << " #inverted = " << m_numOfInvertdElements << " MSJ = " << minimumScaledJacobian << std::endl;
     //----------------------------------------------
     int iter = 0;
@@ -141,8 +145,11 @@ size_t MeshOpt::Run(const size_t iters/* = 1*/)
 //        double minimumScaledJacobian = 0.0; std::vector<size_t> badCellIds;
 //        m_numOfInvertdElements = GetMinScaledJacobian(mesh, minimumScaledJacobian, badCellIds, this->minScaledJacobian);
 
-        m_numOfInvertdElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, this->minScaledJacobian);
+        minimumScaledJacobian = qualityTracker.GetMinScaledJacobian();
+        m_numOfInvertdElements = qualityTracker.GetNumOfInvertedElements();
         std::cout << "iter = " << iter << " #inverted = " << m_numOfInvertdElements << " MSJ = " << minimumScaledJacobian << std::endl;
+        if (diagnostics.IsDue(iter))
+            diagnostics.WriteMesh(mesh, std::string("MeshOpt.") + std::to_string(iter) + ".vtk");
         if (prevMinimumScaledJacobian > this->minScaledJacobian && minimumScaledJacobian <= prevMinimumScaledJacobian)
         {
             filename = std::string("MeshOpt.") + std::to_string(iter - 1) + ".vtk";
@@ -184,6 +191,7 @@ size_t MeshOpt::Run(const size_t iters/* = 1*/)
 //        std::cout << "\t" << EStraightness.at(i);
 //    std::cout << "\n*************************\n" << std::endl;
 
+    diagnostics.Flush();
 //    if (untangled)
         return iter - 1;
 //    return iter;
@@ -321,8 +329,12 @@ bool MeshOpt::Optimize()
 //        size_t InvertedElements = GetQuality("temp.vtk", minimumScaledJacobian, averageScaledJacobian, maximumScaledJacobian,
 //                                             badCellIds1, true, this->minScaledJacobian);
 
-        double minimumScaledJacobian = 0.0;
-        size_t InvertedElements = GetMinScaledJacobianVerdict(mesh, minimumScaledJacobian, this->minScaledJacobian);
+        std::vector<size_t> movedVids;
+        for (size_t i = 0; i < mesh.V.size(); i++)
+            if (mesh.V[i].x != oldV[i].x || mesh.V[i].y != oldV[i].y || mesh.V[i].z != oldV[i].z)
+                movedVids.push_back(i);
+        qualityTracker.UpdateVertices(movedVids);
+        size_t InvertedElements = qualityTracker.GetNumOfInvertedElements();
         // std::cout << "InvertedElements = " << InvertedElements << " m_numOfInvertdElements = " << m_numOfInvertdElements << " minimumScaledJacobian = " << minimumScaledJacobian << std::endl;
         if (InvertedElements > m_numOfInvertdElements) {
             std::cout << "Recover previous mesh\n";
@@ -332,9 +344,11 @@ bool MeshOpt::Optimize()
                 mesh.V[i].y = oldV[i].y;
                 mesh.V[i].z = oldV[i].z;
             }
+            qualityTracker.UpdateVertices(movedVids);
         }
     }
     else {
+        std::vector<size_t> movedVids;
         for (size_t i = 0; i < mesh.V.size(); i++)
         {
             if (fabs(double(mesh.V[i].x - X[3 * i + 0])) > 1e-6
@@ -353,7 +367,9 @@ bool MeshOpt::Optimize()
             mesh.V[i].x = stepSize * X[3 * i + 0] + (1.0 - stepSize) * mesh.V[i].x;
             mesh.V[i].y = stepSize * X[3 * i + 1] + (1.0 - stepSize) * mesh.V[i].y;
             mesh.V[i].z = stepSize * X[3 * i + 2] + (1.0 - stepSize) * mesh.V[i].z;
+            movedVids.push_back(i);
         }
+        qualityTracker.UpdateVertices(movedVids);
     }
     return converged;
 }
@@ -1447,99 +1463,10 @@ void MeshOpt::ComputeMeshTargetLength()
     std::cout << "=============================\n";
     std::cout << "   Computing TargetLength    \n";
 
-    std::vector<Trip> coefficients;
-    std::vector<float> b;
-    size_t row  = 0;
-    size_t numOfparallelEids = 0;
-    size_t numOfconsecutiveEids = 0;
-    for (size_t i = 0; i < mesh.E.size(); i++)
-    {
-        coefficients.push_back(Trip(row, i, 1));
-        if (mesh.E[i].isBoundary)
-            b.push_back(mesh.E[i].length);
-//        else if (mesh.E[i].isSingularity)
-//            b.push_back(0.5 * avgMeshEdgeLength);
-        else
-            b.push_back(avgMeshEdgeLength);
-        row++;
-
-        for (size_t j = 0; j < mesh.E[i].parallelEids.size(); j++)
-        {
-            size_t N_Eid = mesh.E[i].parallelEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfparallelEids++;
-            row++;
-        }
-        for (size_t j = 0; j < mesh.E[i].consecutiveEids.size(); j++)
-        {
-            size_t N_Eid = mesh.E[i].consecutiveEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfconsecutiveEids++;
-            row++;
-        }
-    }
-
-    for (size_t k = 0; k < mesh.E.size(); k++){
-        const Edge& edge = mesh.E.at(k);
-        if (!edge.isSingularity)
-            continue;
-        if (edge.N_Cids.size() != 5 && edge.N_Cids.size() != 3 && edge.N_Cids.size() != 6)
-            continue;
-        for (size_t j = 0; j < edge.orthogonalEids.size(); j++) {
-            for (size_t i = 0; i < edge.orthogonalEids.size(); i++) {
-                if (j == i)
-                    continue;
-                const size_t edgeId1 = edge.orthogonalEids.at(j);
-                const size_t edgeId2 = edge.orthogonalEids.at(i);
-                /*const */ Edge& edge1 = mesh.E.at(edgeId1);
-                /*const */ Edge& edge2 = mesh.E.at(edgeId2);
-                const size_t vId1_1 = edge1.Vids.at(0);
-                const size_t vId1_2 = edge1.Vids.at(1);
-                const size_t vId2_1 = edge2.Vids.at(0);
-                const size_t vId2_2 = edge2.Vids.at(1);
-                if (vId1_1 != vId2_1 &&
-                    vId1_1 != vId2_2 &&
-                    vId1_2 != vId2_1 &&
-                    vId1_2 != vId2_2)
-                    continue;
-
-                coefficients.push_back(Trip(row, edge1.id, 1));
-                coefficients.push_back(Trip(row, edge2.id, -1));
-                b.push_back(0);
-                row++;
-            }
-        }
-    }
-
-    size_t col = mesh.E.size();
-//    std::cout << "Edge Length Row = " << row << std::endl;
-//    std::cout << "Edge Length Col = " << col << std::endl;
-//    std::cout << "numOfparallelEids = " << numOfparallelEids << std::endl;
-//    std::cout << "numOfconsecutiveEids = " << numOfconsecutiveEids << std::endl;
-
-    Eigen::SparseMatrix<float> A(row, col);
-    A.setFromTriplets(coefficients.begin(), coefficients.end());
-    Eigen::SparseMatrix<float> A_T = A.transpose();
-    Eigen::SparseMatrix<float> ATA = A_T * A;
-    //  MatrixXf ;
-    VectorXf X(col), B(row);
-    for (size_t i = 0; i < row; i++)
-        B(i) = b[i];
-
-    VectorXf ATB = A_T * B;
-    Eigen::SimplicialLDLT<SpMat> chol(ATA);
-    X = chol.solve(ATB);
-
-    // ------- Output File -----------
-//    std::ofstream ofs("iX.txt");
-//    //ofs << A;
-//    ofs << X;
-    // ------- ----------- -----------
-
+    if (!targetLengthSolver.IsBuilt())
+        targetLengthSolver.Build(true);
+    std::vector<double> X;
+    targetLengthSolver.Solve(avgMeshEdgeLength, X);
     for (size_t i = 0; i < mesh.E.size(); i++)
         mesh.E[i].length = X[i];
 
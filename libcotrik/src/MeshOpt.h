@@ -9,6 +9,9 @@
 #define MESH_OPT_H_
 
 #include "Mesh.h"
+#include "TargetLengthSolver.h"
+#include "DiagnosticsSink.h"
+#include "QualityTracker.h"
 
 #include <Eigen/Core>
 #include <Eigen/Eigen>
@@ -104,6 +107,12 @@ protected:
     std::vector<double> ESingularity;
     std::vector<double> EOrthogonality;
     std::vector<double> EStraightness;
+
+    TargetLengthSolver targetLengthSolver;  // built on the first ComputeMeshTargetLength()
+    QualityTracker qualityTracker;          // built by Run(), Optimize() evaluates only the cells of moved vertices
+
+public:
+    DiagnosticsSink diagnostics;    // MeshOpt.N every diagnostics.every iterations, off by default
 };
 
 bool IsInFace(const Mesh& mesh, const Edge& edge, const size_t vid1, const size_t vid2);
@@ -374,22 +374,38 @@ size_t GetMinScaledJacobian(const Mesh& mesh, double& MinScaledJacobian, std::ve
 }
 
 #include "verdict.h"
-size_t GetMinScaledJacobianVerdict(const Mesh& mesh, double& MinScaledJacobian, const double minSJ/* = 0.0*/)
+#include "ElementQuality.h"
+// scaled jacobian of every hex, the same values as v_hex_scaled_jacobian
+static void GetScaledJacobians(const Mesh& mesh, std::vector<double>& scaledJacobians)
 {
-    size_t numOfInvertedElements = 0;
-    double minScaledJacobian = 1;
+    const QualityContext context;
     const std::vector<Vertex>& V = mesh.V;
     const std::vector<Cell>& C = mesh.C;
-    double coordinates[8][3];
-    for (size_t i = 0; i < C.size(); i++) {
+    scaledJacobians.resize(C.size());
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)C.size(); i++) {
         const Cell& c = C[i];
+        double coordinates[8][3];
         for (size_t j = 0; j < 8; j++) {
             const Vertex& v = V[c.Vids[j]];
             coordinates[j][0] = v.x;
             coordinates[j][1] = v.y;
             coordinates[j][2] = v.z;
         }
-        double scaledJacobian = v_hex_scaled_jacobian(8, coordinates);
+        double values[QUALITY_METRIC_COUNT];
+        GetHexQuality(coordinates, QUALITY_BIT(QUALITY_SCALED_JACOBIAN), context, values);
+        scaledJacobians[i] = values[QUALITY_SCALED_JACOBIAN];
+    }
+}
+
+size_t GetMinScaledJacobianVerdict(const Mesh& mesh, double& MinScaledJacobian, const double minSJ/* = 0.0*/)
+{
+    size_t numOfInvertedElements = 0;
+    double minScaledJacobian = 1;
+    std::vector<double> scaledJacobians;
+    GetScaledJacobians(mesh, scaledJacobians);
+    for (size_t i = 0; i < scaledJacobians.size(); i++) {
+        double scaledJacobian = scaledJacobians[i];
         if (scaledJacobian > 1.01 || scaledJacobian < -1.01) scaledJacobian = -1.0;
         minScaledJacobian = minScaledJacobian < scaledJacobian ? minScaledJacobian : scaledJacobian;
         if (scaledJacobian < minSJ) {
@@ -442,88 +458,24 @@ double GetScaledJacobianQuad(const Mesh& mesh, size_t faceId) {
 size_t GetScaledJacobianVerdict(const Mesh& mesh, std::vector<double>& scaledJacobian, const double minSJ/* = 0.0*/)
 {
     size_t numOfInvertedElements = 0;
-    //AvgScaledJacobian = 0;
-    //double minScaledJacobian = 1;
-    scaledJacobian.resize(mesh.C.size());
-    const std::vector<Vertex>& V = mesh.V;
-    const std::vector<Cell>& C = mesh.C;
-    double coordinates[8][3];
-    for (size_t i = 0; i < C.size(); i++) {
-        const Cell& c = C[i];
-        for (size_t j = 0; j < 8; j++) {
-            const Vertex& v = V[c.Vids[j]];
-            coordinates[j][0] = v.x;
-            coordinates[j][1] = v.y;
-            coordinates[j][2] = v.z;
-        }
-        scaledJacobian[i] = v_hex_scaled_jacobian(8, coordinates);;
-        //double scaledJacobian = v_hex_scaled_jacobian(8, coordinates);
-        //minScaledJacobian = minScaledJacobian < scaledJacobian ? minScaledJacobian : scaledJacobian;
+    GetScaledJacobians(mesh, scaledJacobian);
+    for (size_t i = 0; i < scaledJacobian.size(); i++)
         if (scaledJacobian[i] < minSJ) {
             numOfInvertedElements++;
         }
-        //AvgScaledJacobian +=  scaledJacobian;
-    }
-    //MinScaledJacobian = minScaledJacobian;
-    //AvgScaledJacobian /= C.size();
 
     return numOfInvertedElements;
 }
 size_t GetScaledJacobianVerdict(const Mesh& mesh, double& MinScaledJacobian, double& AvgScaledJacobian, const double minSJ/* = 0.0*/)
 {
-    size_t numOfInvertedElements = 0;
-    AvgScaledJacobian = 0;
-    double minScaledJacobian = 1;
-    const std::vector<Vertex>& V = mesh.V;
-    const std::vector<Cell>& C = mesh.C;
-    double coordinates[8][3];
-    for (size_t i = 0; i < C.size(); i++) {
-        const Cell& c = C[i];
-        for (size_t j = 0; j < 8; j++) {
-            const Vertex& v = V[c.Vids[j]];
-            coordinates[j][0] = v.x;
-            coordinates[j][1] = v.y;
-            coordinates[j][2] = v.z;
-        }
-        double scaledJacobian = v_hex_scaled_jacobian(8, coordinates);
-        minScaledJacobian = minScaledJacobian < scaledJacobian ? minScaledJacobian : scaledJacobian;
-        if (scaledJacobian < minSJ) {
-            numOfInvertedElements++;
-        }
-        AvgScaledJacobian +=  scaledJacobian;
-    }
-    MinScaledJacobian = minScaledJacobian;
-    AvgScaledJacobian /= C.size();
-
-    return numOfInvertedElements;
+    std::vector<size_t> badCellIds;
+    return GetMinScaledJacobianVerdict(mesh, MinScaledJacobian, AvgScaledJacobian, badCellIds, minSJ);
 }
 
 size_t GetMinScaledJacobianVerdict(const Mesh& mesh, double& MinScaledJacobian, std::vector<size_t>& badCellIds, const double minSJ/* = 0.0*/)
 {
-    size_t numOfInvertedElements = 0;
-    badCellIds.clear();
-    double minScaledJacobian = 1;
-    const std::vector<Vertex>& V = mesh.V;
-    const std::vector<Cell>& C = mesh.C;
-    double coordinates[8][3];
-    for (size_t i = 0; i < C.size(); i++) {
-        const Cell& c = C[i];
-        for (size_t j = 0; j < 8; j++) {
-            const Vertex& v = V[c.Vids[j]];
-            coordinates[j][0] = v.x;
-            coordinates[j][1] = v.y;
-            coordinates[j][2] = v.z;
-        }
-        double scaledJacobian = v_hex_scaled_jacobian(8, coordinates);
-        minScaledJacobian = minScaledJacobian < scaledJacobian ? minScaledJacobian : scaledJacobian;
-        if (scaledJacobian < minSJ) {
-            numOfInvertedElements++;
-            badCellIds.push_back(i);
-        }
-    }
-    MinScaledJacobian = minScaledJacobian;
-
-    return numOfInvertedElements;
+    double AvgScaledJacobian = 0;
+    return GetMinScaledJacobianVerdict(mesh, MinScaledJacobian, AvgScaledJacobian, badCellIds, minSJ);
 }
 
 size_t GetMinScaledJacobianVerdict(const Mesh& mesh, double& MinScaledJacobian, double& AvgScaledJacobian, std::vector<size_t>& badCellIds, const double minSJ/* = 0.0*/)
@@ -532,18 +484,10 @@ size_t GetMinScaledJacobianVerdict(const Mesh& mesh, double& MinScaledJacobian,
     AvgScaledJacobian = 0;
     badCellIds.clear();
     double minScaledJacobian = 1;
-    const std::vector<Vertex>& V = mesh.V;
-    const std::vector<Cell>& C = mesh.C;
-    double coordinates[8][3];
-    for (size_t i = 0; i < C.size(); i++) {
-        const Cell& c = C[i];
-        for (size_t j = 0; j < 8; j++) {
-            const Vertex& v = V[c.Vids[j]];
-            coordinates[j][0] = v.x;
-            coordinates[j][1] = v.y;
-            coordinates[j][2] = v.z;
-        }
-        double scaledJacobian = v_hex_scaled_jacobian(8, coordinates);
+    std::vector<double> scaledJacobians;
+    GetScaledJacobians(mesh, scaledJacobians);
+    for (size_t i = 0; i < scaledJacobians.size(); i++) {
+        const double scaledJacobian = scaledJacobians[i];
         minScaledJacobian = minScaledJacobian < scaledJacobian ? minScaledJacobian : scaledJacobian;
         if (scaledJacobian < minSJ) {
             numOfInvertedElements++;
@@ -552,7 +496,7 @@ size_t GetMinScaledJacobianVerdict(const Mesh& mesh, double& MinScaledJacobian,
         AvgScaledJacobian +=  scaledJacobian;
     }
     MinScaledJacobian = minScaledJacobian;
-    AvgScaledJacobian /= C.size();
+    AvgScaledJacobian /= scaledJacobians.size();
 
     return numOfInvertedElements;
 }
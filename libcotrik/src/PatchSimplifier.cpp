@@ -9,7 +9,7 @@
 #include "DiagnalCollapseSimplifier.h"
 
 
-PatchSimplifier::PatchSimplifier(Mesh& mesh) : Simplifier(mesh) {
+PatchSimplifier::PatchSimplifier(Mesh& mesh) : Simplifier(mesh), pipeline(mesh) {
 
 }
 
@@ -26,14 +26,16 @@ void PatchSimplifier::Run() {
             if (!Simplify(iter)) break;
         }
         ++Simplifier::maxValence;
+        pipeline.Invalidate();
     }
 }
 
 bool PatchSimplifier::Simplify(int& iter) {
     std::set<size_t> canceledFids;
     init();
+    pipeline.Update();
     if (iter == 0 && featurePreserved) get_feature();
-    if (iter == 0)
+    if (iter == 0 && Simplifier::writeFile)
     {
         auto eids = get_rotate_eids();
         MeshFileWriter writer(mesh, "rotate_eids.vtk");
@@ -46,40 +48,45 @@ bool PatchSimplifier::Simplify(int& iter) {
     }
 
     // Step 1 -- doublet removal
-    if (canceledFids.empty() && Simplifier::REMOVE_DOUBLET) {
+    if (canceledFids.empty() && Simplifier::REMOVE_DOUBLET && pipeline.IsNeeded(SimplifierPipeline::DOUBLET)) {
         DoubletSimplifier doubletSimplifier(mesh);
         doubletSimplifier.Run(canceledFids);
+        pipeline.SetResult(SimplifierPipeline::DOUBLET, !canceledFids.empty());
         if (!canceledFids.empty()) std::cout << "remove_doublet" << std::endl;
     }
     // Step 2 -- doublet splitting
-    if (canceledFids.empty() && Simplifier::SHEET_SPLIT) {
+    if (canceledFids.empty() && Simplifier::SHEET_SPLIT && pipeline.IsNeeded(SimplifierPipeline::SHEET_SPLIT)) {
         SheetSplitSimplifier sheetSplitSimplifier(mesh);
         sheetSplitSimplifier.Run(canceledFids);
+        pipeline.SetResult(SimplifierPipeline::SHEET_SPLIT, !canceledFids.empty());
         if (!canceledFids.empty()) std::cout << "remove_doublet from sheetSplitSimplifier" << std::endl;
     }
     // Step -- triplet splitting (optional)
-    if (canceledFids.empty() && Simplifier::TRIP) {
+    if (canceledFids.empty() && Simplifier::TRIP && pipeline.IsNeeded(SimplifierPipeline::TRIPLET)) {
         TriangleSimplifier triangleSimplifier(mesh);
         triangleSimplifier.Run(canceledFids);
+        pipeline.SetResult(SimplifierPipeline::TRIPLET, !canceledFids.empty());
         if (!canceledFids.empty()) std::cout << "collapse faces from TriangleSimplifier" << std::endl;
     }
     // Step 3 -- edge rotation
-    if (canceledFids.empty() && Simplifier::ROTATE) {
+    if (canceledFids.empty() && Simplifier::ROTATE && pipeline.IsNeeded(SimplifierPipeline::ROTATE)) {
         EdgeRotateSimplifier edgeRotateSimplifier(mesh);
         edgeRotateSimplifier.Run(canceledFids);
+        pipeline.SetResult(SimplifierPipeline::ROTATE, !canceledFids.empty());
         if (!canceledFids.empty()) std::cout << "rotate_edge" << std::endl;
     }
     static bool aligned = false;
-    if (canceledFids.empty() && !aligned) {
+    if (canceledFids.empty() && !aligned && Simplifier::writeFile) {
         aligned = true;
         std::cout << "writing rotate.vtk " << std::endl;
         MeshFileWriter writer(mesh, "rotate.vtk");
         writer.WriteFile();
     }
     // Step 4 -- singlet collapsing
-    if (canceledFids.empty()) {
+    if (canceledFids.empty() && pipeline.IsNeeded(SimplifierPipeline::SINGLET)) {
         DiagnalCollapseSimplifier diagnalCollapseSimplifier(mesh);
         diagnalCollapseSimplifier.Run3(canceledFids);
+        pipeline.SetResult(SimplifierPipeline::SINGLET, !canceledFids.empty());
         if (!canceledFids.empty()) std::cout << "singlet collapsing" << std::endl;
     }
     // Step 5 -- <separatrix splitting> and <separatrix splitting (optional)>
@@ -102,14 +109,16 @@ bool PatchSimplifier::Simplify(int& iter) {
     if (canceledFids.empty() && Simplifier::GLOBAL) {
         update(canceledFids);
         init();
+        pipeline.Update();
         SingleSheetSimplifier sheetSimplifier(mesh);
-        sheetSimplifier.Run(canceledFids);
+        sheetSimplifier.Run(canceledFids, true);
         if (!canceledFids.empty()) std::cout << "chord collapsing" << std::endl;
     }
     // Step 7 -- half separatrix collapsing
     if (canceledFids.empty() && Simplifier::HALF) {
         update(canceledFids);
         init();
+        pipeline.Update();
         BaseComplexQuad baseComplex(mesh);
         baseComplex.ExtractSingularVandE();
         baseComplex.BuildE();
@@ -117,9 +126,10 @@ bool PatchSimplifier::Simplify(int& iter) {
         if (!canceledFids.empty()) std::cout << "half_simplify\n";
     }
     // Step 8 -- diagonal collapsing
-    if (canceledFids.empty() && Simplifier::COLLAPSE_DIAGNAL) {
+    if (canceledFids.empty() && Simplifier::COLLAPSE_DIAGNAL && pipeline.IsNeeded(SimplifierPipeline::DIAGONAL)) {
         DiagnalCollapseSimplifier diagnalCollapseSimplifier(mesh);
         diagnalCollapseSimplifier.Run(canceledFids);
+        pipeline.SetResult(SimplifierPipeline::DIAGONAL, !canceledFids.empty());
         if (!canceledFids.empty()) std::cout << "collapse_diagnal" << std::endl;
     }
 
@@ -147,6 +157,7 @@ bool PatchSimplifier::Simplify(int& iter) {
         update(canceledFids);
         return false;
     }
+    pipeline.RecordEdit(canceledFids);
     update(canceledFids);
     if (Simplifier::writeFile)
     {
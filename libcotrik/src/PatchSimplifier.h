@@ -2,6 +2,8 @@
 #define PATCH_SIMPLIFIER_H
 
 #include "Simplifier.h"
+#include "SimplifierPipeline.h"
+
 class PatchSimplifier : public Simplifier {
 public:
 	PatchSimplifier(Mesh& mesh);
@@ -14,6 +16,8 @@ public:
 	void Run();
 	bool Simplify(int& iter);
 	bool CheckCorners();
+private:
+	SimplifierPipeline pipeline;
 };
 
 #endif // !PATCH_SIMPLIFIER_H
@@ -0,0 +1,212 @@
+/*
+ * PointLocator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "PointLocator.h"
+#include <algorithm>
+#include <queue>
+#include <float.h>
+#include <math.h>
+
+PointLocator::PointLocator(const Mesh& mesh)
+: mesh(mesh)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+PointLocator::~PointLocator()
+{
+    // TODO Auto-generated destructor stub
+}
+
+void PointLocator::Build(const bool boundaryOnly)
+{
+    std::vector<size_t> vids;
+    vids.reserve(mesh.V.size());
+    for (auto& v : mesh.V)
+        if (!boundaryOnly || v.isBoundary)
+            vids.push_back(v.id);
+
+    glm::dvec3 minP(DBL_MAX, DBL_MAX, DBL_MAX);
+    glm::dvec3 maxP(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+    for (auto vid : vids) {
+        const Vertex& v = mesh.V.at(vid);
+        for (int j = 0; j < 3; j++) {
+            minP[j] = std::min(minP[j], v[j]);
+            maxP[j] = std::max(maxP[j], v[j]);
+        }
+    }
+    const size_t n = std::max(vids.size(), (size_t)1);
+    if (vids.empty()) minP = maxP = glm::dvec3(0, 0, 0);
+    origin = minP;
+
+    // choose the cell length so that a cell holds a few points: boundary vertices lie on a surface,
+    // so size by the box area, but never allocate more than 8 cells per point
+    const glm::dvec3 extent = maxP - minP;
+    const double maxExtent = std::max(extent.x, std::max(extent.y, extent.z));
+    double e[3];
+    size_t d = 0;
+    for (int j = 0; j < 3; j++)
+        if (extent[j] > 1e-9 * maxExtent) e[d++] = extent[j];
+    if (d == 0) cellLength = 1.0;
+    else if (d == 1) cellLength = e[0] / n;
+    else if (d == 2) cellLength = sqrt(e[0] * e[1] / n);
+    else cellLength = std::max(sqrt(2.0 * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]) / n), cbrt(e[0] * e[1] * e[2] / (8 * n)));
+    size_t numOfCells = 1;
+    for (int j = 0; j < 3; j++) {
+        dims[j] = std::max((size_t)ceil(extent[j] / cellLength), (size_t)1);
+        numOfCells *= dims[j];
+    }
+
+    // counting sort of the points into the cells
+    cellOffsets.assign(numOfCells + 1, 0);
+    std::vector<size_t> cellIds(vids.size());
+    for (size_t i = 0; i < vids.size(); i++) {
+        const Vertex& v = mesh.V.at(vids[i]);
+        cellIds[i] = GetCellIndex(v.x, 0) + dims[0] * (GetCellIndex(v.y, 1) + dims[1] * GetCellIndex(v.z, 2));
+        cellOffsets[cellIds[i] + 1]++;
+    }
+    for (size_t i = 0; i < numOfCells; i++)
+        cellOffsets[i + 1] += cellOffsets[i];
+    std::vector<size_t> cursor(cellOffsets.begin(), cellOffsets.end() - 1);
+    cellVids.resize(vids.size());
+    for (size_t i = 0; i < vids.size(); i++)
+        cellVids[cursor[cellIds[i]]++] = vids[i];
+
+    X.resize(cellVids.size());
+    Y.resize(cellVids.size());
+    Z.resize(cellVids.size());
+    for (size_t i = 0; i < cellVids.size(); i++) {
+        const Vertex& v = mesh.V.at(cellVids[i]);
+        X[i] = v.x;
+        Y[i] = v.y;
+        Z[i] = v.z;
+    }
+}
+
+size_t PointLocator::GetCellIndex(const double x, const size_t axis) const
+{
+    const double t = (x - origin[axis]) / cellLength;
+    if (!(t > 0)) return 0;
+    return std::min((size_t)t, dims[axis] - 1);
+}
+
+// distance from p to the nearest cell that lies outside the box [lo, hi], DBL_MAX if the box covers the grid
+double PointLocator::GetLowerBound(const glm::dvec3& p, const size_t lo[3], const size_t hi[3]) const
+{
+    double bound = DBL_MAX;
+    for (int j = 0; j < 3; j++) {
+        if (lo[j] > 0) bound = std::min(bound, std::max(p[j] - (origin[j] + lo[j] * cellLength), 0.0));
+        if (hi[j] + 1 < dims[j]) bound = std::min(bound, std::max(origin[j] + (hi[j] + 1) * cellLength - p[j], 0.0));
+    }
+    return bound;
+}
+
+// visits the cells at Chebyshev distance r from cell c, lo/hi receive the clamped box of radius r
+template<typename Visitor>
+void PointLocator::VisitShell(const size_t c[3], const size_t r, const Visitor& visitor, size_t lo[3], size_t hi[3]) const
+{
+    for (int j = 0; j < 3; j++) {
+        lo[j] = c[j] > r ? c[j] - r : 0;
+        hi[j] = std::min(c[j] + r, dims[j] - 1);
+    }
+    for (size_t z = lo[2]; z <= hi[2]; z++) {
+        const bool zFace = z + r == c[2] || z == c[2] + r;
+        for (size_t y = lo[1]; y <= hi[1]; y++) {
+            const size_t row = dims[0] * (y + dims[1] * z);
+            if (zFace || y + r == c[1] || y == c[1] + r) {
+                for (size_t x = lo[0]; x <= hi[0]; x++)
+                    visitor(row + x);
+            } else {
+                if (c[0] >= r) visitor(row + c[0] - r);
+                if (r > 0 && c[0] + r < dims[0]) visitor(row + c[0] + r);
+            }
+        }
+    }
+}
+
+size_t PointLocator::GetClosestVertexId(const glm::dvec3& p) const
+{
+    if (cellVids.empty()) return MAXID;
+    const size_t c[3] = {GetCellIndex(p.x, 0), GetCellIndex(p.y, 1), GetCellIndex(p.z, 2)};
+    size_t lo[3], hi[3];
+    size_t bestId = MAXID;
+    double bestDistance = DBL_MAX;
+    auto visitor = [&](const size_t cell) {
+        for (size_t i = cellOffsets[cell]; i < cellOffsets[cell + 1]; i++) {
+            const double dx = X[i] - p.x, dy = Y[i] - p.y, dz = Z[i] - p.z;
+            const double d = dx * dx + dy * dy + dz * dz;
+            if (d < bestDistance || (d == bestDistance && cellVids[i] < bestId)) {
+                bestDistance = d;
+                bestId = cellVids[i];
+            }
+        }
+    };
+    for (size_t r = 0; ; r++) {
+        VisitShell(c, r, visitor, lo, hi);
+        const double bound = GetLowerBound(p, lo, hi);
+        if (bound == DBL_MAX || (bestId != MAXID && bestDistance < bound * bound)) break;
+    }
+    return bestId;
+}
+
+// batch query, skipped (non-boundary) points get MAXID
+void PointLocator::GetClosestVertexIds(const std::vector<Vertex>& points, std::vector<size_t>& vids, const bool boundaryPointsOnly) const
+{
+    vids.resize(points.size());
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)points.size(); i++)
+        vids[i] = !boundaryPointsOnly || points[i].isBoundary ? GetClosestVertexId(points[i]) : MAXID;
+}
+
+std::vector<size_t> PointLocator::GetKClosestVertexIds(const glm::dvec3& p, const size_t k) const
+{
+    std::vector<size_t> res;
+    if (cellVids.empty() || k == 0) return res;
+    const size_t c[3] = {GetCellIndex(p.x, 0), GetCellIndex(p.y, 1), GetCellIndex(p.z, 2)};
+    size_t lo[3], hi[3];
+    std::priority_queue<std::pair<double, size_t>> heap;  // max-heap of the k closest so far
+    auto visitor = [&](const size_t cell) {
+        for (size_t i = cellOffsets[cell]; i < cellOffsets[cell + 1]; i++) {
+            const double dx = X[i] - p.x, dy = Y[i] - p.y, dz = Z[i] - p.z;
+            const std::pair<double, size_t> item(dx * dx + dy * dy + dz * dz, cellVids[i]);
+            if (heap.size() < k) heap.push(item);
+            else if (item < heap.top()) {
+                heap.pop();
+                heap.push(item);
+            }
+        }
+    };
+    for (size_t r = 0; ; r++) {
+        VisitShell(c, r, visitor, lo, hi);
+        const double bound = GetLowerBound(p, lo, hi);
+        if (bound == DBL_MAX || (heap.size() == k && heap.top().first < bound * bound)) break;
+    }
+    res.resize(heap.size());
+    for (size_t i = res.size(); i-- > 0; heap.pop())
+        res[i] = heap.top().second;
+    return res;
+}
+
+std::vector<size_t> PointLocator::GetVertexIdsInRadius(const glm::dvec3& p, const double radius) const
+{
+    std::vector<size_t> res;
+    if (cellVids.empty() || radius < 0) return res;
+    const size_t lo[3] = {GetCellIndex(p.x - radius, 0), GetCellIndex(p.y - radius, 1), GetCellIndex(p.z - radius, 2)};
+    const size_t hi[3] = {GetCellIndex(p.x + radius, 0), GetCellIndex(p.y + radius, 1), GetCellIndex(p.z + radius, 2)};
+    const double r2 = radius * radius;
+    for (size_t z = lo[2]; z <= hi[2]; z++)
+        for (size_t y = lo[1]; y <= hi[1]; y++) {
+            const size_t row = dims[0] * (y + dims[1] * z);
+            for (size_t i = cellOffsets[row + lo[0]]; i < cellOffsets[row + hi[0] + 1]; i++) {
+                const double dx = X[i] - p.x, dy = Y[i] - p.y, dz = Z[i] - p.z;
+                if (dx * dx + dy * dy + dz * dz <= r2) res.push_back(cellVids[i]);
+            }
+        }
+    std::sort(res.begin(), res.end());
+    return res;
+}
@@ -0,0 +1,49 @@
+/*
+ * PointLocator.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_POINTLOCATOR_H_
+#define LIBCOTRIK_SRC_POINTLOCATOR_H_
+
+#include "Mesh.h"
+
+// Uniform grid hash over (boundary) vertices of a mesh, answers closest, k-closest
+// and radius queries without scanning all vertices.
+class PointLocator
+{
+public:
+    PointLocator(const Mesh& mesh);
+    virtual ~PointLocator();
+private:
+    PointLocator();
+    PointLocator(const PointLocator&);
+    PointLocator& operator = (const PointLocator&);
+public:
+    void Build(const bool boundaryOnly = true);
+    size_t GetClosestVertexId(const glm::dvec3& p) const;
+    void GetClosestVertexIds(const std::vector<Vertex>& points, std::vector<size_t>& vids, const bool boundaryPointsOnly = false) const;
+    std::vector<size_t> GetKClosestVertexIds(const glm::dvec3& p, const size_t k) const;
+    std::vector<size_t> GetVertexIdsInRadius(const glm::dvec3& p, const double radius) const;
+
+private:
+    size_t GetCellIndex(const double x, const size_t axis) const;
+    double GetLowerBound(const glm::dvec3& p, const size_t lo[3], const size_t hi[3]) const;
+    template<typename Visitor>
+    void VisitShell(const size_t c[3], const size_t r, const Visitor& visitor, size_t lo[3], size_t hi[3]) const;
+
+private:
+    const Mesh& mesh;
+    glm::dvec3 origin;
+    double cellLength = 1.0;
+    size_t dims[3] = {1, 1, 1};
+    std::vector<size_t> cellOffsets;    // CSR over grid cells
+    std::vector<size_t> cellVids;
+    std::vector<double> X;              // coordinates in cellVids order
+    std::vector<double> Y;
+    std::vector<double> Z;
+};
+
+#endif /* LIBCOTRIK_SRC_POINTLOCATOR_H_ */
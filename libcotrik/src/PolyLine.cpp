@@ -80,7 +80,7 @@ void PolyLines::BuildFrom(const Mesh& mesh)
 void PolyLines::Build()
 {
     size_t polylineId = 0;
-    std::vector<size_t> visitedFrameEdgeIds;
+    std::vector<bool> visitedFrameEdges(framefield.frameEdges.size(), false);
     std::vector<size_t> edgesLabels(framefield.frameEdges.size(), MAXID);
     for (size_t i = 0; i < framefield.frameEdges.size(); i++){
         const size_t startFrameEdgeId = framefield.frameEdges.at(i).id;
@@ -91,8 +91,8 @@ void PolyLines::Build()
             const size_t startFrameNodeId = frameNode1.isBoundary ? frameNode1.id : frameNode2.id;
             for (size_t j = 0; j < frameNode.N_Eids.size(); j++){
                 const size_t startFrameEdgeId = frameNode.N_Eids.at(j);
-                if (!Util::Find(visitedFrameEdgeIds, startFrameEdgeId)){
-                    visitedFrameEdgeIds.push_back(startFrameEdgeId);
+                if (!visitedFrameEdges.at(startFrameEdgeId)){
+                    visitedFrameEdges.at(startFrameEdgeId) = true;
                     PolyLine polyline;
                     polyline.id = polylineId++;
                     const size_t endFrameEdgeId = polyline.BuildFrom(mesh, framefield, startFrameNodeId, startFrameEdgeId);
@@ -103,8 +103,8 @@ void PolyLines::Build()
                     for (size_t k = 0; k < polyline.Eids.size(); k++)
                         edgesLabels.at(polyline.Eids.at(k)) = polyline.id;
                     polyLines.push_back(polyline);
-                    if (!Util::Find(visitedFrameEdgeIds, endFrameEdgeId)){
-                        visitedFrameEdgeIds.push_back(endFrameEdgeId);
+                    if (!visitedFrameEdges.at(endFrameEdgeId)){
+                        visitedFrameEdges.at(endFrameEdgeId) = true;
                     }
                 }
             }
@@ -121,8 +121,8 @@ void PolyLines::Build()
             //for (size_t j = 0; j < frameNode.N_Eids.size(); j++)
             {
                 //const size_t startFrameEdgeId = frameNode.N_Eids.at(j);
-                if (!Util::Find(visitedFrameEdgeIds, startFrameEdgeId)){
-                    visitedFrameEdgeIds.push_back(startFrameEdgeId);
+                if (!visitedFrameEdges.at(startFrameEdgeId)){
+                    visitedFrameEdges.at(startFrameEdgeId) = true;
                     PolyLine polyline;
                     polyline.id = polylineId++;
                     const size_t endFrameEdgeId = polyline.BuildFrom(mesh, framefield, startFrameNodeId, startFrameEdgeId);
@@ -130,8 +130,8 @@ void PolyLines::Build()
                     for (size_t k = 0; k < polyline.Eids.size(); k++)
                         edgesLabels.at(polyline.Eids.at(k)) = polyline.id;
                     polyLines.push_back(polyline);
-                    if (!Util::Find(visitedFrameEdgeIds, endFrameEdgeId)){
-                        visitedFrameEdgeIds.push_back(endFrameEdgeId);
+                    if (!visitedFrameEdges.at(endFrameEdgeId)){
+                        visitedFrameEdges.at(endFrameEdgeId) = true;
                     }
                 }
             }
@@ -0,0 +1,160 @@
+/*
+ * QualityTracker.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "QualityTracker.h"
+#include "ElementQuality.h"
+#include <algorithm>
+
+QualityTracker::QualityTracker(const Mesh& mesh)
+: mesh(mesh)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+QualityTracker::~QualityTracker()
+{
+    // TODO Auto-generated destructor stub
+}
+
+double QualityTracker::Evaluate(const size_t cellId) const
+{
+    static const QualityContext context;
+    const Cell& c = mesh.C[cellId];
+    double coordinates[8][3];
+    const size_t n = mesh.m_cellType == TETRAHEDRA ? 4 : 8;
+    for (size_t j = 0; j < n; j++) {
+        const Vertex& v = mesh.V[c.Vids[j]];
+        coordinates[j][0] = v.x;
+        coordinates[j][1] = v.y;
+        coordinates[j][2] = v.z;
+    }
+    double values[QUALITY_METRIC_COUNT];
+    if (n == 4) GetTetQuality(coordinates, QUALITY_BIT(QUALITY_SCALED_JACOBIAN), context, values);
+    else GetHexQuality(coordinates, QUALITY_BIT(QUALITY_SCALED_JACOBIAN), context, values);
+    const double scaledJacobian = values[QUALITY_SCALED_JACOBIAN];
+    // degenerate cells come back as VERDICT_DBL_MAX, count them as inverted like GetMinScaledJacobianVerdict
+    if (scaledJacobian > 1.01 || scaledJacobian < -1.01) return -1.0;
+    return scaledJacobian;
+}
+
+// ties go to the smaller cell id, so the tree does not depend on the order of updates
+size_t QualityTracker::GetMinCellId(const size_t a, const size_t b) const
+{
+    if (a == MAXID) return b;
+    if (b == MAXID) return a;
+    if (scaledJacobians[b] < scaledJacobians[a]) return b;
+    if (scaledJacobians[a] < scaledJacobians[b]) return a;
+    return a < b ? a : b;
+}
+
+void QualityTracker::Build(const double minSJ/* = 0.0*/)
+{
+    this->minSJ = minSJ;
+    const size_t numOfCells = mesh.C.size();
+    scaledJacobians.resize(numOfCells);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfCells; i++)
+        scaledJacobians[i] = Evaluate(i);
+
+    numOfLeaves = 1;
+    while (numOfLeaves < numOfCells) numOfLeaves <<= 1;
+    tree.assign(2 * numOfLeaves, MAXID);
+    numOfInvertedElements = 0;
+    for (size_t i = 0; i < numOfCells; i++) {
+        tree[numOfLeaves + i] = i;
+        if (scaledJacobians[i] < minSJ) numOfInvertedElements++;
+    }
+    for (size_t node = numOfLeaves - 1; node > 0; node--)
+        tree[node] = GetMinCellId(tree[2 * node], tree[2 * node + 1]);
+}
+
+void QualityTracker::UpdateVertices(const std::vector<size_t>& vids)
+{
+    std::vector<size_t> cellIds;
+    for (auto vid : vids) {
+        const Vertex& v = mesh.V.at(vid);
+        cellIds.insert(cellIds.end(), v.N_Cids.begin(), v.N_Cids.end());
+    }
+    UpdateCells(cellIds);
+}
+
+void QualityTracker::UpdateCells(const std::vector<size_t>& cellIds)
+{
+    if (scaledJacobians.size() != mesh.C.size()) {
+        Build(minSJ);
+        return;
+    }
+    std::vector<size_t> ids = cellIds;
+    std::sort(ids.begin(), ids.end());
+    ids.resize(std::distance(ids.begin(), std::unique(ids.begin(), ids.end())));
+
+    std::vector<double> values(ids.size());
+#pragma omp parallel for if (ids.size() > 1024)
+    for (long long i = 0; i < (long long)ids.size(); i++)
+        values[i] = Evaluate(ids[i]);
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        const size_t cellId = ids[i];
+        const bool wasBad = scaledJacobians[cellId] < minSJ;
+        scaledJacobians[cellId] = values[i];
+        const bool isBad = values[i] < minSJ;
+        if (wasBad && !isBad) numOfInvertedElements--;
+        else if (!wasBad && isBad) numOfInvertedElements++;
+        UpdateLeaf(cellId);
+    }
+}
+
+void QualityTracker::UpdateLeaf(const size_t cellId)
+{
+    for (size_t node = (numOfLeaves + cellId) / 2; node > 0; node /= 2) {
+        const size_t minCellId = GetMinCellId(tree[2 * node], tree[2 * node + 1]);
+        if (tree[node] == minCellId && minCellId != cellId) break;
+        tree[node] = minCellId;
+    }
+}
+
+double QualityTracker::GetScaledJacobian(const size_t cellId) const
+{
+    return scaledJacobians.at(cellId);
+}
+
+double QualityTracker::GetMinScaledJacobian() const
+{
+    const size_t cellId = GetMinScaledJacobianCellId();
+    if (cellId == MAXID) return 1;
+    return scaledJacobians[cellId] < 1 ? scaledJacobians[cellId] : 1;
+}
+
+size_t QualityTracker::GetMinScaledJacobianCellId() const
+{
+    return tree.size() > 1 ? tree[1] : MAXID;
+}
+
+size_t QualityTracker::GetNumOfInvertedElements() const
+{
+    return numOfInvertedElements;
+}
+
+void QualityTracker::GetBadCellIds(std::vector<size_t>& badCellIds) const
+{
+    badCellIds.clear();
+    badCellIds.reserve(numOfInvertedElements);
+    if (tree.size() > 1) GetBadCellIds(1, badCellIds);
+}
+
+void QualityTracker::GetBadCellIds(const size_t node, std::vector<size_t>& badCellIds) const
+{
+    const size_t cellId = tree[node];
+    if (cellId == MAXID || !(scaledJacobians[cellId] < minSJ)) return;
+    if (node >= numOfLeaves) {
+        badCellIds.push_back(cellId);
+        return;
+    }
+    GetBadCellIds(2 * node, badCellIds);
+    GetBadCellIds(2 * node + 1, badCellIds);
+}
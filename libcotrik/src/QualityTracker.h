@@ -0,0 +1,55 @@
+/*
+ * QualityTracker.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_QUALITYTRACKER_H_
+#define LIBCOTRIK_SRC_QUALITYTRACKER_H_
+
+#include "Mesh.h"
+
+// Keeps the scaled jacobian of every cell of a hex or tet mesh and a min segment tree over them, so that after
+// a local operation only the cells around the moved vertices are evaluated again. The values, the minimum and
+// the bad cells are the ones of GetMinScaledJacobianVerdict(mesh, min, badCellIds, minSJ).
+class QualityTracker
+{
+public:
+    QualityTracker(const Mesh& mesh);
+    virtual ~QualityTracker();
+private:
+    QualityTracker();
+    QualityTracker(const QualityTracker&);
+    QualityTracker& operator = (const QualityTracker&);
+public:
+    // evaluates all cells, call again after the topology of mesh changed; updates build it if the number of cells changed
+    void Build(const double minSJ = 0.0);
+    // vertex connectivity (N_Cids) of mesh has to be built
+    void UpdateVertices(const std::vector<size_t>& vids);
+    void UpdateCells(const std::vector<size_t>& cellIds);
+
+    double GetScaledJacobian(const size_t cellId) const;
+    // never larger than 1, like GetMinScaledJacobianVerdict
+    double GetMinScaledJacobian() const;
+    size_t GetMinScaledJacobianCellId() const;
+    size_t GetNumOfInvertedElements() const;
+    // cells with scaled jacobian < minSJ in ascending order, O(k log C) for k bad cells
+    void GetBadCellIds(std::vector<size_t>& badCellIds) const;
+
+private:
+    double Evaluate(const size_t cellId) const;
+    size_t GetMinCellId(const size_t a, const size_t b) const;
+    void UpdateLeaf(const size_t cellId);
+    void GetBadCellIds(const size_t node, std::vector<size_t>& badCellIds) const;
+
+private:
+    const Mesh& mesh;
+    double minSJ = 0.0;
+    std::vector<double> scaledJacobians;
+    std::vector<size_t> tree;       // cell id of the minimum of each node, leaves start at numOfLeaves, MAXID for padding
+    size_t numOfLeaves = 0;
+    size_t numOfInvertedElements = 0;
+};
+
+#endif /* LIBCOTRIK_SRC_QUALITYTRACKER_H_ */
@@ -16,7 +16,7 @@ SheetSimplifier::~SheetSimplifier() {
     // TODO Auto-generated destructor stub
 }
 
-void SheetSimplifier::Run(std::set<size_t>& canceledFids) {
+void SheetSimplifier::Run(std::set<size_t>& canceledFids, const bool batch, const bool smallestFirst) {
     BaseComplexQuad baseComplex(mesh);
     baseComplex.Build();
 
@@ -24,8 +24,7 @@ void SheetSimplifier::Run(std::set<size_t>& canceledFids) {
     baseComplexSheets.Extract();
 
     //auto dualMesh = Refine(mesh, 0);
-    auto key_edgeId = get_key_edgeId(mesh);
-    auto key_faceId = get_key_faceId(mesh);
+    std::vector<SheetCollapse> sheets;
     for (int sheetId = 0; sheetId < baseComplexSheets.sheets_componentEdgeIds.size(); ++sheetId) {
         auto& componentEdgeIds = baseComplexSheets.sheets_componentEdgeIds.at(sheetId);
         bool multiple_edges = false;
@@ -51,22 +50,55 @@ void SheetSimplifier::Run(std::set<size_t>& canceledFids) {
 
         if (multiple_edges && !has_interior_singularities) continue;
 
-        std::map<size_t, size_t> canceledFaceIds;
-        std::set<size_t> canceledEdgeIds = GetCanceledEdgeIds(baseComplexSheets, canceledFaceIds, sheetId);
-
-        if (!CanCollapseWithFeaturePreserved(baseComplexSheets, canceledFaceIds, sheetId)) continue;
-        if (!can_collapse_vids_with_feature_preserved(canceledEdgeIds)) continue;
-        {
-            //std::string fname = std::string("before_global_collapsing.vtk");
-            //MeshFileWriter writer(mesh, fname.c_str());
-            //writer.WriteFile();
-            std::cout << "collapse sheet " << sheetId << "\n";
-            collapse_with_feature_preserved(key_edgeId, key_faceId, canceledFaceIds, canceledEdgeIds);
-            for (auto& item : canceledFaceIds)
-                canceledFids.insert(item.first);
-            break;
-        }
+        SheetCollapse sheet;
+        sheet.sheetId = sheetId;
+        sheet.canceledEdgeIds = GetCanceledEdgeIds(baseComplexSheets, sheet.canceledFaceIds, sheetId);
+
+        if (!CanCollapseWithFeaturePreserved(baseComplexSheets, sheet.canceledFaceIds, sheetId)) continue;
+        if (!can_collapse_vids_with_feature_preserved(sheet.canceledEdgeIds)) continue;
+        sheets.push_back(sheet);
+        if (!batch && !smallestFirst) break;
     }
+    CollapseSheets(sheets, batch, smallestFirst, canceledFids);
+}
+
+// without batch only the first sheet in the chosen order is collapsed
+void SheetSimplifier::CollapseSheets(std::vector<SheetCollapse>& sheets, const bool batch, const bool smallestFirst, std::set<size_t>& canceledFids) {
+    if (sheets.empty()) return;
+    if (smallestFirst)
+        std::stable_sort(sheets.begin(), sheets.end(), [](const SheetCollapse& a, const SheetCollapse& b) {
+            return a.canceledFaceIds.size() < b.canceledFaceIds.size();
+        });
+    if (!batch) sheets.resize(1);
+    auto key_edgeId = get_key_edgeId(mesh);
+    auto key_faceId = get_key_faceId(mesh);
+    std::vector<bool> usedFids(mesh.F.size(), false);
+    for (auto& sheet : sheets) {
+        if (!ReserveFootprint(sheet, usedFids)) continue;
+        //std::string fname = std::string("before_global_collapsing.vtk");
+        //MeshFileWriter writer(mesh, fname.c_str());
+        //writer.WriteFile();
+        std::cout << "collapse sheet " << sheet.sheetId << "\n";
+        collapse_with_feature_preserved(key_edgeId, key_faceId, sheet.canceledFaceIds, sheet.canceledEdgeIds);
+        for (auto& item : sheet.canceledFaceIds)
+            canceledFids.insert(item.first);
+    }
+}
+
+// The footprint of a sheet is every face around a vertex of its canceled faces, collapse_with_feature_preserved
+// only rewrites those faces and reads the vertices of the canceled ones. Sheets with disjoint footprints
+// therefore collapse independently of each other and can share one update.
+bool SheetSimplifier::ReserveFootprint(const SheetCollapse& sheet, std::vector<bool>& usedFids) const {
+    std::vector<size_t> fids;
+    for (auto& item : sheet.canceledFaceIds)
+        for (auto vid : mesh.F.at(item.first).Vids)
+            for (auto n_fid : mesh.V.at(vid).N_Fids) {
+                if (usedFids[n_fid]) return false;
+                fids.push_back(n_fid);
+            }
+    for (auto fid : fids)
+        usedFids[fid] = true;
+    return true;
 }
 
 
@@ -18,7 +18,9 @@ private:
     SheetSimplifier(const SheetSimplifier&);
     SheetSimplifier& operator = (const SheetSimplifier&);
 public:
-    void Run(std::set<size_t>& canceledFids);
+    // batch collapses every eligible sheet whose footprint does not touch an earlier one before the single update,
+    // smallestFirst visits the sheets in increasing number of canceled faces
+    void Run(std::set<size_t>& canceledFids, const bool batch = false, const bool smallestFirst = false);
     std::set<size_t> GetAllParallelEdgeIds(const size_t eid);
     std::set<size_t> GetCanceledEdgeIds(const BaseComplexSheetQuad& baseComplexSheets, std::map<size_t, size_t>& canceledFaceIds,
             size_t sheetId);
@@ -26,6 +28,15 @@ public:
             size_t sheetId);
     void CollapseWithFeaturePreserved(std::unordered_map<size_t, size_t>& key_edgeId, std::unordered_map<std::string, size_t>& key_faceId,
         std::map<size_t, size_t>& canceledFaceIds, std::set<size_t>& canceledEdgeIds);
+
+protected:
+    struct SheetCollapse {
+        size_t sheetId;
+        std::map<size_t, size_t> canceledFaceIds;
+        std::set<size_t> canceledEdgeIds;
+    };
+    void CollapseSheets(std::vector<SheetCollapse>& sheets, const bool batch, const bool smallestFirst, std::set<size_t>& canceledFids);
+    bool ReserveFootprint(const SheetCollapse& sheet, std::vector<bool>& usedFids) const;
 };
 
 #endif /* LIBCOTRIK_SRC_SHEETSIMPLIFIER_H_ */
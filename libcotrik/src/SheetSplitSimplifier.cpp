@@ -6,6 +6,7 @@
  */
 
 #include "SheetSplitSimplifier.h"
+#include "SortedIds.h"
 
 SheetSplitSimplifier::SheetSplitSimplifier(Mesh& mesh) : Simplifier(mesh) {
     // TODO Auto-generated constructor stub
@@ -166,11 +167,14 @@ void SheetSplitSimplifier::Insert3Faces(const std::map<size_t, size_t>& paralell
                 auto& v2 = mesh.V.at(vid);
                 auto eids = GetNeignborEids(v2, f);
                 if (eids.size() != 2) std::cerr << " Err in eids.size() v = " << vid << "\n";
-                std::set<size_t> eids_set(eids.begin(), eids.end());
-                std::set<size_t> veids_set(v.N_Eids.begin(), v.N_Eids.end());
-                auto intersections = Util::get_intersect(eids_set, veids_set);
+                SmallIds<2> eids_set(eids.begin(), eids.end());
+                SmallIds<8> veids_set(v.N_Eids.begin(), v.N_Eids.end());
+                SortIds(eids_set);
+                SortIds(veids_set);
+                SmallIds<2> intersections;
+                IntersectIds(eids_set, veids_set, intersections);
                 if (intersections.size() != 1) std::cerr << " Err in intersections.size() v = " << vid << "\n";
-                auto eid = *intersections.begin() == eids.front() ? eids.back() : eids.front();
+                auto eid = intersections.front() == eids.front() ? eids.back() : eids.front();
 
                 auto vid1 = find(paralellEid_newVid, eid, "paralellEid_newVid");
                 auto vid3 = v.id;
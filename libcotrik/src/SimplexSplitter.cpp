@@ -0,0 +1,226 @@
+/*
+ * SimplexSplitter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "SimplexSplitter.h"
+#include <algorithm>
+
+// local edges and faces in the order of the tet2hex hex corners
+static const size_t SplitTetEdges[6][2] = {{0, 1}, {1, 2}, {0, 2}, {2, 3}, {0, 3}, {1, 3}};
+static const size_t SplitTetFaces[4][3] = {{0, 1, 2}, {0, 2, 3}, {0, 1, 3}, {1, 2, 3}};
+static const size_t SplitTetFaceEdges[4][3] = {{0, 1, 2}, {2, 3, 4}, {0, 5, 4}, {1, 3, 5}};
+static const size_t SplitTriEdges[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+
+SimplexSplitter::SimplexSplitter(const Mesh& mesh)
+: mesh(mesh)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+SimplexSplitter::~SimplexSplitter()
+{
+    // TODO Auto-generated destructor stub
+}
+
+void SimplexSplitter::NumberKeys(const std::vector<std::array<size_t, 3>>& keys, std::vector<size_t>& ids,
+        std::vector<size_t>& firstKeys, std::vector<size_t>& counts) const
+{
+    // counting sort of the keys on their smallest vertex id, equal keys always share a bucket
+    const size_t n = mesh.V.size();
+    std::vector<size_t> offsets(n + 1, 0);
+    for (const auto& key : keys)
+        offsets[key[0] + 1]++;
+    for (size_t i = 0; i < n; i++)
+        offsets[i + 1] += offsets[i];
+    std::vector<size_t> order(keys.size());
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t k = 0; k < keys.size(); k++)
+        order[cursor[keys[k][0]]++] = k;
+
+    // buckets hold a few dozen keys, sort and number each on its own
+    ids.resize(keys.size());
+    std::vector<size_t> numOfIds(n, 0);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (long long i = 0; i < (long long)n; i++) {
+        const auto begin = order.begin() + offsets[i], end = order.begin() + offsets[i + 1];
+        std::sort(begin, end, [&](const size_t a, const size_t b) {
+            return keys[a][1] < keys[b][1] || (keys[a][1] == keys[b][1] && keys[a][2] < keys[b][2]);
+        });
+        for (auto it = begin; it != end; ++it) {
+            if (it != begin && keys[*it] != keys[*(it - 1)]) numOfIds[i]++;
+            ids[*it] = numOfIds[i];
+        }
+        if (begin != end) numOfIds[i]++;
+    }
+    std::vector<size_t> idOffsets(n + 1, 0);
+    for (size_t i = 0; i < n; i++)
+        idOffsets[i + 1] = idOffsets[i] + numOfIds[i];
+    firstKeys.resize(idOffsets[n]);
+    counts.assign(idOffsets[n], 0);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (long long i = 0; i < (long long)n; i++)
+        for (size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+            const size_t k = order[j];
+            ids[k] += idOffsets[i];
+            if (counts[ids[k]]++ == 0) firstKeys[ids[k]] = k;
+        }
+}
+
+static std::array<size_t, 3> SortedKey(size_t a, size_t b, size_t c = MAXID)
+{
+    if (a > b) std::swap(a, b);
+    if (b > c) std::swap(b, c);
+    if (a > b) std::swap(a, b);
+    return std::array<size_t, 3>{{a, b, c}};
+}
+
+void SimplexSplitter::SplitTetToHex(Mesh& hexMesh) const
+{
+    const size_t numOfCells = mesh.C.size();
+    std::vector<std::array<size_t, 3>> edgeKeys(6 * numOfCells), faceKeys(4 * numOfCells);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfCells; i++) {
+        const auto& vids = mesh.C[i].Vids;
+        for (size_t j = 0; j < 6; j++)
+            edgeKeys[6 * i + j] = SortedKey(vids[SplitTetEdges[j][0]], vids[SplitTetEdges[j][1]]);
+        for (size_t j = 0; j < 4; j++)
+            faceKeys[4 * i + j] = SortedKey(vids[SplitTetFaces[j][0]], vids[SplitTetFaces[j][1]], vids[SplitTetFaces[j][2]]);
+    }
+    std::vector<size_t> cellEids, firstEdgeKeys, edgeCounts;
+    std::vector<size_t> cellFids, firstFaceKeys, faceCounts;
+    NumberKeys(edgeKeys, cellEids, firstEdgeKeys, edgeCounts);
+    NumberKeys(faceKeys, cellFids, firstFaceKeys, faceCounts);
+    const size_t numOfVertices = mesh.V.size();
+    const size_t numOfEdges = edgeCounts.size();
+    const size_t numOfFaces = faceCounts.size();
+
+    // a face of only one tet is on the boundary, and so are its edges and vertices
+    std::vector<char> isBoundaryV(numOfVertices, 0), isBoundaryE(numOfEdges, 0);
+    for (size_t i = 0; i < numOfCells; i++)
+        for (size_t j = 0; j < 4; j++) {
+            if (faceCounts[cellFids[4 * i + j]] != 1) continue;
+            for (size_t k = 0; k < 3; k++) {
+                isBoundaryV[mesh.C[i].Vids[SplitTetFaces[j][k]]] = 1;
+                isBoundaryE[cellEids[6 * i + SplitTetFaceEdges[j][k]]] = 1;
+            }
+        }
+
+    const size_t edgeBase = numOfVertices;
+    const size_t faceBase = edgeBase + numOfEdges;
+    const size_t cellBase = faceBase + numOfFaces;
+    hexMesh.V.clear();
+    hexMesh.V.resize(cellBase + numOfCells);
+    hexMesh.C.clear();
+    hexMesh.C.resize(4 * numOfCells);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfVertices; i++) {
+        hexMesh.V[i] = mesh.V[i].xyz();
+        hexMesh.V[i].isBoundary = isBoundaryV[i];
+    }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfEdges; i++) {
+        const auto& key = edgeKeys[firstEdgeKeys[i]];
+        hexMesh.V[edgeBase + i] = 0.5 * (mesh.V[key[0]].xyz() + mesh.V[key[1]].xyz());
+        hexMesh.V[edgeBase + i].isBoundary = isBoundaryE[i];
+    }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfFaces; i++) {
+        const auto& key = faceKeys[firstFaceKeys[i]];
+        hexMesh.V[faceBase + i] = (mesh.V[key[0]].xyz() + mesh.V[key[1]].xyz() + mesh.V[key[2]].xyz()) / 3.0;
+        hexMesh.V[faceBase + i].isBoundary = faceCounts[i] == 1;
+    }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfCells; i++) {
+        const auto& vids = mesh.C[i].Vids;
+        const size_t* eids = cellEids.data() + 6 * i;
+        const size_t* fids = cellFids.data() + 4 * i;
+        glm::dvec3 center(0, 0, 0);
+        for (size_t j = 0; j < 4; j++)
+            center += mesh.V[vids[j]].xyz();
+        hexMesh.V[cellBase + i] = 0.25 * center;
+        hexMesh.V[cellBase + i].isBoundary = false;
+
+        const size_t v[15] = {vids[0], vids[1], vids[2], vids[3],
+                edgeBase + eids[0], edgeBase + eids[1], edgeBase + eids[2], edgeBase + eids[3], edgeBase + eids[4], edgeBase + eids[5],
+                faceBase + fids[0], faceBase + fids[1], faceBase + fids[2], faceBase + fids[3],
+                cellBase + i};
+        hexMesh.C[4 * i + 0].Vids = {v[0], v[8], v[12], v[4], v[6], v[11], v[14], v[10]};
+        hexMesh.C[4 * i + 1].Vids = {v[1], v[5], v[10], v[4], v[9], v[13], v[14], v[12]};
+        hexMesh.C[4 * i + 2].Vids = {v[2], v[5], v[13], v[7], v[6], v[10], v[14], v[11]};
+        hexMesh.C[4 * i + 3].Vids = {v[3], v[8], v[11], v[7], v[9], v[12], v[14], v[13]};
+        for (size_t j = 0; j < 4; j++)
+            hexMesh.C[4 * i + j].id = 4 * i + j;
+    }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)hexMesh.V.size(); i++)
+        hexMesh.V[i].id = i;
+    hexMesh.m_cellType = HEXAHEDRA;
+}
+
+void SimplexSplitter::SplitTriToQuad(Mesh& quadMesh) const
+{
+    const size_t numOfCells = mesh.C.size();
+    std::vector<std::array<size_t, 3>> edgeKeys(3 * numOfCells);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfCells; i++) {
+        const auto& vids = mesh.C[i].Vids;
+        for (size_t j = 0; j < 3; j++)
+            edgeKeys[3 * i + j] = SortedKey(vids[SplitTriEdges[j][0]], vids[SplitTriEdges[j][1]]);
+    }
+    std::vector<size_t> cellEids, firstEdgeKeys, edgeCounts;
+    NumberKeys(edgeKeys, cellEids, firstEdgeKeys, edgeCounts);
+    const size_t numOfVertices = mesh.V.size();
+    const size_t numOfEdges = edgeCounts.size();
+
+    // an edge of only one triangle is on the boundary, and so are its vertices
+    std::vector<char> isBoundaryV(numOfVertices, 0);
+    for (size_t i = 0; i < numOfCells; i++)
+        for (size_t j = 0; j < 3; j++)
+            if (edgeCounts[cellEids[3 * i + j]] == 1) {
+                isBoundaryV[mesh.C[i].Vids[SplitTriEdges[j][0]]] = 1;
+                isBoundaryV[mesh.C[i].Vids[SplitTriEdges[j][1]]] = 1;
+            }
+
+    const size_t edgeBase = numOfVertices;
+    const size_t cellBase = edgeBase + numOfEdges;
+    quadMesh.V.clear();
+    quadMesh.V.resize(cellBase + numOfCells);
+    quadMesh.C.clear();
+    quadMesh.C.resize(3 * numOfCells);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfVertices; i++) {
+        quadMesh.V[i] = mesh.V[i].xyz();
+        quadMesh.V[i].isBoundary = isBoundaryV[i];
+    }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfEdges; i++) {
+        const auto& key = edgeKeys[firstEdgeKeys[i]];
+        quadMesh.V[edgeBase + i] = 0.5 * (mesh.V[key[0]].xyz() + mesh.V[key[1]].xyz());
+        quadMesh.V[edgeBase + i].isBoundary = edgeCounts[i] == 1;
+    }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)numOfCells; i++) {
+        const auto& vids = mesh.C[i].Vids;
+        const size_t* eids = cellEids.data() + 3 * i;
+        quadMesh.V[cellBase + i] = (mesh.V[vids[0]].xyz() + mesh.V[vids[1]].xyz() + mesh.V[vids[2]].xyz()) / 3.0;
+        quadMesh.V[cellBase + i].isBoundary = false;
+
+        // keeps the orientation of the triangle
+        const size_t e0 = edgeBase + eids[0], e1 = edgeBase + eids[1], e2 = edgeBase + eids[2];
+        quadMesh.C[3 * i + 0].Vids = {vids[0], e0, cellBase + i, e2};
+        quadMesh.C[3 * i + 1].Vids = {vids[1], e1, cellBase + i, e0};
+        quadMesh.C[3 * i + 2].Vids = {vids[2], e2, cellBase + i, e1};
+        for (size_t j = 0; j < 3; j++) {
+            quadMesh.C[3 * i + j].id = 3 * i + j;
+            quadMesh.C[3 * i + j].cellType = VTK_QUAD;
+        }
+    }
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)quadMesh.V.size(); i++)
+        quadMesh.V[i].id = i;
+    quadMesh.m_cellType = QUAD;
+}
@@ -0,0 +1,42 @@
+/*
+ * SimplexSplitter.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_SIMPLEXSPLITTER_H_
+#define LIBCOTRIK_SRC_SIMPLEXSPLITTER_H_
+
+#include "Mesh.h"
+#include <array>
+
+// Splits every tet into 4 hexes and every triangle into 3 quads through the edge midpoints,
+// face centers and cell centers. Only mesh.V and mesh.C are read: edges and faces are found from
+// the cell-local incidence by bucketing their sorted vertex ids on the smallest one, so no
+// connectivity needs to be built. The output vertices are the input vertices, then one per edge,
+// one per face (tets only) and one per cell; a new vertex is on the boundary iff its edge or face is.
+class SimplexSplitter
+{
+public:
+    SimplexSplitter(const Mesh& mesh);
+    virtual ~SimplexSplitter();
+private:
+    SimplexSplitter();
+    SimplexSplitter(const SimplexSplitter&);
+    SimplexSplitter& operator = (const SimplexSplitter&);
+public:
+    void SplitTetToHex(Mesh& hexMesh) const;
+    void SplitTriToQuad(Mesh& quadMesh) const;
+
+private:
+    // keys are sorted vertex ids, the last one MAXID for edges; ids[k] numbers the distinct keys,
+    // firstKeys[id] is one k with that id and counts[id] is how many cells share it
+    void NumberKeys(const std::vector<std::array<size_t, 3>>& keys, std::vector<size_t>& ids,
+            std::vector<size_t>& firstKeys, std::vector<size_t>& counts) const;
+
+private:
+    const Mesh& mesh;
+};
+
+#endif /* LIBCOTRIK_SRC_SIMPLEXSPLITTER_H_ */
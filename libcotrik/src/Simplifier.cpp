@@ -6,6 +6,7 @@
 */
 
 #include "Simplifier.h"
+#include "SortedIds.h"
 #include <unordered_set>
 
 const double PI = 3.1415926535;
@@ -1058,9 +1059,7 @@ void Simplifier::get_feature() {
 	{
 		mesh.LabelSharpEdges(true);
 		// for (auto& e : mesh.E) e.isSharpFeature = copy[e.id];
-		std::vector<FeatureLine> featureLines(mesh.numOfSharpEdges, FeatureLine(mesh));
-		for (size_t i = 0; i < mesh.numOfSharpEdges; i++)
-			featureLines.at(i).Extract(i);
+		std::vector<FeatureLine> featureLines = FeatureLine::ExtractAll(mesh);
 		WriteSharpEdgesVtk("FeatureLines.vtk", mesh, featureLines);
 	}
 	std::set<size_t> sharpEdgeVids;
@@ -2560,11 +2559,14 @@ std::set<size_t> Simplifier::get_rotate_eids(const Vertex& v, const std::vector<
 	for (auto& p : pairs) {
 		auto& f0 = mesh.F.at(fids.at(p[0]));
 		auto& f1 = mesh.F.at(fids.at(p[1]));
-		std::set<size_t> f0eids(f0.Eids.begin(), f0.Eids.end());
-		std::set<size_t> f1eids(f1.Eids.begin(), f1.Eids.end());
-		auto intersect_eids = Util::get_intersect(f0eids, f1eids);
+		SmallIds<4> f0eids(f0.Eids.begin(), f0.Eids.end());
+		SmallIds<4> f1eids(f1.Eids.begin(), f1.Eids.end());
+		SortIds(f0eids);
+		SortIds(f1eids);
+		SmallIds<4> intersect_eids;
+		IntersectIds(f0eids, f1eids, intersect_eids);
 		if (intersect_eids.size() == 1) {
-			auto& e = mesh.E.at(*intersect_eids.begin());
+			auto& e = mesh.E.at(intersect_eids.front());
 			res.insert(e.id);
 		}
 	}
@@ -2881,14 +2883,17 @@ void Simplifier::rotate(const Face& f0, const Face& f1, const Edge& e, std::set<
 }
 
 bool Simplifier::rotate(const Face& f0, const Face& f1, std::set<size_t>& canceledFids) {
-	std::set<size_t> f0eids(f0.Eids.begin(), f0.Eids.end());
-	std::set<size_t> f1eids(f1.Eids.begin(), f1.Eids.end());
-	auto intersect_eids = Util::get_intersect(f0eids, f1eids);
+	SmallIds<4> f0eids(f0.Eids.begin(), f0.Eids.end());
+	SmallIds<4> f1eids(f1.Eids.begin(), f1.Eids.end());
+	SortIds(f0eids);
+	SortIds(f1eids);
+	SmallIds<4> intersect_eids;
+	IntersectIds(f0eids, f1eids, intersect_eids);
 	if (intersect_eids.size() != 1) {
 		// std::cerr << "Err in auto eids = Util::get_intersect(f0eids, f1eids);\n";
 		return false;
 	}
-	auto& e = mesh.E.at(*intersect_eids.begin());
+	auto& e = mesh.E.at(intersect_eids.front());
 	if (!can_rotate(e)) return false;
 	rotate(f0, f1, e, canceledFids);
 	return true;
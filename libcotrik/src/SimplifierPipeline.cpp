@@ -0,0 +1,134 @@
+/*
+ * SimplifierPipeline.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "SimplifierPipeline.h"
+#include <algorithm>
+
+// seed tests are reached within two rings of faces from any vertex whose faces changed
+static const int NumOfRings = 2;
+
+SimplifierPipeline::SimplifierPipeline(const Mesh& mesh)
+: mesh(mesh)
+{
+    Invalidate();
+}
+
+SimplifierPipeline::~SimplifierPipeline()
+{
+    // TODO Auto-generated destructor stub
+}
+
+void SimplifierPipeline::Invalidate()
+{
+    for (int i = 0; i < NUM_OF_STAGES; i++) {
+        exhausted[i] = false;
+        editedVids[i].clear();
+    }
+}
+
+void SimplifierPipeline::Update()
+{
+    numOfFaces = mesh.F.size();
+    const std::vector<size_t>& refIds = mesh.m_refIds;    // new id -> id before CompressWithFeaturePreserved
+    if (refIds.size() != mesh.V.size()) return;
+    size_t maxRefId = 0;
+    for (auto refId : refIds)
+        maxRefId = std::max(maxRefId, refId);
+    std::vector<size_t> newIds(maxRefId + 1, MAXID);
+    for (size_t i = 0; i < refIds.size(); i++)
+        newIds[refIds[i]] = i;
+    for (auto& vids : editedVids) {
+        size_t k = 0;
+        for (auto vid : vids)
+            if (vid < newIds.size() && newIds[vid] != MAXID) vids[k++] = newIds[vid];
+        vids.resize(k);
+    }
+}
+
+void SimplifierPipeline::SetResult(const Stage stage, const bool found)
+{
+    exhausted[stage] = !found;
+    editedVids[stage].clear();
+}
+
+void SimplifierPipeline::RecordEdit(const std::set<size_t>& canceledFids)
+{
+    std::vector<size_t> vids;
+    for (auto fid : canceledFids) {
+        const auto& f = mesh.F.at(fid);
+        vids.insert(vids.end(), f.Vids.begin(), f.Vids.end());
+    }
+    // faces collapsed into their neighbors keep their ids, mesh.C still has them as of init()
+    const size_t n = std::min(numOfFaces, mesh.C.size());
+    for (size_t i = 0; i < n; i++)
+        if (mesh.F[i].Vids != mesh.C[i].Vids) {
+            vids.insert(vids.end(), mesh.F[i].Vids.begin(), mesh.F[i].Vids.end());
+            vids.insert(vids.end(), mesh.C[i].Vids.begin(), mesh.C[i].Vids.end());
+        }
+    for (size_t i = numOfFaces; i < mesh.F.size(); i++)
+        vids.insert(vids.end(), mesh.F[i].Vids.begin(), mesh.F[i].Vids.end());
+    std::sort(vids.begin(), vids.end());
+    vids.erase(std::unique(vids.begin(), vids.end()), vids.end());
+
+    for (int i = 0; i < NUM_OF_STAGES; i++) {
+        if (!exhausted[i]) continue;
+        auto& stageVids = editedVids[i];
+        stageVids.insert(stageVids.end(), vids.begin(), vids.end());
+        std::sort(stageVids.begin(), stageVids.end());
+        stageVids.erase(std::unique(stageVids.begin(), stageVids.end()), stageVids.end());
+    }
+}
+
+bool SimplifierPipeline::IsSeed(const Stage stage, const Vertex& v) const
+{
+    const size_t valence = v.N_Fids.size();
+    switch (stage) {
+    case DOUBLET: return (!v.isBoundary && valence == 2) || (v.isBoundary && valence == 1);
+    case SHEET_SPLIT: return (!v.isBoundary && valence == 2) || (valence == 1 && v.type == FEATURE);
+    case TRIPLET: return !v.isBoundary && valence == 3;
+    case ROTATE: return v.type == CORNER || v.isCorner || v.type == FEATURE;
+    case SINGLET: return v.type == FEATURE;
+    case DIAGONAL: return !v.isBoundary && valence == 3;
+    default: return true;
+    }
+}
+
+bool SimplifierPipeline::IsNeeded(const Stage stage)
+{
+    if (!exhausted[stage]) return true;
+    auto& vids = editedVids[stage];
+    if (vids.empty()) return false;
+
+    // grow the edited vertices by NumOfRings rings of faces and look for a seed
+    visited.resize(mesh.V.size(), 0);
+    std::vector<size_t> region;
+    for (auto vid : vids)
+        if (vid < mesh.V.size() && !visited[vid]) {
+            visited[vid] = 1;
+            region.push_back(vid);
+        }
+    size_t begin = 0;
+    for (int ring = 0; ring < NumOfRings; ring++) {
+        const size_t end = region.size();
+        for (size_t i = begin; i < end; i++)
+            for (auto fid : mesh.V[region[i]].N_Fids)
+                for (auto nvid : mesh.F.at(fid).Vids)
+                    if (!visited[nvid]) {
+                        visited[nvid] = 1;
+                        region.push_back(nvid);
+                    }
+        begin = end;
+    }
+    bool found = false;
+    for (auto vid : region) {
+        if (!found && IsSeed(stage, mesh.V[vid])) found = true;
+        visited[vid] = 0;
+    }
+    // no seed means the stage has nothing to do on the current mesh either
+    if (!found) vids.clear();
+    return found;
+}
@@ -0,0 +1,59 @@
+/*
+ * SimplifierPipeline.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_SIMPLIFIERPIPELINE_H_
+#define LIBCOTRIK_SRC_SIMPLIFIERPIPELINE_H_
+
+#include "Mesh.h"
+#include <set>
+
+// State of the local stages of PatchSimplifier kept across iterations. Each of them tests a few
+// rings of faces around a seed vertex, so once a stage has scanned the mesh without finding
+// anything it can only find something again near the faces edited since. The pipeline keeps,
+// for every such stage, the vertices of those faces through the renumbering of each init(), and
+// the stage is skipped without scanning the mesh while no vertex around them passes its seed test.
+class SimplifierPipeline
+{
+public:
+    enum Stage {
+        DOUBLET = 0,    // DoubletSimplifier
+        SHEET_SPLIT,    // SheetSplitSimplifier
+        TRIPLET,        // TriangleSimplifier
+        ROTATE,         // EdgeRotateSimplifier
+        SINGLET,        // DiagnalCollapseSimplifier::Run3
+        DIAGONAL,       // DiagnalCollapseSimplifier::Run
+        NUM_OF_STAGES
+    };
+    SimplifierPipeline(const Mesh& mesh);
+    virtual ~SimplifierPipeline();
+private:
+    SimplifierPipeline();
+    SimplifierPipeline(const SimplifierPipeline&);
+    SimplifierPipeline& operator = (const SimplifierPipeline&);
+public:
+    // after every init(), moves the kept vertices to the compressed ids
+    void Update();
+    // false if the stage is known to have nothing to do on the current mesh
+    bool IsNeeded(const Stage stage);
+    void SetResult(const Stage stage, const bool found);
+    // before update(canceledFids), collects the vertices of the canceled, changed and new faces
+    void RecordEdit(const std::set<size_t>& canceledFids);
+    // the parameters of the stages changed, all of them scan the whole mesh again
+    void Invalidate();
+
+private:
+    bool IsSeed(const Stage stage, const Vertex& v) const;
+
+private:
+    const Mesh& mesh;
+    size_t numOfFaces = 0;                          // faces after the last init(), new ones are appended
+    bool exhausted[NUM_OF_STAGES];                  // the last scan of the stage found nothing
+    std::vector<size_t> editedVids[NUM_OF_STAGES];  // vertices of the faces edited since that scan
+    std::vector<char> visited;
+};
+
+#endif /* LIBCOTRIK_SRC_SIMPLIFIERPIPELINE_H_ */
@@ -16,34 +16,34 @@ SingleSheetSimplifier::~SingleSheetSimplifier() {
     // TODO Auto-generated destructor stub
 }
 
-void SingleSheetSimplifier::Run(std::set<size_t>& canceledFids) {
-    auto key_edgeId = get_key_edgeId(mesh);
-    auto key_faceId = get_key_faceId(mesh);
+void SingleSheetSimplifier::Run(std::set<size_t>& canceledFids, const bool batch, const bool smallestFirst) {
     BaseComplexQuad baseComplex(mesh);
     baseComplex.Build();
 
     BaseComplexSheetQuad baseComplexSheets(baseComplex);
     baseComplexSheets.Extract();
+    std::vector<SheetCollapse> sheets;
+    std::vector<bool> inSheet(mesh.E.size(), false);  // the singular edges of a sheet all give that same sheet
     for (const auto& e : mesh.E) {
     //for (int i = mesh.E.size(); --i >=0;) {
         //const auto& e = mesh.E.at(i);
+        if (inSheet[e.id]) continue;
         auto& v0 = mesh.V.at(e.Vids[0]);
         auto& v1 = mesh.V.at(e.Vids[1]);
         if (!v0.isCorner && !v1.isCorner && (v0.N_Fids.size() == 3 || v1.N_Fids.size() == 3)/*(v0.isSingularity || v1.isSingularity)*/) {
-            std::map<size_t, size_t> canceledFaceIds;
+            SheetCollapse sheet;
+            sheet.sheetId = e.id;
             std::vector<size_t> linkEids(1, e.id);
-            std::set<size_t> canceledEdgeIds = GetCanceledEdgeIds(linkEids, canceledFaceIds);
-            if (!CanCollapseWithFeaturePreserved(baseComplexSheets, canceledFaceIds)) continue;
-            if (!can_collapse_vids_with_feature_preserved(canceledEdgeIds)) continue;
-            {
-                std::cout << "collapse sheet edge " << e.id << "(" << v0.id << "," << v1.id << ")" << "\n";
-                collapse_with_feature_preserved(key_edgeId, key_faceId, canceledFaceIds, canceledEdgeIds);
-                for (auto& item : canceledFaceIds)
-                    canceledFids.insert(item.first);
-                return;
-            }
+            sheet.canceledEdgeIds = GetCanceledEdgeIds(linkEids, sheet.canceledFaceIds);
+            for (auto eid : sheet.canceledEdgeIds)
+                inSheet[eid] = true;
+            if (!CanCollapseWithFeaturePreserved(baseComplexSheets, sheet.canceledFaceIds)) continue;
+            if (!can_collapse_vids_with_feature_preserved(sheet.canceledEdgeIds)) continue;
+            sheets.push_back(sheet);
+            if (!batch && !smallestFirst) break;
         }
     }
+    CollapseSheets(sheets, batch, smallestFirst, canceledFids);
 }
 
 std::set<size_t> SingleSheetSimplifier::GetCanceledEdgeIds(const std::vector<size_t>& linkEids, std::map<size_t, size_t>& canceledFaceIds) {
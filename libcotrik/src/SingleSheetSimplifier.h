@@ -18,7 +18,8 @@ private:
     SingleSheetSimplifier(const SingleSheetSimplifier&);
     SingleSheetSimplifier& operator = (const SingleSheetSimplifier&);
 public:
-    void Run(std::set<size_t>& canceledFids);
+    // batch and smallestFirst as in SheetSimplifier::Run, each sheet is the one through a singular edge
+    void Run(std::set<size_t>& canceledFids, const bool batch = false, const bool smallestFirst = false);
     std::set<size_t> GetCanceledEdgeIds(const std::vector<size_t>& linkEids, std::map<size_t, size_t>& canceledFaceIds);
     bool CanCollapseWithFeaturePreserved(const BaseComplexSheetQuad& baseComplexSheets, std::map<size_t, size_t>& canceledFaceIds);
 };
@@ -27,6 +27,9 @@ SingularityGraph::SingularityGraph(const SingularityGraph& rhs)
 , onTheSameFacesPatchSingularEdgeIds(rhs.onTheSameFacesPatchSingularEdgeIds)
 , regularSingularEdgeIds(rhs.regularSingularEdgeIds)
 , irregularSingularEdgeIds(rhs.irregularSingularEdgeIds)
+, meshVidToSingularVid(rhs.meshVidToSingularVid)
+, meshVidSingularEdgeOffsets(rhs.meshVidSingularEdgeOffsets)
+, meshVidSingularEdgeIds(rhs.meshVidSingularEdgeIds)
 {
 
 }
@@ -59,12 +62,14 @@ void SingularityGraph::Build()
 
 void SingularityGraph::BuildV()
 {
+    meshVidToSingularVid.assign(m_baseComplex.mesh.V.size(), MAXID);
     int id = 0;
     for (const auto& singularV : m_baseComplex.SingularityI.V) {
         SingularVertex v;
         v.id = id++;
         v.id_mesh = singularV.id_mesh;
         V.push_back(v);
+        if (meshVidToSingularVid[v.id_mesh] == MAXID) meshVidToSingularVid[v.id_mesh] = v.id;
     }
 }
 
@@ -78,6 +83,19 @@ void SingularityGraph::BuildE()
         e.eids_link = singularE.es_link;
         E.push_back(e);
     }
+
+    const size_t numOfMeshVertices = m_baseComplex.mesh.V.size();
+    meshVidSingularEdgeOffsets.assign(numOfMeshVertices + 1, 0);
+    for (const auto& e : E)
+        for (auto vid : e.vids_link)
+            ++meshVidSingularEdgeOffsets[vid + 1];
+    for (size_t i = 0; i < numOfMeshVertices; ++i)
+        meshVidSingularEdgeOffsets[i + 1] += meshVidSingularEdgeOffsets[i];
+    std::vector<size_t> cursor(meshVidSingularEdgeOffsets.begin(), meshVidSingularEdgeOffsets.end() - 1);
+    meshVidSingularEdgeIds.resize(meshVidSingularEdgeOffsets.back());
+    for (const auto& e : E)
+        for (auto vid : e.vids_link)
+            meshVidSingularEdgeIds[cursor[vid]++] = e.id;
 }
 
 void SingularityGraph::BuildV_V()
@@ -88,16 +106,8 @@ void SingularityGraph::BuildV_V()
         size_t singularVid1 = MAXID;
         size_t singularVid2 = MAXID;
         if (vid1 != vid2) {
-            for (const auto& singularV : V)
-                if (singularV.id_mesh == vid1) {
-                    singularVid1 = singularV.id;
-                    break;
-                }
-            for (const auto& singularV : V)
-                if (singularV.id_mesh == vid2) {
-                    singularVid2 = singularV.id;
-                    break;
-                }
+            singularVid1 = meshVidToSingularVid.at(vid1);
+            singularVid2 = meshVidToSingularVid.at(vid2);
             if (singularVid1 == MAXID || singularVid2 == MAXID) {
                 std::cerr << "singular Edge Id = " << singularE.id  << " vid1 = " << vid1 << " vid2 = " << vid2 << "\n";
 
@@ -132,16 +142,8 @@ void SingularityGraph::BuildV_E()
         size_t singularVid1 = MAXID;
         size_t singularVid2 = MAXID;
         if (vid1 != vid2) {
-            for (const auto& singularV : V)
-                if (singularV.id_mesh == vid1) {
-                    singularVid1 = singularV.id;
-                    break;
-                }
-            for (const auto& singularV : V)
-                if (singularV.id_mesh == vid2) {
-                    singularVid2 = singularV.id;
-                    break;
-                }
+            singularVid1 = meshVidToSingularVid.at(vid1);
+            singularVid2 = meshVidToSingularVid.at(vid2);
             if (singularVid1 == MAXID || singularVid2 == MAXID) {
                 std::cerr << "Error in void SingularityGraph::BuildV_E()\n";
                 continue;
@@ -160,57 +162,87 @@ void SingularityGraph::BuildV_E()
     }
 }
 
+typedef std::vector<std::pair<size_t, size_t>> RelationPairs;
+
+// sorts the (row, column) pairs into rows of unique column ids
+static void BuildRelation(const size_t n, const std::vector<RelationPairs>& pairs, std::vector<std::vector<size_t>>& relation)
+{
+    relation.assign(n, std::vector<size_t>());
+    for (const auto& localPairs : pairs)
+        for (const auto& p : localPairs)
+            relation[p.first].push_back(p.second);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)n; ++i) {
+        auto& row = relation[i];
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    }
+}
+
+static void AddSymmetricPair(RelationPairs& pairs, const size_t i, const size_t j)
+{
+    pairs.push_back(std::make_pair(i, j));
+    pairs.push_back(std::make_pair(j, i));
+}
+
+bool SingularityGraph::IsRelated(const std::vector<std::vector<size_t>>& relation, const size_t i, const size_t j)
+{
+    const auto& row = relation.at(i);
+    return std::binary_search(row.begin(), row.end(), j);
+}
+
+std::vector<std::vector<size_t>> SingularityGraph::GetDenseMatrix(const std::vector<std::vector<size_t>>& relation)
+{
+    std::vector<std::vector<size_t>> m(relation.size(), std::vector<size_t>(relation.size(), 0));
+    for (size_t i = 0; i < relation.size(); ++i)
+        for (auto j : relation[i])
+            m[i][j] = 1;
+    return m;
+}
+
 void SingularityGraph::BuildE_directlyLinkedSingularEdgeIds()
 {
-    directlyLinkedSingularEdgeIds.clear();
-    directlyLinkedSingularEdgeIds.resize(E.size(), std::vector<size_t>(E.size(), 0));
-    for (const auto& v : V) {
-        //auto neighborSingularEdgeIds = v.neighborSingularEdgeIds;
+    std::vector<RelationPairs> pairs(V.size());
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)V.size(); ++i) {
+        const auto& v = V[i];
         std::vector<std::vector<size_t>> com = Util::combine(v.neighborSingularEdgeIds.size(), 2);
-        for (const auto& c : com) {
-//            directlyLinkedSingularEdgeIds[v.neighborSingularEdgeIds[c[0]]].push_back(v.neighborSingularEdgeIds[c[1]]);
-//            directlyLinkedSingularEdgeIds[v.neighborSingularEdgeIds[c[1]]].push_back(v.neighborSingularEdgeIds[c[0]]);
-            directlyLinkedSingularEdgeIds[v.neighborSingularEdgeIds[c[0]]][v.neighborSingularEdgeIds[c[1]]] = 1;
-            directlyLinkedSingularEdgeIds[v.neighborSingularEdgeIds[c[1]]][v.neighborSingularEdgeIds[c[0]]] = 1;
-        }
+        for (const auto& c : com)
+            AddSymmetricPair(pairs[i], v.neighborSingularEdgeIds[c[0]], v.neighborSingularEdgeIds[c[1]]);
     }
+    BuildRelation(E.size(), pairs, directlyLinkedSingularEdgeIds);
 }
 
 void SingularityGraph::BuildE_linkedByOneComponentEdgeSingularEdgeIds()
 {
-    linkedByOneComponentEdgeSingularEdgeIds.clear();
-    linkedByOneComponentEdgeSingularEdgeIds.resize(E.size(), std::vector<size_t>(E.size(), 0));
-    for (auto& componentEdge : m_baseComplex.componentE) {
-        const auto& meshV = m_baseComplex.mesh.V;
-        if (meshV.at(componentEdge.vids_link.front()).isSingularity && meshV.at(componentEdge.vids_link.back()).isSingularity) {
-            std::vector<size_t> frontSingularEdgeIds;
-            std::vector<size_t> backSingularEdgeIds;
-            for (const auto& singularE : m_baseComplex.SingularityI.E)
-                for (auto vid: singularE.vs_link)
-                    if (vid == componentEdge.vids_link.front()) frontSingularEdgeIds.push_back(singularE.id);
-                    else if (vid == componentEdge.vids_link.back()) backSingularEdgeIds.push_back(singularE.id);
-
-            for (auto frontSingularEdgeId : frontSingularEdgeIds)
-                for (auto backSingularEdgeId : backSingularEdgeIds) {
-//                    linkedByOneComponentEdgeSingularEdgeIds.at(frontSingularEdgeId).push_back(backSingularEdgeId);
-//                    linkedByOneComponentEdgeSingularEdgeIds.at(backSingularEdgeId).push_back(frontSingularEdgeId);
-                    if (directlyLinkedSingularEdgeIds[frontSingularEdgeId][backSingularEdgeId] == 0) {
-                    linkedByOneComponentEdgeSingularEdgeIds[frontSingularEdgeId][backSingularEdgeId] = 1;
-                    linkedByOneComponentEdgeSingularEdgeIds[backSingularEdgeId][frontSingularEdgeId] = 1;
-                    }
-                }
-        }
+    const auto& mesh = m_baseComplex.mesh;
+    const auto& componentE = m_baseComplex.componentE;
+    std::vector<RelationPairs> pairs(componentE.size());
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)componentE.size(); ++i) {
+        const auto& componentEdge = componentE[i];
+        const size_t frontVid = componentEdge.vids_link.front();
+        const size_t backVid = componentEdge.vids_link.back();
+        if (!mesh.V.at(frontVid).isSingularity || !mesh.V.at(backVid).isSingularity || frontVid == backVid) continue;
+        for (auto k = meshVidSingularEdgeOffsets[frontVid]; k < meshVidSingularEdgeOffsets[frontVid + 1]; ++k)
+            for (auto l = meshVidSingularEdgeOffsets[backVid]; l < meshVidSingularEdgeOffsets[backVid + 1]; ++l) {
+                const size_t frontSingularEdgeId = meshVidSingularEdgeIds[k];
+                const size_t backSingularEdgeId = meshVidSingularEdgeIds[l];
+                if (frontSingularEdgeId != backSingularEdgeId && !IsRelated(directlyLinkedSingularEdgeIds, frontSingularEdgeId, backSingularEdgeId))
+                    AddSymmetricPair(pairs[i], frontSingularEdgeId, backSingularEdgeId);
+            }
     }
-    for (int i = 0; i < E.size(); ++i)
-        linkedByOneComponentEdgeSingularEdgeIds[i][i] = 0;
 
     // two parallel edges in a component is considered to be linkedByOneComponentEdge;
-    const auto& mesh = m_baseComplex.mesh;
-    for (const auto& componentCell : m_baseComplex.componentC) {
+    const auto& componentC = m_baseComplex.componentC;
+    pairs.resize(componentE.size() + componentC.size());
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)componentC.size(); ++i) {
+        const auto& componentCell = componentC[i];
         std::vector<size_t> singularEdgeIds;
         for (const auto componentEid : componentCell.Eids) {
-            if (mesh.E.at(m_baseComplex.componentE.at(componentEid).eids_link.front()).isSingularity) {
-                singularEdgeIds.push_back(mesh.E.at(m_baseComplex.componentE.at(componentEid).eids_link.front()).singularEid);
+            if (mesh.E.at(componentE.at(componentEid).eids_link.front()).isSingularity) {
+                singularEdgeIds.push_back(mesh.E.at(componentE.at(componentEid).eids_link.front()).singularEid);
             }
         }
         if (singularEdgeIds.size() < 2) continue;
@@ -218,12 +250,11 @@ void SingularityGraph::BuildE_linkedByOneComponentEdgeSingularEdgeIds()
         for (const auto& c : com) {
             const size_t seid1 = singularEdgeIds[c[0]];
             const size_t seid2 = singularEdgeIds[c[1]];
-            if (directlyLinkedSingularEdgeIds[seid1][seid2] == 0) {
-                linkedByOneComponentEdgeSingularEdgeIds[seid1][seid2] = 1;
-                linkedByOneComponentEdgeSingularEdgeIds[seid2][seid1] = 1;
-            }
+            if (!IsRelated(directlyLinkedSingularEdgeIds, seid1, seid2))
+                AddSymmetricPair(pairs[componentE.size() + i], seid1, seid2);
         }
     }
+    BuildRelation(E.size(), pairs, linkedByOneComponentEdgeSingularEdgeIds);
 }
 
 void SingularityGraph::BuildE_notDirectlyLinked_And_NotLinkedByOneComponentEdge_But_ParallelOnTheSameFacesPatchSingularEdgeIds()
@@ -239,18 +270,8 @@ size_t GetTovisitedId(const std::vector<std::string>& visited)
 }
 void SingularityGraph::BuildE_parallelDirectionSingularEdgeIds()
 {
-    parallelDirectionSingularEdgeIds.clear();
-    parallelDirectionSingularEdgeIds.resize(E.size(), std::vector<size_t>(E.size(), 0));
-    orthogonalDirectionSingularEdgeIds.clear();
-    orthogonalDirectionSingularEdgeIds.resize(E.size(), std::vector<size_t>(E.size(), 0));
-    const auto& mesh = m_baseComplex.mesh;
-    for (const auto & singularEdge : m_baseComplex.SingularityI.E) {
-        for (size_t column = 0; column < directlyLinkedSingularEdgeIds.at(singularEdge.id).size(); ++column)
-            if (directlyLinkedSingularEdgeIds[singularEdge.id][column] != 0) {
-                orthogonalDirectionSingularEdgeIds[singularEdge.id][column] = 1;
-                orthogonalDirectionSingularEdgeIds[column][singularEdge.id] = 1;
-            }
-    }
+    parallelDirectionSingularEdgeIds.assign(E.size(), std::vector<size_t>());
+    orthogonalDirectionSingularEdgeIds = directlyLinkedSingularEdgeIds;
 
 //    for (const auto & singularEdge : m_baseComplex.SingularityI.E) {
 //        for (int i = 0; i < singularEdge.separatedFacePatchIds.size(); ++i) {
@@ -278,11 +299,12 @@ void SingularityGraph::BuildE_parallelDirectionSingularEdgeIds()
 
 void SingularityGraph::BuildE_orthogonalDirectionSingularEdgeIds()
 {
-    orthogonalDirectionSingularEdgeIds.clear();
-    orthogonalDirectionSingularEdgeIds.resize(E.size(), std::vector<size_t>(E.size(), 0));
     const Mesh& mesh = m_baseComplex.GetMesh();
-    for (const auto& v : V) {
-        //auto neighborSingularEdgeIds = v.neighborSingularEdgeIds;
+    std::vector<RelationPairs> pairs(V.size());
+    std::vector<RelationPairs> circularPairs(V.size());
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)V.size(); ++i) {
+        const auto& v = V[i];
         std::vector<std::vector<size_t>> com = Util::combine(v.neighborSingularEdgeIds.size(), 2);
         for (const auto& c : com) {
             const size_t seid1 = v.neighborSingularEdgeIds[c[0]];
@@ -291,8 +313,8 @@ void SingularityGraph::BuildE_orthogonalDirectionSingularEdgeIds()
             const SingularEdge& se2 = E.at(seid2);
             const bool isCircular = se1.vids_link.front() == se1.vids_link.back() || se2.vids_link.front() == se2.vids_link.back();
             if (isCircular) {
-                directlyLinkedSingularEdgeIds[seid1][seid2] = 1;
-                directlyLinkedSingularEdgeIds[seid1][seid1] = 1;
+                circularPairs[i].push_back(std::make_pair(seid1, seid2));
+                circularPairs[i].push_back(std::make_pair(seid1, seid1));
             } else {
                 size_t eid1 = se1.eids_link.front();
                 size_t eid2 = se2.eids_link.front();
@@ -300,23 +322,31 @@ void SingularityGraph::BuildE_orthogonalDirectionSingularEdgeIds()
                     eid1 = se1.eids_link.back();
                 if (mesh.E.at(eid2).Vids[0] != v.id_mesh && mesh.E.at(eid2).Vids[1] != v.id_mesh)
                     eid2 = se2.eids_link.back();
-                if (IsTwoEdgesOnOneFace(mesh, mesh.E.at(eid1), mesh.E.at(eid2), mesh.V.at(v.id_mesh))) {
-                    orthogonalDirectionSingularEdgeIds[seid1][seid2] = 1;
-                    orthogonalDirectionSingularEdgeIds[seid2][seid1] = 1;
-                }
+                if (IsTwoEdgesOnOneFace(mesh, mesh.E.at(eid1), mesh.E.at(eid2), mesh.V.at(v.id_mesh)))
+                    AddSymmetricPair(pairs[i], seid1, seid2);
             }
         }
     }
+    BuildRelation(E.size(), pairs, orthogonalDirectionSingularEdgeIds);
+    bool hasCircular = false;
+    for (const auto& localPairs : circularPairs)
+        if (!localPairs.empty()) hasCircular = true;
+    if (hasCircular) {
+        for (size_t i = 0; i < E.size(); ++i)
+            for (auto j : directlyLinkedSingularEdgeIds[i])
+                circularPairs[0].push_back(std::make_pair(i, j));
+        BuildRelation(E.size(), circularPairs, directlyLinkedSingularEdgeIds);
+    }
 }
 
 void SingularityGraph::BuildE_onTheSameFacesPatchSingularEdgeIds()
 {
-    onTheSameFacesPatchSingularEdgeIds.clear();
-    onTheSameFacesPatchSingularEdgeIds.resize(E.size(), std::vector<size_t>(E.size(), 0));
     const Mesh& mesh = m_baseComplex.GetMesh();
-    int seid = 0;
-    for (const auto& singularityEdge : m_baseComplex.SingularityI.E) {
-        for (const auto& componentEids : singularityEdge.separatedComponentEids) {
+    const auto& singularityE = m_baseComplex.SingularityI.E;
+    std::vector<RelationPairs> pairs(singularityE.size());
+#pragma omp parallel for
+    for (long long seid = 0; seid < (long long)singularityE.size(); ++seid) {
+        for (const auto& componentEids : singularityE[seid].separatedComponentEids) {
             std::vector<size_t> singularEdgeIds;
             for (const auto componentEid : componentEids) {
                 if (mesh.E.at(m_baseComplex.componentE.at(componentEid).eids_link.front()).isSingularity) {
@@ -325,14 +355,11 @@ void SingularityGraph::BuildE_onTheSameFacesPatchSingularEdgeIds()
             }
             std::sort(singularEdgeIds.begin(), singularEdgeIds.end());
             singularEdgeIds.resize(std::distance(singularEdgeIds.begin(), std::unique(singularEdgeIds.begin(), singularEdgeIds.end())));
-            //std::vector<std::vector<size_t>> combinations = Util::combine(v.neighborSingularEdgeIds.size(), 2);
-            for (const auto singularEdgeId : singularEdgeIds) {
-                onTheSameFacesPatchSingularEdgeIds[seid][singularEdgeId] = 1;
-                onTheSameFacesPatchSingularEdgeIds[singularEdgeId][seid] = 1;
-            }
+            for (const auto singularEdgeId : singularEdgeIds)
+                AddSymmetricPair(pairs[seid], seid, singularEdgeId);
         }
-        ++seid;
     }
+    BuildRelation(E.size(), pairs, onTheSameFacesPatchSingularEdgeIds);
 }
 
 void SingularityGraph::Build_regularSingularEdgeIds()
@@ -352,9 +379,9 @@ static void GetQuadVertexIds(size_t i, size_t j, int n, size_t quadVids[]){
     quadVids[3] = (i + 1) * (n + 1) + j;
 }
 
-void SingularityGraph::WriteMatrixVTK(const char* filename, const std::vector<std::vector<size_t>>& m)
+void SingularityGraph::WriteMatrixVTK(const char* filename, const std::vector<std::vector<size_t>>& relation)
 {
-    const size_t n = m.size();
+    const size_t n = relation.size();
     const size_t numOfVertices = (n + 1) * (n + 1);
     const size_t numOfCells = n * n;
     std::vector<glm::vec2> V(numOfVertices);
@@ -383,18 +410,25 @@ void SingularityGraph::WriteMatrixVTK(const char* filename, const std::vector<st
     ofs << "CELL_DATA " << numOfCells << "\n"
         << "SCALARS " << "label" << " int 1\n"
         << "LOOKUP_TABLE default\n";
-    for (size_t i = 0; i < n; ++i)
+    std::vector<size_t> row(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (auto j : relation[i]) row[j] = 1;
         for (size_t j = 0; j < n; ++j)
-            ofs << m[i][j] << "\n";
+            ofs << row[j] << "\n";
+        for (auto j : relation[i]) row[j] = 0;
+    }
 }
 
-void SingularityGraph::WriteMatrixMat(const char* filename, const std::vector<std::vector<size_t>>& m)
+void SingularityGraph::WriteMatrixMat(const char* filename, const std::vector<std::vector<size_t>>& relation)
 {
     std::ofstream ofs(filename);
-    const size_t n = m.size();
+    const size_t n = relation.size();
+    std::vector<size_t> row(n, 0);
     for (size_t i = 0; i < n; ++i) {
+        for (auto j : relation[i]) row[j] = 1;
         for (size_t j = 0; j < n; ++j)
-            ofs << m[i][j] << "\t";
+            ofs << row[j] << "\t";
         ofs << "\n";
+        for (auto j : relation[i]) row[j] = 0;
     }
 }
@@ -38,8 +38,11 @@ private:
 public:
     const BaseComplex& GetBaseComplex() const;
     void Build();
-    void WriteMatrixVTK(const char* filename, const std::vector<std::vector<size_t>>& m);
-    void WriteMatrixMat(const char* filename, const std::vector<std::vector<size_t>>& m);
+    // the relations below are sparse, row i holds the sorted singular edge ids related to singular edge i
+    static bool IsRelated(const std::vector<std::vector<size_t>>& relation, const size_t i, const size_t j);
+    static std::vector<std::vector<size_t>> GetDenseMatrix(const std::vector<std::vector<size_t>>& relation);
+    void WriteMatrixVTK(const char* filename, const std::vector<std::vector<size_t>>& relation);
+    void WriteMatrixMat(const char* filename, const std::vector<std::vector<size_t>>& relation);
 private:
     void BuildV();
     void BuildE();
@@ -67,6 +70,10 @@ public:
     std::vector<size_t> regularSingularEdgeIds;
     std::vector<size_t> irregularSingularEdgeIds;
 
+    std::vector<size_t> meshVidToSingularVid;        // MAXID for regular mesh vertices
+    std::vector<size_t> meshVidSingularEdgeOffsets;  // CSR over mesh vertices
+    std::vector<size_t> meshVidSingularEdgeIds;      // singular edges whose vids_link contains the vertex
+
     const BaseComplex& m_baseComplex;
 };
 
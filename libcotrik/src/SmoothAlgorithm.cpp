@@ -40,6 +40,8 @@ int SmoothAlgorithm::Run(const size_t iters/* = 1e2*/, const double eps/* = 1e-4
     double last_energy = 1e10;
     int iter = 0;
     std::cout << "===== Smooth max iters = " << iters << " eps = " << eps << "\n";
+    BuildIncidence();
+    if (gaussSeidel) BuildColors();
     while (!converged && iter++ != iters) {
         double current = SmoothVolume();
         converged = fabs(current - last_energy)/last_energy < eps;
@@ -49,7 +51,51 @@ int SmoothAlgorithm::Run(const size_t iters/* = 1e2*/, const double eps/* = 1e-4
     return error_code;
 }
 
-glm::dvec3 SmoothAlgorithm::LapLace(const Vertex& v)
+void SmoothAlgorithm::BuildIncidence()
+{
+    const size_t n = mesh.V.size();
+    cornerOffsets.assign(n + 1, 0);
+    for (const auto& c : mesh.C)
+        for (auto vid : c.Vids)
+            cornerOffsets[vid + 1]++;
+    for (size_t i = 0; i < n; i++)
+        cornerOffsets[i + 1] += cornerOffsets[i];
+    corners.resize(cornerOffsets[n]);
+    std::vector<size_t> cursor(cornerOffsets.begin(), cornerOffsets.end() - 1);
+    for (size_t i = 0; i < mesh.C.size(); i++)
+        for (size_t j = 0; j < mesh.C[i].Vids.size(); j++)
+            corners[cursor[mesh.C[i].Vids[j]]++] = 8 * i + j;
+}
+
+// greedy coloring, two vertices sharing a cell get different colors
+void SmoothAlgorithm::BuildColors()
+{
+    const size_t n = mesh.V.size();
+    std::vector<size_t> colors(n, MAXID);
+    std::vector<size_t> stamps;     // stamps[color] == vid if a neighbor of vid has the color
+    size_t numOfColors = 0;
+    for (size_t vid = 0; vid < n; vid++) {
+        if (mesh.V[vid].isBoundary) continue;
+        for (size_t k = cornerOffsets[vid]; k < cornerOffsets[vid + 1]; k++)
+            for (auto nvid : mesh.C[corners[k] / 8].Vids)
+                if (colors[nvid] != MAXID) stamps[colors[nvid]] = vid;
+        size_t color = 0;
+        while (color < numOfColors && stamps[color] == vid) color++;
+        if (color == numOfColors) stamps.push_back(MAXID), numOfColors++;
+        colors[vid] = color;
+    }
+    colorOffsets.assign(numOfColors + 1, 0);
+    for (size_t vid = 0; vid < n; vid++)
+        if (colors[vid] != MAXID) colorOffsets[colors[vid] + 1]++;
+    for (size_t c = 0; c < numOfColors; c++)
+        colorOffsets[c + 1] += colorOffsets[c];
+    colorVids.resize(colorOffsets[numOfColors]);
+    std::vector<size_t> cursor(colorOffsets.begin(), colorOffsets.end() - 1);
+    for (size_t vid = 0; vid < n; vid++)
+        if (colors[vid] != MAXID) colorVids[cursor[colors[vid]]++] = vid;
+}
+
+glm::dvec3 SmoothAlgorithm::LapLace(const Vertex& v) const
 {
     {
         glm::dvec3 sum(0.0, 0.0, 0.0);
@@ -73,97 +119,80 @@ const int SJP[8][3] = {
     { 6, 4, 3 }
 };
 
-glm::dvec3 SmoothAlgorithm::ScaledJacobian(const Vertex& v)
+// For the hex corner at v with neighbors v1, v2, v3 the corner is orthogonal iff
+//     (x - v1).(v2 - v3) = 0, (x - v2).(v1 - v3) = 0, (x - v3).(v1 - v2) = 0.
+// The third row is the second minus the first, the solutions are the line through the
+// orthocenter of v1 v2 v3 along its normal n; the point of the line closest to v is taken
+// by replacing the third row with n.x = n.v and solving the 3x3 system by Cramer's rule.
+glm::dvec3 SmoothAlgorithm::ScaledJacobian(const Vertex& v) const
 {
-    {
-        const std::vector<Vertex>& V = mesh.V;
-        const std::vector<Cell>& C = mesh.C;
-//        glm::dvec3 b;
-//        glm::mat3x3 m;
-        Eigen::MatrixXd m(3, 3);
-        Eigen::VectorXd b(3);
-        glm::dvec3 sum(0.0, 0.0, 0.0);
-        glm::dvec3 x;
-        int count = 0;
-        for (size_t i = 0; i < v.N_Cids.size(); i++) {
-            const Cell& c = C[v.N_Cids.at(i)];
-            int vid = 0;
-            for (int j = 0; j < c.Vids.size(); j++)
-                if (c.Vids.at(j) == v.id) {
-                    vid = j;
-                    break;
-                }
-            const glm::dvec3& v1 = V.at(c.Vids.at(SJP[vid][0]));
-            const glm::dvec3& v2 = V.at(c.Vids.at(SJP[vid][1]));
-            const glm::dvec3& v3 = V.at(c.Vids.at(SJP[vid][2]));
-//            m[0][0] = v2.x - v3.x; m[0][1] = v2.y - v3.y; m[0][2] = v2.z - v3.z;
-//            m[1][0] = v1.x - v3.x; m[1][1] = v1.y - v3.y; m[1][2] = v1.z - v3.z;
-//            m[2][0] = v1.x - v2.x; m[2][1] = v1.y - v2.y; m[2][2] = v1.z - v2.z;
-//            b.x = v1.x * (v2.x - v3.x) + v1.y * (v2.y - v3.y) + v1.z * (v2.z - v3.z);
-//            b.y = v2.x * (v1.x - v3.x) + v2.y * (v1.y - v3.y) + v2.z * (v1.z - v3.z);
-//            b.z = v3.x * (v1.x - v2.x) + v3.y * (v1.y - v2.y) + v3.z * (v1.z - v2.z);
-//            const glm::dvec3 x = glm::inverse(m)*b;
-
-            m(0,0) = v2.x - v3.x; m(0,1) = v2.y - v3.y; m(0,2) = v2.z - v3.z;
-            m(1,0) = v1.x - v3.x; m(1,1) = v1.y - v3.y; m(1,2) = v1.z - v3.z;
-            m(2,0) = v1.x - v2.x; m(2,1) = v1.y - v2.y; m(2,2) = v1.z - v2.z;
-            b(0) = v1.x * (v2.x - v3.x) + v1.y * (v2.y - v3.y) + v1.z * (v2.z - v3.z);
-            b(1) = v2.x * (v1.x - v3.x) + v2.y * (v1.y - v3.y) + v2.z * (v1.z - v3.z);
-            b(2) = v3.x * (v1.x - v2.x) + v3.y * (v1.y - v2.y) + v3.z * (v1.z - v2.z);
-            double b0 = b(0);
-            double b1 = b(1);
-            double b2 = b(2);
-
-            Eigen::VectorXd X = m.llt().solve(b);
-            x.x = X(0);
-            x.y = X(1);
-            x.z = X(2);
-            sum += x;
-            count++;
-        }
-        return glm::dvec3(sum.x/count, sum.y/count, sum.z/count);
+    const std::vector<Vertex>& V = mesh.V;
+    const std::vector<Cell>& C = mesh.C;
+    glm::dvec3 sum(0.0, 0.0, 0.0);
+    int count = 0;
+    for (size_t k = cornerOffsets[v.id]; k < cornerOffsets[v.id + 1]; k++) {
+        const Cell& c = C[corners[k] / 8];
+        if (c.Vids.size() != 8) continue;
+        const size_t corner = corners[k] % 8;
+        const glm::dvec3& v1 = V[c.Vids[SJP[corner][0]]];
+        const glm::dvec3& v2 = V[c.Vids[SJP[corner][1]]];
+        const glm::dvec3& v3 = V[c.Vids[SJP[corner][2]]];
+        const glm::dvec3 r0 = v2 - v3;
+        const glm::dvec3 r1 = v1 - v3;
+        const glm::dvec3 r2 = glm::cross(r0, r1);
+        const double det = glm::dot(r2, r2);
+        if (!(det > 1e-12 * glm::dot(r0, r0) * glm::dot(r1, r1))) continue;
+        const double b0 = glm::dot(v1, r0);
+        const double b1 = glm::dot(v2, r1);
+        const double b2 = glm::dot(v.xyz(), r2);
+        sum += (b0 * glm::cross(r1, r2) + b1 * glm::cross(r2, r0) + b2 * r2) / det;
+        count++;
     }
+    if (count == 0) return v.xyz();
+    return sum / double(count);
+}
+
+glm::dvec3 SmoothAlgorithm::Smooth(const size_t vid) const
+{
+    const Vertex& v = mesh.V[vid];
+    if (m_smoothAlgorithm == LAPLACIAN)
+        return LapLace(v);
+    else if (m_smoothAlgorithm == SCALED_JACOBIAN)
+        return ScaledJacobian(v);
+    return v.xyz();
 }
 
 double SmoothAlgorithm::SmoothVolume(const Smooth_Algorithm smoothMethod/* = LAPLACE_EDGE*/)
 {
     std::vector<Vertex>& V = mesh.V;
-    std::vector<glm::dvec3> oldV(mesh.V.size());
-    std::vector<glm::dvec3> newV(mesh.V.size());
-    for (size_t i = 0; i < V.size(); i++) {
-        oldV[i] = V[i];
-    }
-    //while (iters-- != 0)
-    {
-//#pragma omp parallel for
-        for (size_t i = 0; i < V.size(); i++) {
-            const Vertex& v = V.at(i);
-            if (v.isBoundary)
-                continue;
-            if (m_smoothAlgorithm == LAPLACIAN) {
-                newV.at(i) = LapLace(v);
-            }else if (m_smoothAlgorithm == SCALED_JACOBIAN)
-                newV.at(i) = ScaledJacobian(v);
+    double energy = 0;
+    if (gaussSeidel) {
+        for (size_t color = 0; color + 1 < colorOffsets.size(); color++) {
+#pragma omp parallel for reduction(+:energy)
+            for (long long k = colorOffsets[color]; k < (long long)colorOffsets[color + 1]; k++) {
+                Vertex& v = V[colorVids[k]];
+                const glm::dvec3 p = Smooth(v.id);
+                const double distance = glm::length(p - v.xyz());
+                energy += distance * distance;
+                v = p;
+            }
         }
-
-        for (size_t i = 0; i < V.size(); i++) {
-            Vertex& v = V.at(i);
+    } else {
+        newV.resize(V.size());
+#pragma omp parallel for
+        for (long long i = 0; i < (long long)V.size(); i++)
+            if (!V[i].isBoundary) newV[i] = Smooth(i);
+#pragma omp parallel for reduction(+:energy)
+        for (long long i = 0; i < (long long)V.size(); i++) {
+            Vertex& v = V[i];
             if (v.isBoundary)
                 continue;
+            const double distance = glm::length(newV[i] - v.xyz());
+            energy += distance * distance;
             v = newV[i];
         }
     }
 
-    double energy = 0;
-    for (size_t i = 0; i < V.size(); i++) {
-        const Vertex& v = V.at(i);
-        if (v.isBoundary)
-            continue;
-        const glm::dvec3& oldv = oldV.at(i);
-        const double distance = glm::length(v.xyz() - oldv);
-        energy += distance * distance;
-    }
-
     std::cout << "Volume Energy = " << energy << std::endl;
     return energy;
 }
@@ -30,14 +30,27 @@ private:
 public:
     virtual int Run(const size_t iters = 1e2, const double eps = 1e-4);
 
+public:
+    // update the vertices in place one color at a time instead of the default Jacobi sweep;
+    // vertices of the same color share no cell, so each color is still smoothed in parallel
+    bool gaussSeidel = false;
+
 private:
+    void BuildIncidence();
+    void BuildColors();
     double SmoothVolume(const Smooth_Algorithm smoothMethod = LAPLACIAN);
-    glm::dvec3 LapLace(const Vertex& v);
-    glm::dvec3 ScaledJacobian(const Vertex& v);
+    glm::dvec3 LapLace(const Vertex& v) const;
+    glm::dvec3 ScaledJacobian(const Vertex& v) const;
+    glm::dvec3 Smooth(const size_t vid) const;
 
 private:
     Mesh& mesh;
     Smooth_Algorithm m_smoothAlgorithm = LAPLACIAN;
+    std::vector<size_t> cornerOffsets;  // CSR over vertices
+    std::vector<size_t> corners;        // 8 * cid + local index of the vertex in C[cid]
+    std::vector<size_t> colorOffsets;   // CSR over colors of the interior vertices
+    std::vector<size_t> colorVids;
+    std::vector<glm::dvec3> newV;       // second buffer of the Jacobi sweep
 };
 
 #endif /* SMOOTH_ALGORITHM_H_ */
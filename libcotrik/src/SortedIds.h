@@ -0,0 +1,96 @@
+/*
+ * SortedIds.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_SORTEDIDS_H_
+#define LIBCOTRIK_SRC_SORTEDIDS_H_
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <stddef.h>
+
+// Set operations on sorted, duplicate free ranges of ids, a flat replacement for std::set<size_t> and for the
+// linear scans of Util. Results are appended to any container with push_back, like std::vector or SmallIds.
+
+// Keeps up to N ids inline and only allocates beyond that, for the few ids around one element.
+template <size_t N>
+class SmallIds
+{
+public:
+    typedef size_t value_type;
+    typedef size_t* iterator;
+    typedef const size_t* const_iterator;
+
+    SmallIds() {}
+    template <typename Iter>
+    SmallIds(Iter first, Iter last) { for (; first != last; ++first) push_back(*first); }
+
+    void push_back(const size_t id) {
+        if (n < N) inlineIds[n] = id;
+        else {
+            if (n == N) heapIds.assign(inlineIds, inlineIds + N);
+            heapIds.push_back(id);
+        }
+        ++n;
+    }
+    void resize(const size_t size) {
+        if (size <= N) {
+            if (n > N) std::copy(heapIds.begin(), heapIds.begin() + size, inlineIds);
+            heapIds.clear();
+        } else {
+            if (n <= N) heapIds.assign(inlineIds, inlineIds + n);
+            heapIds.resize(size);
+        }
+        n = size;
+    }
+    void clear() { resize(0); }
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    size_t* begin() { return n <= N ? inlineIds : heapIds.data(); }
+    size_t* end() { return begin() + n; }
+    const size_t* begin() const { return n <= N ? inlineIds : heapIds.data(); }
+    const size_t* end() const { return begin() + n; }
+    size_t& operator[](const size_t i) { return begin()[i]; }
+    size_t operator[](const size_t i) const { return begin()[i]; }
+    size_t front() const { return *begin(); }
+    size_t back() const { return end()[-1]; }
+
+private:
+    size_t n = 0;
+    size_t inlineIds[N];
+    std::vector<size_t> heapIds;   // all ids once there are more than N
+};
+
+// makes ids a sorted set, O(n log n)
+template <typename Ids>
+inline void SortIds(Ids& ids) {
+    std::sort(ids.begin(), ids.end());
+    ids.resize(std::unique(ids.begin(), ids.end()) - ids.begin());
+}
+
+template <typename Ids>
+inline bool ContainsId(const Ids& ids, const size_t id) {
+    return std::binary_search(ids.begin(), ids.end(), id);
+}
+
+template <typename Ids1, typename Ids2, typename Out>
+inline void UniteIds(const Ids1& a, const Ids2& b, Out& res) {
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(res));
+}
+
+template <typename Ids1, typename Ids2, typename Out>
+inline void IntersectIds(const Ids1& a, const Ids2& b, Out& res) {
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(res));
+}
+
+// the ids of a that are not in b
+template <typename Ids1, typename Ids2, typename Out>
+inline void SubtractIds(const Ids1& a, const Ids2& b, Out& res) {
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(res));
+}
+
+#endif /* LIBCOTRIK_SRC_SORTEDIDS_H_ */
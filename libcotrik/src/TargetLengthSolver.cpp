@@ -0,0 +1,245 @@
+/*
+ * TargetLengthSolver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "TargetLengthSolver.h"
+#include <algorithm>
+#include <math.h>
+
+// components with more edges are solved one after another with a parallel CG,
+// smaller ones are distributed over the threads
+static const size_t ParallelComponentSize = 4096;
+
+TargetLengthSolver::TargetLengthSolver(const Mesh& mesh)
+: mesh(mesh)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+TargetLengthSolver::~TargetLengthSolver()
+{
+    // TODO Auto-generated destructor stub
+}
+
+// calls visitor(eid1, eid2) once per least squares row x_eid1 - x_eid2 = 0, same rows as MeshOpt::ComputeMeshTargetLength
+template<typename Visitor>
+void TargetLengthSolver::VisitPairs(const bool singularOrthogonal, const Visitor& visitor) const
+{
+    for (auto& e : mesh.E) {
+        for (auto eid : e.parallelEids) visitor(e.id, eid);
+        for (auto eid : e.consecutiveEids) visitor(e.id, eid);
+    }
+    if (!singularOrthogonal) return;
+    for (auto& e : mesh.E) {
+        if (!e.isSingularity) continue;
+        if (e.N_Cids.size() != 5 && e.N_Cids.size() != 3 && e.N_Cids.size() != 6) continue;
+        for (auto eid1 : e.orthogonalEids)
+            for (auto eid2 : e.orthogonalEids) {
+                if (eid1 == eid2) continue;
+                const Edge& e1 = mesh.E.at(eid1);
+                const Edge& e2 = mesh.E.at(eid2);
+                if (e1.Vids[0] != e2.Vids[0] && e1.Vids[0] != e2.Vids[1] && e1.Vids[1] != e2.Vids[0] && e1.Vids[1] != e2.Vids[1]) continue;
+                visitor(eid1, eid2);
+            }
+    }
+}
+
+void TargetLengthSolver::Build(const bool singularOrthogonal)
+{
+    const size_t n = mesh.E.size();
+    edgeRelationsStamp = mesh.edgeRelationsStamp;
+
+    // every row x_a - x_b = 0 adds -1 to (a, b) and (b, a), collect both directions by a counting sort
+    std::vector<size_t> rowOffsets(n + 1, 0);
+    VisitPairs(singularOrthogonal, [&](const size_t a, const size_t b) {
+        if (a == b) return;
+        rowOffsets[a + 1]++;
+        rowOffsets[b + 1]++;
+    });
+    for (size_t i = 0; i < n; i++)
+        rowOffsets[i + 1] += rowOffsets[i];
+    std::vector<size_t> rowEids(rowOffsets[n]);
+    std::vector<size_t> cursor(rowOffsets.begin(), rowOffsets.end() - 1);
+    VisitPairs(singularOrthogonal, [&](const size_t a, const size_t b) {
+        if (a == b) return;
+        rowEids[cursor[a]++] = b;
+        rowEids[cursor[b]++] = a;
+    });
+
+    // merge repeated rows into weights
+    std::vector<size_t> numOfNeighbors(n, 0);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)n; i++) {
+        std::sort(rowEids.begin() + rowOffsets[i], rowEids.begin() + rowOffsets[i + 1]);
+        for (size_t j = rowOffsets[i]; j < rowOffsets[i + 1]; j++)
+            if (j == rowOffsets[i] || rowEids[j] != rowEids[j - 1]) numOfNeighbors[i]++;
+    }
+    offsets.assign(n + 1, 0);
+    for (size_t i = 0; i < n; i++)
+        offsets[i + 1] = offsets[i] + numOfNeighbors[i];
+    neighborEids.resize(offsets[n]);
+    weights.resize(offsets[n]);
+    diagonal.resize(n);
+#pragma omp parallel for
+    for (long long i = 0; i < (long long)n; i++) {
+        size_t k = offsets[i];
+        for (size_t j = rowOffsets[i]; j < rowOffsets[i + 1]; j++) {
+            if (j > rowOffsets[i] && rowEids[j] == rowEids[j - 1]) {
+                weights[k - 1] += 1.0;
+                continue;
+            }
+            neighborEids[k] = rowEids[j];
+            weights[k++] = 1.0;
+        }
+        diagonal[i] = 1.0 + rowOffsets[i + 1] - rowOffsets[i];
+    }
+    BuildComponents();
+}
+
+bool TargetLengthSolver::IsBuilt() const
+{
+    return !mesh.E.empty() && diagonal.size() == mesh.E.size() && edgeRelationsStamp == mesh.edgeRelationsStamp;
+}
+
+void TargetLengthSolver::BuildComponents()
+{
+    const size_t n = diagonal.size();
+    const size_t unvisited = MAXID;
+    std::vector<size_t> componentIds(n, unvisited);
+    std::vector<size_t> sizes;
+    std::vector<size_t> stack;
+    for (size_t seed = 0; seed < n; seed++) {
+        if (componentIds[seed] != unvisited) continue;
+        const size_t componentId = sizes.size();
+        size_t size = 0;
+        componentIds[seed] = componentId;
+        stack.push_back(seed);
+        while (!stack.empty()) {
+            const size_t eid = stack.back();
+            stack.pop_back();
+            size++;
+            for (size_t k = offsets[eid]; k < offsets[eid + 1]; k++)
+                if (componentIds[neighborEids[k]] == unvisited) {
+                    componentIds[neighborEids[k]] = componentId;
+                    stack.push_back(neighborEids[k]);
+                }
+        }
+        sizes.push_back(size);
+    }
+
+    componentOffsets.assign(sizes.size() + 1, 0);
+    for (size_t c = 0; c < sizes.size(); c++)
+        componentOffsets[c + 1] = componentOffsets[c] + sizes[c];
+    std::vector<size_t> cursor(componentOffsets.begin(), componentOffsets.end() - 1);
+    componentEids.resize(n);
+    localIds.resize(n);
+    for (size_t eid = 0; eid < n; eid++) {
+        const size_t c = componentIds[eid];
+        localIds[eid] = cursor[c] - componentOffsets[c];
+        componentEids[cursor[c]++] = eid;
+    }
+}
+
+void TargetLengthSolver::Solve(const std::vector<double>& b, std::vector<double>& x) const
+{
+    x.resize(diagonal.size());
+    const size_t numOfComponents = componentOffsets.empty() ? 0 : componentOffsets.size() - 1;
+#pragma omp parallel for schedule(dynamic, 64)
+    for (long long c = 0; c < (long long)numOfComponents; c++)
+        if (componentOffsets[c + 1] - componentOffsets[c] < ParallelComponentSize)
+            SolveComponent(c, b, x, false);
+    for (size_t c = 0; c < numOfComponents; c++)
+        if (componentOffsets[c + 1] - componentOffsets[c] >= ParallelComponentSize)
+            SolveComponent(c, b, x, true);
+}
+
+void TargetLengthSolver::Solve(const double avgMeshEdgeLength, std::vector<double>& x) const
+{
+    std::vector<double> b(mesh.E.size());
+    for (size_t i = 0; i < mesh.E.size(); i++)
+        b[i] = mesh.E[i].isBoundary ? mesh.E[i].length : avgMeshEdgeLength;
+    Solve(b, x);
+}
+
+void TargetLengthSolver::SolveComponent(const size_t componentId, const std::vector<double>& b, std::vector<double>& x, const bool parallel) const
+{
+    const size_t* eids = componentEids.data() + componentOffsets[componentId];
+    const long long n = componentOffsets[componentId + 1] - componentOffsets[componentId];
+
+    // L annihilates constants, so a constant b is its own solution; this covers single edges too
+    bool constant = true;
+    for (long long i = 1; i < n && constant; i++)
+        constant = b[eids[i]] == b[eids[0]];
+    if (constant) {
+        for (long long i = 0; i < n; i++)
+            x[eids[i]] = b[eids[i]];
+        return;
+    }
+    if (n == 2) {
+        const size_t e0 = eids[0], e1 = eids[1];
+        const double w = weights[offsets[e0]];
+        x[e0] = ((1 + w) * b[e0] + w * b[e1]) / (1 + 2 * w);
+        x[e1] = ((1 + w) * b[e1] + w * b[e0]) / (1 + 2 * w);
+        return;
+    }
+
+    // Jacobi preconditioned CG on the component, started from b
+    std::vector<double> r(n), z(n), p(n), q(n);
+    auto multiply = [&](const std::vector<double>& v, std::vector<double>& res) {
+#pragma omp parallel for if (parallel)
+        for (long long i = 0; i < n; i++) {
+            const size_t eid = eids[i];
+            double sum = diagonal[eid] * v[i];
+            for (size_t k = offsets[eid]; k < offsets[eid + 1]; k++)
+                sum -= weights[k] * v[localIds[neighborEids[k]]];
+            res[i] = sum;
+        }
+    };
+    std::vector<double> xc(n);
+    double normB = 0;
+#pragma omp parallel for reduction(+:normB) if (parallel)
+    for (long long i = 0; i < n; i++) {
+        xc[i] = b[eids[i]];
+        normB += xc[i] * xc[i];
+    }
+    multiply(xc, q);
+    double rz = 0, rr = 0;
+#pragma omp parallel for reduction(+:rz,rr) if (parallel)
+    for (long long i = 0; i < n; i++) {
+        r[i] = b[eids[i]] - q[i];
+        z[i] = r[i] / diagonal[eids[i]];
+        p[i] = z[i];
+        rz += r[i] * z[i];
+        rr += r[i] * r[i];
+    }
+    const double threshold = tolerance * tolerance * normB;
+    for (size_t iter = 0; iter < maxIterations && rr > threshold; iter++) {
+        multiply(p, q);
+        double pq = 0;
+#pragma omp parallel for reduction(+:pq) if (parallel)
+        for (long long i = 0; i < n; i++)
+            pq += p[i] * q[i];
+        const double alpha = rz / pq;
+        double rzNew = 0;
+        rr = 0;
+#pragma omp parallel for reduction(+:rzNew,rr) if (parallel)
+        for (long long i = 0; i < n; i++) {
+            xc[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            z[i] = r[i] / diagonal[eids[i]];
+            rzNew += r[i] * z[i];
+            rr += r[i] * r[i];
+        }
+        const double beta = rzNew / rz;
+        rz = rzNew;
+#pragma omp parallel for if (parallel)
+        for (long long i = 0; i < n; i++)
+            p[i] = z[i] + beta * p[i];
+    }
+    for (long long i = 0; i < n; i++)
+        x[eids[i]] = xc[i];
+}
@@ -0,0 +1,58 @@
+/*
+ * TargetLengthSolver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_TARGETLENGTHSOLVER_H_
+#define LIBCOTRIK_SRC_TARGETLENGTHSOLVER_H_
+
+#include "Mesh.h"
+
+// Target edge lengths of the MeshOpt family. The least squares system with one row x_i = b_i per edge
+// and one row x_i - x_j = 0 per parallel/consecutive pair has the normal equations (I + L) x = b, where
+// L is the weighted graph Laplacian of the edge relation graph. Build() assembles I + L once, Solve()
+// handles every connected component on its own: single edges, pairs and constant right hand sides in
+// closed form, everything else with Jacobi preconditioned CG.
+class TargetLengthSolver
+{
+public:
+    TargetLengthSolver(const Mesh& mesh);
+    virtual ~TargetLengthSolver();
+private:
+    TargetLengthSolver();
+    TargetLengthSolver(const TargetLengthSolver&);
+    TargetLengthSolver& operator = (const TargetLengthSolver&);
+public:
+    // singularOrthogonal adds x_i - x_j = 0 for the orthogonal edges sharing a vertex around singular edges of valence 3, 5 and 6
+    void Build(const bool singularOrthogonal = false);
+    // false once the edge relations of mesh were built again, which every topology change requires
+    bool IsBuilt() const;
+    void Solve(const std::vector<double>& b, std::vector<double>& x) const;
+    // b_i is the current length of boundary edges and avgMeshEdgeLength otherwise
+    void Solve(const double avgMeshEdgeLength, std::vector<double>& x) const;
+
+private:
+    template<typename Visitor>
+    void VisitPairs(const bool singularOrthogonal, const Visitor& visitor) const;
+    void BuildComponents();
+    void SolveComponent(const size_t componentId, const std::vector<double>& b, std::vector<double>& x, const bool parallel) const;
+
+public:
+    double tolerance = 1e-10;       // relative residual of CG
+    size_t maxIterations = 1000;
+
+private:
+    const Mesh& mesh;
+    std::vector<size_t> offsets;            // CSR over edges, off-diagonal part of L
+    std::vector<size_t> neighborEids;
+    std::vector<double> weights;            // number of rows relating the two edges
+    std::vector<double> diagonal;           // 1 + sum of weights
+    std::vector<size_t> componentOffsets;   // CSR over connected components
+    std::vector<size_t> componentEids;
+    std::vector<size_t> localIds;           // position of the edge inside its component
+    size_t edgeRelationsStamp = 0;          // mesh.edgeRelationsStamp at Build()
+};
+
+#endif /* LIBCOTRIK_SRC_TARGETLENGTHSOLVER_H_ */
@@ -0,0 +1,129 @@
+/*
+ * TriangleLocator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "TriangleLocator.h"
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+
+TriangleLocator::TriangleLocator(const std::vector<Vertex>& V, const std::vector<Face>& F)
+: V(V)
+, F(F)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+TriangleLocator::~TriangleLocator()
+{
+    // TODO Auto-generated destructor stub
+}
+
+void TriangleLocator::Build()
+{
+    // bounding boxes, padded so that points accepted by the barycentric tolerance are never missed
+    std::vector<glm::dvec2> minP(F.size()), maxP(F.size());
+    glm::dvec2 gridMin(DBL_MAX, DBL_MAX), gridMax(-DBL_MAX, -DBL_MAX);
+    double sumArea = 0;
+    for (size_t i = 0; i < F.size(); i++) {
+        glm::dvec2 lo(DBL_MAX, DBL_MAX), hi(-DBL_MAX, -DBL_MAX);
+        for (auto vid : F[i].Vids) {
+            const Vertex& v = V.at(vid);
+            lo = glm::dvec2(std::min(lo.x, v.x), std::min(lo.y, v.y));
+            hi = glm::dvec2(std::max(hi.x, v.x), std::max(hi.y, v.y));
+        }
+        const double pad = 1e-4 * std::max(hi.x - lo.x, hi.y - lo.y);
+        minP[i] = lo - glm::dvec2(pad, pad);
+        maxP[i] = hi + glm::dvec2(pad, pad);
+        gridMin = glm::dvec2(std::min(gridMin.x, minP[i].x), std::min(gridMin.y, minP[i].y));
+        gridMax = glm::dvec2(std::max(gridMax.x, maxP[i].x), std::max(gridMax.y, maxP[i].y));
+        sumArea += (maxP[i].x - minP[i].x) * (maxP[i].y - minP[i].y);
+    }
+    if (F.empty()) gridMin = gridMax = glm::dvec2(0, 0);
+    origin = gridMin;
+
+    // about one bounding box per cell, never more than 4 cells per triangle
+    const glm::dvec2 extent = gridMax - gridMin;
+    const size_t n = std::max(F.size(), (size_t)1);
+    cellLength = std::max(sqrt(sumArea / n), sqrt(extent.x * extent.y / (4 * n)));
+    if (!(cellLength > 0)) cellLength = std::max(std::max(extent.x, extent.y) / n, 1.0);
+    size_t numOfCells = 1;
+    for (int j = 0; j < 2; j++) {
+        dims[j] = std::max((size_t)ceil(extent[j] / cellLength), (size_t)1);
+        numOfCells *= dims[j];
+    }
+
+    // two pass counting sort of the triangles into every cell their box overlaps
+    cellOffsets.assign(numOfCells + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<size_t> cursor;
+        if (pass == 1) {
+            for (size_t c = 0; c < numOfCells; c++)
+                cellOffsets[c + 1] += cellOffsets[c];
+            cellTriIds.resize(cellOffsets[numOfCells]);
+            cursor.assign(cellOffsets.begin(), cellOffsets.end() - 1);
+        }
+        for (size_t i = 0; i < F.size(); i++) {
+            const size_t x0 = GetCellIndex(minP[i].x, 0), x1 = GetCellIndex(maxP[i].x, 0);
+            const size_t y0 = GetCellIndex(minP[i].y, 1), y1 = GetCellIndex(maxP[i].y, 1);
+            for (size_t y = y0; y <= y1; y++)
+                for (size_t x = x0; x <= x1; x++) {
+                    const size_t c = x + dims[0] * y;
+                    if (pass == 0) cellOffsets[c + 1]++;
+                    else cellTriIds[cursor[c]++] = i;
+                }
+        }
+    }
+}
+
+size_t TriangleLocator::GetCellIndex(const double x, const size_t axis) const
+{
+    const double t = (x - origin[axis]) / cellLength;
+    if (!(t > 0)) return 0;
+    return std::min((size_t)t, dims[axis] - 1);
+}
+
+// same predicate as the IsVertextInTriangle of the quad extraction
+bool TriangleLocator::GetBarycentric(const glm::dvec2& p, const size_t triangleId, glm::dvec2& uv) const
+{
+    const auto& vids = F.at(triangleId).Vids;
+    const Vertex& p0 = V.at(vids[0]);
+    const Vertex& p1 = V.at(vids[1]);
+    const Vertex& p2 = V.at(vids[2]);
+    const glm::dvec2 v02(p0.x - p2.x, p0.y - p2.y);
+    const glm::dvec2 v12(p1.x - p2.x, p1.y - p2.y);
+    const glm::dvec2 r(p.x - p2.x, p.y - p2.y);
+    const double det = v02.x * v12.y - v12.x * v02.y;
+    if (det == 0) return false;
+    const glm::dvec2 lambda((r.x * v12.y - v12.x * r.y) / det, (v02.x * r.y - r.x * v02.y) / det);
+    if (lambda.x > -1e-5 && lambda.y > -1e-5 && (lambda.x + lambda.y) < 1.00001) {
+        uv = lambda;
+        return true;
+    }
+    return false;
+}
+
+std::vector<size_t> TriangleLocator::GetTriangleIds(const glm::dvec2& p) const
+{
+    std::vector<size_t> res;
+    if (cellTriIds.empty()) return res;
+    if (p.x < origin.x || p.y < origin.y || p.x > origin.x + dims[0] * cellLength || p.y > origin.y + dims[1] * cellLength) return res;
+    const size_t c = GetCellIndex(p.x, 0) + dims[0] * GetCellIndex(p.y, 1);
+    glm::dvec2 uv;
+    for (size_t i = cellOffsets[c]; i < cellOffsets[c + 1]; i++)
+        if (GetBarycentric(p, cellTriIds[i], uv))
+            res.push_back(cellTriIds[i]);
+    return res;
+}
+
+void TriangleLocator::GetTriangleIds(const std::vector<glm::dvec2>& points, std::vector<std::vector<size_t>>& triangleIds) const
+{
+    triangleIds.resize(points.size());
+#pragma omp parallel for schedule(dynamic, 256)
+    for (long long i = 0; i < (long long)points.size(); i++)
+        triangleIds[i] = GetTriangleIds(points[i]);
+}
@@ -0,0 +1,45 @@
+/*
+ * TriangleLocator.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_TRIANGLELOCATOR_H_
+#define LIBCOTRIK_SRC_TRIANGLELOCATOR_H_
+
+#include "Mesh.h"
+
+// Uniform bucket grid over the triangles of a planar (uv) mesh, only the x and y coordinates are used.
+// Returns every triangle containing a point, overlapping parameterizations give more than one.
+class TriangleLocator
+{
+public:
+    TriangleLocator(const std::vector<Vertex>& V, const std::vector<Face>& F);
+    virtual ~TriangleLocator();
+private:
+    TriangleLocator();
+    TriangleLocator(const TriangleLocator&);
+    TriangleLocator& operator = (const TriangleLocator&);
+public:
+    void Build();
+    // sorted ids of the triangles containing p
+    std::vector<size_t> GetTriangleIds(const glm::dvec2& p) const;
+    void GetTriangleIds(const std::vector<glm::dvec2>& points, std::vector<std::vector<size_t>>& triangleIds) const;
+    // lambda of p0 and p1 w.r.t. p2, true if p is inside up to a tolerance of 1e-5
+    bool GetBarycentric(const glm::dvec2& p, const size_t triangleId, glm::dvec2& uv) const;
+
+private:
+    size_t GetCellIndex(const double x, const size_t axis) const;
+
+private:
+    const std::vector<Vertex>& V;
+    const std::vector<Face>& F;
+    glm::dvec2 origin;
+    double cellLength = 1.0;
+    size_t dims[2] = {1, 1};
+    std::vector<size_t> cellOffsets;    // CSR over grid cells
+    std::vector<size_t> cellTriIds;     // triangles whose bounding box overlaps the cell
+};
+
+#endif /* LIBCOTRIK_SRC_TRIANGLELOCATOR_H_ */
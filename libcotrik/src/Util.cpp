@@ -6,6 +6,7 @@
  */
 
 #include "Util.h"
+#include "SortedIds.h"
 
 const double PI = 3.1415926535898;
 
@@ -20,7 +21,7 @@ Util::~Util() {
 
 std::set<size_t> Util::get_intersect(const std::set<size_t>& s1, const std::set<size_t>& s2) {
     std::set<size_t> intersect;
-    std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(), std::inserter(intersect, intersect.begin()));
+    std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(), std::inserter(intersect, intersect.end()));
     return intersect;
 }
 
@@ -93,35 +94,19 @@ double Util::GetAngle(const Mesh& mesh, const Vertex& v, const std::vector<size_
 
 
 void Util::set_redundent_clearn(std::vector<size_t>& set) {
-	std::vector<size_t> set_copy;
-	for (int i = 0; i < set.size(); i++) {
-		bool have = false;
-		for (size_t j = i + 1; j < set.size(); j++)
-			if (set[i] == set[j]) have = true;
-		if (!have) set_copy.push_back(set[i]);
-	}
-	set = set_copy;
+	SortIds(set);
 }
 
-bool Util::set_contain(std::vector<size_t>& large_set, size_t element) {
-	for (size_t j = 0; j < large_set.size(); j++)
-		if (element == large_set[j]) return true;
-
-	return false;
+bool Util::set_contain(const std::vector<size_t>& large_set, const size_t element) {
+	return std::find(large_set.begin(), large_set.end(), element) != large_set.end();
 }
 
-void Util::set_exclusion(std::vector<size_t>& large_set, std::vector<size_t>& small_set, std::vector<size_t> &result_set) {
+void Util::set_exclusion(const std::vector<size_t>& large_set, const std::vector<size_t>& small_set, std::vector<size_t> &result_set) {
 	result_set.clear();
-	for (size_t i = 0; i < large_set.size(); i++) {
-		bool inside = false;
-		for (size_t j = 0; j < small_set.size(); j++) {
-			if (small_set[j] == large_set[i]) {
-				inside = true;
-				break;
-			}
-		}
-		if (!inside) result_set.push_back(large_set[i]);
-	}
+	SmallIds<16> excluded(small_set.begin(), small_set.end());
+	SortIds(excluded);
+	for (auto id : large_set)
+		if (!ContainsId(excluded, id)) result_set.push_back(id);
 }
 
 bool Util::IsOverlap(const Face& f1, const Face& f2) {
@@ -138,14 +123,7 @@ bool Util::IsOverlap(const Face& f1, const Face& f2) {
 }
 
 bool Util::Find(const std::vector<size_t>& Ids, const size_t targetId) {
-	bool isFound = false;
-	for (size_t i = 0; i < Ids.size(); i++) {
-		if (targetId == Ids.at(i)) {
-			isFound = true;
-			break;
-		}
-	}
-	return isFound;
+	return std::find(Ids.begin(), Ids.end(), targetId) != Ids.end();
 }
 
 size_t Util::GetOppositeFaceId(const Mesh& mesh, const size_t cellId, const size_t faceId) {
@@ -51,9 +51,11 @@ public:
 	static std::vector<size_t> GetNeighborVids(const Mesh& mesh, const Vertex& v, size_t fid);
 	static double GetAngle(const Mesh& mesh, const Vertex& v, const std::vector<size_t>& fids);
 
+	// sorts and removes duplicates; on sorted ids prefer the functions of SortedIds.h over the linear scans below
 	static void set_redundent_clearn(std::vector<size_t>& set);
-	static bool set_contain(std::vector<size_t>& large_set, size_t element);
-	static void set_exclusion(std::vector<size_t>& large_set, std::vector<size_t>& small_set, std::vector<size_t> &result_set);
+	static bool set_contain(const std::vector<size_t>& large_set, const size_t element);
+	// keeps the order of large_set
+	static void set_exclusion(const std::vector<size_t>& large_set, const std::vector<size_t>& small_set, std::vector<size_t> &result_set);
 	static bool IsOverlap(const Face& f1, const Face& f2);
 	static bool Find(const std::vector<size_t>& Ids, const size_t targetId);
 	static size_t GetOppositeFaceId(const Mesh& mesh, const size_t cellId, const size_t faceId);
@@ -0,0 +1,339 @@
+/*
+ * Voxelizer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#include "Voxelizer.h"
+#include <iomanip>
+
+Voxelizer::Voxelizer(const Mesh& mesh)
+: mesh(mesh)
+{
+    // TODO Auto-generated constructor stub
+
+}
+
+Voxelizer::~Voxelizer()
+{
+    // TODO Auto-generated destructor stub
+}
+
+// edge function of p against the directed edge a->b in the xy plane
+static inline double EdgeFunction(const glm::dvec3& a, const glm::dvec3& b, const double px, const double py)
+{
+    return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+}
+
+// top-left rule, a point on a shared edge is counted by exactly one of the two triangles
+static inline bool IsInsideEdge(const glm::dvec3& a, const glm::dvec3& b, const double w)
+{
+    if (w != 0.0) return w > 0.0;
+    const double dy = b.y - a.y;
+    return dy > 0.0 || (dy == 0.0 && b.x < a.x);
+}
+
+void Voxelizer::Run(const size_t numberOfGridsPerAxis/* = 50*/)
+{
+    BuildTriangles();
+    BuildGrid(numberOfGridsPerAxis);
+    BuildColumnHits();
+
+    const long long nx = xTotalStep, ny = yTotalStep, nz = zTotalStep;
+    const size_t planeSize = ny * nz;
+    const size_t slabSize = (ny - 1) * (nz - 1);
+
+    // count used points per plane and interior cells per slab
+    std::vector<size_t> planeVertexCounts(nx + 1, 0);
+    std::vector<size_t> slabCellCounts(nx, 0);
+#pragma omp parallel
+    {
+        std::vector<unsigned char> lowerSlab(slabSize), upperSlab(slabSize);
+        std::vector<unsigned int> localVids(planeSize);
+#pragma omp for schedule(dynamic)
+        for (long long p = 0; p < nx; p++) {
+            GetSlabInside(p - 1, lowerSlab);
+            GetSlabInside(p, upperSlab);
+            planeVertexCounts[p + 1] = GetPlaneVids(lowerSlab, upperSlab, localVids);
+            if (p + 1 == nx) continue;
+            size_t count = 0;
+            for (auto inside : upperSlab)
+                count += inside;
+            slabCellCounts[p + 1] = count;
+        }
+    }
+    for (long long p = 0; p < nx; p++)
+        planeVertexCounts[p + 1] += planeVertexCounts[p];
+    for (long long i = 1; i < nx; i++)
+        slabCellCounts[i] += slabCellCounts[i - 1];
+
+    const size_t numOfVertices = planeVertexCounts[nx];
+    const size_t numOfCells = slabCellCounts[nx - 1];
+    X.resize(numOfVertices);
+    Y.resize(numOfVertices);
+    Z.resize(numOfVertices);
+    Vids.resize(8 * numOfCells);
+
+    // emit compacted vertices of plane p and the interior cells of slab p in one sweep
+#pragma omp parallel
+    {
+        std::vector<unsigned char> slab0(slabSize), slab1(slabSize), slab2(slabSize);
+        std::vector<unsigned int> vids0(planeSize), vids1(planeSize);
+#pragma omp for schedule(dynamic)
+        for (long long p = 0; p < nx; p++) {
+            GetSlabInside(p - 1, slab0);
+            GetSlabInside(p, slab1);
+            GetSlabInside(p + 1, slab2);
+            GetPlaneVids(slab0, slab1, vids0);
+            const unsigned int vidOffset0 = planeVertexCounts[p];
+            for (long long j = 0; j < ny; j++)
+                for (long long k = 0; k < nz; k++) {
+                    const unsigned int localVid = vids0[j * nz + k];
+                    if (localVid == (unsigned int)-1) continue;
+                    const size_t vid = vidOffset0 + localVid;
+                    X[vid] = origin.x + cubeLength * p;
+                    Y[vid] = origin.y + cubeLength * j;
+                    Z[vid] = origin.z + cubeLength * k;
+                }
+            if (p + 1 == nx) continue;
+
+            GetPlaneVids(slab1, slab2, vids1);
+            const unsigned int vidOffset1 = planeVertexCounts[p + 1];
+            size_t cid = slabCellCounts[p];
+            for (long long j = 0; j < ny - 1; j++)
+                for (long long k = 0; k < nz - 1; k++) {
+                    if (!slab1[j * (nz - 1) + k]) continue;
+                    unsigned int* v8 = &Vids[8 * cid++];
+                    v8[0] = vidOffset0 + vids0[(j + 1) * nz + k + 1];
+                    v8[1] = vidOffset0 + vids0[j * nz + k + 1];
+                    v8[2] = vidOffset0 + vids0[j * nz + k];
+                    v8[3] = vidOffset0 + vids0[(j + 1) * nz + k];
+                    v8[4] = vidOffset1 + vids1[(j + 1) * nz + k + 1];
+                    v8[5] = vidOffset1 + vids1[j * nz + k + 1];
+                    v8[6] = vidOffset1 + vids1[j * nz + k];
+                    v8[7] = vidOffset1 + vids1[(j + 1) * nz + k];
+                }
+        }
+    }
+    std::cout << "Voxelizer: #V = " << numOfVertices << " #C = " << numOfCells << std::endl;
+}
+
+void Voxelizer::BuildTriangles()
+{
+    triangles.clear();
+    const bool isVolume = !mesh.C.empty();
+    for (auto& f : mesh.F) {
+        if (isVolume && !f.isBoundary) continue;
+        for (size_t i = 1; i + 1 < f.Vids.size(); i++) {
+            triangles.push_back(mesh.V.at(f.Vids[0]).xyz());
+            triangles.push_back(mesh.V.at(f.Vids[i]).xyz());
+            triangles.push_back(mesh.V.at(f.Vids[i + 1]).xyz());
+        }
+    }
+}
+
+void Voxelizer::BuildGrid(const size_t numberOfGridsPerAxis)
+{
+    origin = glm::dvec3(1e+10);
+    glm::dvec3 max_coordinate(-1e+10);
+    for (auto& v : mesh.V)
+        for (int j = 0; j < 3; j++) {
+            if (v[j] < origin[j]) origin[j] = v[j];
+            if (v[j] > max_coordinate[j]) max_coordinate[j] = v[j];
+        }
+
+    const double xLength = max_coordinate.x - origin.x;
+    const double yLength = max_coordinate.y - origin.y;
+    const double zLength = max_coordinate.z - origin.z;
+
+    double maxLengh = xLength;
+    if (yLength > maxLengh) maxLengh = yLength;
+    if (zLength > maxLengh) maxLengh = zLength;
+
+    cubeLength = maxLengh / numberOfGridsPerAxis;
+    xTotalStep = round(xLength / cubeLength) + 1;
+    yTotalStep = round(yLength / cubeLength) + 1;
+    zTotalStep = round(zLength / cubeLength) + 1;
+    if (xTotalStep < 2) xTotalStep = 2;
+    if (yTotalStep < 2) yTotalStep = 2;
+    if (zTotalStep < 2) zTotalStep = 2;
+}
+
+void Voxelizer::BuildColumnHits()
+{
+    const long long nx = xTotalStep - 1, ny = yTotalStep - 1;
+    const size_t numOfColumns = nx * ny;
+    const size_t numOfTriangles = triangles.size() / 3;
+
+    // bin triangles into the columns overlapped by their xy bounding box
+    std::vector<long long> ranges(4 * numOfTriangles);
+#pragma omp parallel for
+    for (long long t = 0; t < (long long)numOfTriangles; t++) {
+        const glm::dvec3* tri = &triangles[3 * t];
+        const double minx = std::min(std::min(tri[0].x, tri[1].x), tri[2].x);
+        const double maxx = std::max(std::max(tri[0].x, tri[1].x), tri[2].x);
+        const double miny = std::min(std::min(tri[0].y, tri[1].y), tri[2].y);
+        const double maxy = std::max(std::max(tri[0].y, tri[1].y), tri[2].y);
+        long long* r = &ranges[4 * t];
+        r[0] = std::max(0LL, (long long)floor((minx - origin.x) / cubeLength));
+        r[1] = std::min(nx - 1, (long long)floor((maxx - origin.x) / cubeLength));
+        r[2] = std::max(0LL, (long long)floor((miny - origin.y) / cubeLength));
+        r[3] = std::min(ny - 1, (long long)floor((maxy - origin.y) / cubeLength));
+    }
+    columnTriOffsets.assign(numOfColumns + 1, 0);
+    for (size_t t = 0; t < numOfTriangles; t++) {
+        const long long* r = &ranges[4 * t];
+        for (long long i = r[0]; i <= r[1]; i++)
+            for (long long j = r[2]; j <= r[3]; j++)
+                columnTriOffsets[i * ny + j + 1]++;
+    }
+    for (size_t col = 0; col < numOfColumns; col++)
+        columnTriOffsets[col + 1] += columnTriOffsets[col];
+    columnTriIds.resize(columnTriOffsets[numOfColumns]);
+    std::vector<size_t> fill(columnTriOffsets.begin(), columnTriOffsets.end() - 1);
+    for (size_t t = 0; t < numOfTriangles; t++) {
+        const long long* r = &ranges[4 * t];
+        for (long long i = r[0]; i <= r[1]; i++)
+            for (long long j = r[2]; j <= r[3]; j++)
+                columnTriIds[fill[i * ny + j]++] = t;
+    }
+
+    // scanline crossings at every column center
+    columnHitOffsets.assign(numOfColumns + 1, 0);
+#pragma omp parallel for schedule(dynamic)
+    for (long long col = 0; col < (long long)numOfColumns; col++) {
+        const double px = origin.x + cubeLength * (col / ny + 0.5);
+        const double py = origin.y + cubeLength * (col % ny + 0.5);
+        columnHitOffsets[col + 1] = GetColumnHits(px, py, col, NULL);
+    }
+    for (size_t col = 0; col < numOfColumns; col++)
+        columnHitOffsets[col + 1] += columnHitOffsets[col];
+    columnHits.resize(columnHitOffsets[numOfColumns]);
+#pragma omp parallel for schedule(dynamic)
+    for (long long col = 0; col < (long long)numOfColumns; col++) {
+        const double px = origin.x + cubeLength * (col / ny + 0.5);
+        const double py = origin.y + cubeLength * (col % ny + 0.5);
+        double* zHits = &columnHits[0] + columnHitOffsets[col];
+        const size_t n = GetColumnHits(px, py, col, zHits);
+        std::sort(zHits, zHits + n);
+    }
+}
+
+size_t Voxelizer::GetColumnHits(const double px, const double py, const size_t col, double* zHits) const
+{
+    size_t n = 0;
+    for (size_t i = columnTriOffsets[col]; i < columnTriOffsets[col + 1]; i++) {
+        const glm::dvec3* tri = &triangles[3 * columnTriIds[i]];
+        const glm::dvec3& a = tri[0];
+        const bool ccw = EdgeFunction(a, tri[1], tri[2].x, tri[2].y) > 0.0;
+        const glm::dvec3& b = ccw ? tri[1] : tri[2];
+        const glm::dvec3& c = ccw ? tri[2] : tri[1];
+        const double area = EdgeFunction(a, b, c.x, c.y);
+        if (area <= 0.0) continue;  // vertical in xy, never crossed by a z scanline
+        const double w0 = EdgeFunction(b, c, px, py);
+        const double w1 = EdgeFunction(c, a, px, py);
+        const double w2 = EdgeFunction(a, b, px, py);
+        if (!IsInsideEdge(b, c, w0) || !IsInsideEdge(c, a, w1) || !IsInsideEdge(a, b, w2)) continue;
+        if (zHits) zHits[n] = (w0 * a.z + w1 * b.z + w2 * c.z) / area;
+        n++;
+    }
+    return n;
+}
+
+void Voxelizer::GetSlabInside(const long long i, std::vector<unsigned char>& inside) const
+{
+    const long long nx = xTotalStep - 1, ny = yTotalStep - 1, nz = zTotalStep - 1;
+    if (i < 0 || i >= nx) {
+        std::fill(inside.begin(), inside.end(), 0);
+        return;
+    }
+    for (long long j = 0; j < ny; j++) {
+        const size_t col = i * ny + j;
+        const double* hit = &columnHits[0] + columnHitOffsets[col];
+        const double* hitEnd = &columnHits[0] + columnHitOffsets[col + 1];
+        unsigned char parity = 0;
+        for (long long k = 0; k < nz; k++) {
+            const double zc = origin.z + cubeLength * (k + 0.5);
+            while (hit != hitEnd && *hit < zc) {
+                parity ^= 1;
+                ++hit;
+            }
+            inside[j * nz + k] = parity;
+        }
+    }
+}
+
+size_t Voxelizer::GetPlaneVids(const std::vector<unsigned char>& lowerSlab, const std::vector<unsigned char>& upperSlab, std::vector<unsigned int>& localVids) const
+{
+    const long long ny = yTotalStep, nz = zTotalStep;
+    unsigned int n = 0;
+    for (long long j = 0; j < ny; j++)
+        for (long long k = 0; k < nz; k++) {
+            bool used = false;
+            for (long long cj = j - 1; cj <= j && !used; cj++)
+                for (long long ck = k - 1; ck <= k && !used; ck++) {
+                    if (cj < 0 || ck < 0 || cj >= ny - 1 || ck >= nz - 1) continue;
+                    const size_t cell = cj * (nz - 1) + ck;
+                    used = lowerSlab[cell] || upperSlab[cell];
+                }
+            localVids[j * nz + k] = used ? n++ : (unsigned int)-1;
+        }
+    return n;
+}
+
+bool Voxelizer::IsPointInside(const glm::dvec3& p) const
+{
+    const long long nx = xTotalStep - 1, ny = yTotalStep - 1;
+    const long long i = (long long)floor((p.x - origin.x) / cubeLength);
+    const long long j = (long long)floor((p.y - origin.y) / cubeLength);
+    if (i < 0 || j < 0 || i >= nx || j >= ny) return false;
+    const size_t col = i * ny + j;
+    std::vector<double> zHits(columnTriOffsets[col + 1] - columnTriOffsets[col]);
+    const size_t n = zHits.empty() ? 0 : GetColumnHits(p.x, p.y, col, &zHits[0]);
+    size_t below = 0;
+    for (size_t k = 0; k < n; k++)
+        if (zHits[k] < p.z) below++;
+    return below % 2 != 0;
+}
+
+void Voxelizer::GetMesh(Mesh& hexMesh) const
+{
+    hexMesh.V.resize(X.size());
+    for (size_t i = 0; i < X.size(); i++) {
+        hexMesh.V[i] = glm::dvec3(X[i], Y[i], Z[i]);
+        hexMesh.V[i].id = i;
+    }
+    const size_t numOfCells = Vids.size() / 8;
+    hexMesh.C.resize(numOfCells);
+    for (size_t i = 0; i < numOfCells; i++) {
+        hexMesh.C[i].Vids.assign(Vids.begin() + 8 * i, Vids.begin() + 8 * i + 8);
+        hexMesh.C[i].id = i;
+    }
+    hexMesh.m_cellType = HEXAHEDRA;
+}
+
+void Voxelizer::WriteVtk(const char* filename) const
+{
+    const size_t vnum = X.size();
+    const size_t cnum = Vids.size() / 8;
+
+    std::ofstream ofs(filename);
+    ofs << "# vtk DataFile Version 3.0\n"
+        << filename << "\n"
+        << "ASCII\n\n"
+        << "DATASET UNSTRUCTURED_GRID\n";
+    ofs << "POINTS " << vnum << " double\n";
+    for (size_t i = 0; i < vnum; i++)
+        ofs << std::fixed << std::setprecision(7) << X[i] << " " << Y[i] << " " << Z[i] << "\n";
+    ofs << "CELLS " << cnum << " " << 9 * cnum << "\n";
+    for (size_t i = 0; i < cnum; i++) {
+        ofs << 8;
+        for (size_t j = 0; j < 8; j++)
+            ofs << " " << Vids[8 * i + j];
+        ofs << "\n";
+    }
+    ofs << "CELL_TYPES " << cnum << "\n";
+    for (size_t i = 0; i < cnum; i++)
+        ofs << VTK_HEXAHEDRON << "\n";
+}
@@ -0,0 +1,61 @@
+/*
+ * Voxelizer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: cotrik
+ */
+
+#ifndef LIBCOTRIK_SRC_VOXELIZER_H_
+#define LIBCOTRIK_SRC_VOXELIZER_H_
+
+#include "Mesh.h"
+
+// Scanline voxelizer, classifies the cell centers of a regular grid column by column
+// against the boundary surface and emits only the interior hexahedra.
+class Voxelizer
+{
+public:
+    Voxelizer(const Mesh& mesh);
+    virtual ~Voxelizer();
+private:
+    Voxelizer();
+    Voxelizer(const Voxelizer&);
+    Voxelizer& operator = (const Voxelizer&);
+public:
+    void Run(const size_t numberOfGridsPerAxis = 50);
+    bool IsPointInside(const glm::dvec3& p) const;
+    void GetMesh(Mesh& hexMesh) const;
+    void WriteVtk(const char* filename) const;
+
+private:
+    void BuildTriangles();
+    void BuildGrid(const size_t numberOfGridsPerAxis);
+    void BuildColumnHits();
+    size_t GetColumnHits(const double px, const double py, const size_t col, double* zHits) const;
+    void GetSlabInside(const long long i, std::vector<unsigned char>& inside) const;
+    size_t GetPlaneVids(const std::vector<unsigned char>& lowerSlab, const std::vector<unsigned char>& upperSlab, std::vector<unsigned int>& localVids) const;
+
+public:
+    // SoA coordinates of the emitted vertices
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<double> Z;
+    // 8 vertex ids per interior hex, same corner order as HexGen's cube mesh
+    std::vector<unsigned int> Vids;
+
+    glm::dvec3 origin;
+    double cubeLength = 0.0;
+    size_t xTotalStep = 0;  // number of grid points per axis
+    size_t yTotalStep = 0;
+    size_t zTotalStep = 0;
+
+private:
+    const Mesh& mesh;
+    std::vector<glm::dvec3> triangles;          // 3 corners per boundary triangle
+    std::vector<size_t> columnTriOffsets;       // CSR over (x, y) cell columns
+    std::vector<size_t> columnTriIds;           // triangles whose xy bounding box overlaps the column
+    std::vector<size_t> columnHitOffsets;       // CSR over (x, y) cell columns
+    std::vector<double> columnHits;             // sorted z of the surface crossings at the column center
+};
+
+#endif /* LIBCOTRIK_SRC_VOXELIZER_H_ */
@@ -467,75 +467,10 @@ void WeightedMeshOptFixBoundary::ComputeMeshTargetLength()
     std::cout << "=============================\n";
     std::cout << "   Computing TargetLength    \n";
 
-    std::vector<Trip> coefficients;
-    std::vector<float> b;
-    size_t row  = 0;
-    size_t numOfparallelEids = 0;
-    size_t numOfconsecutiveEids = 0;
-    for (size_t i = 0; i < mesh.E.size(); i++) {
-        coefficients.push_back(Trip(row, i, 1));
-        if (mesh.E[i].isBoundary) b.push_back(mesh.E[i].length);
-        else
-            b.push_back(avgMeshEdgeLength);
-        row++;
-
-        for (size_t j = 0; j < mesh.E[i].parallelEids.size(); j++) {
-            size_t N_Eid = mesh.E[i].parallelEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfparallelEids++;
-            row++;
-        }
-        for (size_t j = 0; j < mesh.E[i].consecutiveEids.size(); j++) {
-            size_t N_Eid = mesh.E[i].consecutiveEids[j];
-            coefficients.push_back(Trip(row, i, 1));
-            coefficients.push_back(Trip(row, N_Eid, -1));
-            b.push_back(0);
-            numOfconsecutiveEids++;
-            row++;
-        }
-    }
-
-    for (size_t k = 0; k < mesh.E.size(); k++) {
-        const Edge& edge = mesh.E.at(k);
-        if (!edge.isSingularity) continue;
-        if (edge.N_Cids.size() != 5 && edge.N_Cids.size() != 3 && edge.N_Cids.size() != 6) continue;
-        for (size_t j = 0; j < edge.orthogonalEids.size(); j++) {
-            for (size_t i = 0; i < edge.orthogonalEids.size(); i++) {
-                if (j == i) continue;
-                const size_t edgeId1 = edge.orthogonalEids.at(j);
-                const size_t edgeId2 = edge.orthogonalEids.at(i);
-                /*const */Edge& edge1 = mesh.E.at(edgeId1);
-                /*const */Edge& edge2 = mesh.E.at(edgeId2);
-                const size_t vId1_1 = edge1.Vids.at(0);
-                const size_t vId1_2 = edge1.Vids.at(1);
-                const size_t vId2_1 = edge2.Vids.at(0);
-                const size_t vId2_2 = edge2.Vids.at(1);
-                if (vId1_1 != vId2_1 && vId1_1 != vId2_2 && vId1_2 != vId2_1 && vId1_2 != vId2_2) continue;
-
-                coefficients.push_back(Trip(row, edge1.id, 1));
-                coefficients.push_back(Trip(row, edge2.id, -1));
-                b.push_back(0);
-                row++;
-            }
-        }
-    }
-
-    size_t col = mesh.E.size();
-
-    Eigen::SparseMatrix<float> A(row, col);
-    A.setFromTriplets(coefficients.begin(), coefficients.end());
-    Eigen::SparseMatrix<float> A_T = A.transpose();
-    Eigen::SparseMatrix<float> ATA = A_T * A;
-    //  MatrixXf ;
-    VectorXf X(col), B(row);
-    for (size_t i = 0; i < row; i++)
-        B(i) = b[i];
-
-    VectorXf ATB = A_T * B;
-    Eigen::SimplicialLDLT<SpMat> chol(ATA);
-    X = chol.solve(ATB);
+    if (!targetLengthSolver.IsBuilt())
+        targetLengthSolver.Build(true);
+    std::vector<double> X;
+    targetLengthSolver.Solve(avgMeshEdgeLength, X);
 //    for (size_t i = 0; i < mesh.E.size(); i++)
 //        mesh.E[i].length = X[i];
 
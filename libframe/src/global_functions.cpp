@@ -1,5 +1,7 @@
 #include "global_functions.h"
 #include "global_types.h"
+#include <algorithm>
+#include <array>
 
 void initialization_parameters()
 {
@@ -355,6 +357,191 @@ void construct_Fs(vector<Hex_V> &HVs, vector<Hex_E> &HEs, vector<Hex_F> &HFs, ve
 		}
 	}
 }
+void reload_hex_mesh(const vector<Hex_V> &Vs, const vector<Hex> &Hexs, vector<Hex_V> &HVs, vector<Hex> &HHs)
+{
+	HVs.clear();
+	HHs.clear();
+	HVs.resize(Vs.size());
+	HHs.resize(Hexs.size());
+#pragma omp parallel for
+	for (int i = 0; i < Vs.size(); i++)
+	{
+		Hex_V &v = HVs[i];
+		v = Hex_V();
+		v.v[0] = Vs[i].v[0];
+		v.v[1] = Vs[i].v[1];
+		v.v[2] = Vs[i].v[2];
+		v.index = i;
+		v.where_location = -1;
+		v.fixed = false;
+		v.slice_id = Vs[i].slice_id;
+	}
+	for (int i = 0; i < Hexs.size(); i++)
+	{
+		Hex &h = HHs[i];
+		h = Hex();
+		for (int j = 0; j < 8; j++)
+			h.V_Ids[j] = Hexs[i].V_Ids[j];
+		h.index = i;
+		h.frame_component = -1;
+		for (int j = 0; j < 8; j++)
+			HVs[h.V_Ids[j]].neighbor_Hs.push_back(i);
+	}
+}
+//groups the keys of the slots by their smallest vertex, firsts[s] is the first slot with the same key as s
+template<int N>
+static void first_slots_of_keys(const vector<array<int, N> > &keys, int numOfVs, vector<int> &firsts)
+{
+	vector<int> offsets(numOfVs + 1, 0);
+	for (int s = 0; s < keys.size(); s++)
+		offsets[keys[s][0] + 1]++;
+	for (int i = 0; i < numOfVs; i++)
+		offsets[i + 1] += offsets[i];
+	vector<int> slots(keys.size());
+	vector<int> cursor(offsets.begin(), offsets.end() - 1);
+	for (int s = 0; s < keys.size(); s++)
+		slots[cursor[keys[s][0]]++] = s;
+
+	firsts.resize(keys.size());
+#pragma omp parallel for schedule(dynamic, 256)
+	for (int i = 0; i < numOfVs; i++)
+	{
+		for (int j = offsets[i]; j < offsets[i + 1]; j++)
+		{
+			int s = slots[j];
+			firsts[s] = s;
+			for (int k = offsets[i]; k < j; k++)
+				if (firsts[slots[k]] == slots[k] && keys[slots[k]] == keys[s])
+				{
+					firsts[s] = slots[k];
+					break;
+				}
+		}
+	}
+}
+//numbers the distinct keys in the order of their first slot
+static int number_first_slots(const vector<int> &firsts, vector<int> &ids)
+{
+	ids.resize(firsts.size());
+	int n = 0;
+	for (int s = 0; s < firsts.size(); s++)
+		ids[s] = firsts[s] == s ? n++ : ids[firsts[s]];
+	return n;
+}
+void construct_EFs(vector<Hex_V> &HVs, vector<Hex_E> &HEs, vector<Hex_F> &HFs, vector<Hex> &HHs)
+{
+	static const int hex_edges[12][2] = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 }, { 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+	static const int hex_faces[6][4] = { { 0, 1, 2, 3 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 0, 4, 7, 3 }, { 3, 2, 6, 7 }, { 1, 2, 6, 5 } };
+	int numOfHs = HHs.size();
+
+	//edges
+	vector<array<int, 2> > ekeys(12 * numOfHs);
+#pragma omp parallel for
+	for (int i = 0; i < numOfHs; i++)
+		for (int j = 0; j < 12; j++)
+		{
+			int a = HHs[i].V_Ids[hex_edges[j][0]], b = HHs[i].V_Ids[hex_edges[j][1]];
+			ekeys[12 * i + j][0] = std::min(a, b);
+			ekeys[12 * i + j][1] = std::max(a, b);
+		}
+	vector<int> efirsts, eids;
+	first_slots_of_keys<2>(ekeys, HVs.size(), efirsts);
+	HEs.clear();
+	HEs.resize(number_first_slots(efirsts, eids));
+#pragma omp parallel for
+	for (int s = 0; s < efirsts.size(); s++)
+	{
+		if (efirsts[s] != s)
+			continue;
+		Hex_E &e = HEs[eids[s]];
+		e = Hex_E();
+		e.index = eids[s];
+		e.startend_Id[0] = HHs[s / 12].V_Ids[hex_edges[s % 12][0]];
+		e.startend_Id[1] = HHs[s / 12].V_Ids[hex_edges[s % 12][1]];
+		e.is_boundary = -1;
+		const vector<int> &hs1 = HVs[e.startend_Id[0]].neighbor_Hs, &hs2 = HVs[e.startend_Id[1]].neighbor_Hs;
+		for (int j = 0; j < hs1.size(); j++)
+			if (std::find(hs2.begin(), hs2.end(), hs1[j]) != hs2.end() && std::find(e.neighbor_Hs.begin(), e.neighbor_Hs.end(), hs1[j]) == e.neighbor_Hs.end())
+				e.neighbor_Hs.push_back(hs1[j]);
+	}
+	for (int i = 0; i < HEs.size(); i++)
+	{
+		int id1 = HEs[i].startend_Id[0], id2 = HEs[i].startend_Id[1];
+		HVs[id1].neighbor_Es.push_back(i);
+		HVs[id1].neighbor_vs.push_back(id2);
+		HVs[id2].neighbor_Es.push_back(i);
+		HVs[id2].neighbor_vs.push_back(id1);
+	}
+#pragma omp parallel for
+	for (int i = 0; i < HVs.size(); i++)
+	{
+		vector<int> &vs = HVs[i].neighbor_vs;
+		for (int j = vs.size() - 1; j > 0; j--)
+			if (std::find(vs.begin(), vs.begin() + j, vs[j]) != vs.begin() + j)
+				vs.erase(vs.begin() + j);
+	}
+
+	//faces
+	vector<array<int, 4> > fkeys(6 * numOfHs);
+#pragma omp parallel for
+	for (int i = 0; i < numOfHs; i++)
+		for (int j = 0; j < 6; j++)
+		{
+			array<int, 4> &key = fkeys[6 * i + j];
+			for (int k = 0; k < 4; k++)
+				key[k] = HHs[i].V_Ids[hex_faces[j][k]];
+			std::sort(key.begin(), key.end());
+		}
+	vector<int> ffirsts, fids;
+	first_slots_of_keys<4>(fkeys, HVs.size(), ffirsts);
+	HFs.clear();
+	HFs.resize(number_first_slots(ffirsts, fids));
+	for (int s = 0; s < ffirsts.size(); s++)
+	{
+		Hex_F &f = HFs[fids[s]];
+		if (ffirsts[s] == s)
+		{
+			f = Hex_F();
+			f.index = fids[s];
+			for (int k = 0; k < 4; k++)
+				f.cv_Ids[k] = HHs[s / 6].V_Ids[hex_faces[s % 6][k]];
+			f.frame_boundary = -1;
+		}
+		if (f.neighbor_Cs.empty() || f.neighbor_Cs.back() != s / 6)
+			f.neighbor_Cs.push_back(s / 6);
+	}
+#pragma omp parallel for
+	for (int i = 0; i < HFs.size(); i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			HFs[i].ce_Ids[j] = -1;
+			const vector<int> &es1 = HVs[HFs[i].cv_Ids[j]].neighbor_Es, &es2 = HVs[HFs[i].cv_Ids[(j + 1) % 4]].neighbor_Es;
+			for (int k = 0; k < es1.size(); k++)
+				if (std::find(es2.begin(), es2.end(), es1[k]) != es2.end())
+				{
+					HFs[i].ce_Ids[j] = es1[k];
+					break;
+				}
+		}
+	}
+	for (int i = 0; i < HFs.size(); i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			HVs[HFs[i].cv_Ids[j]].neighbor_Fs.push_back(i);
+			if (HFs[i].ce_Ids[j] != -1)
+				HEs[HFs[i].ce_Ids[j]].neighbor_Fs.push_back(i);
+		}
+		for (int j = 0; j < HFs[i].neighbor_Cs.size(); j++)
+		{
+			Hex &h = HHs[HFs[i].neighbor_Cs[j]];
+			if (h.neighbor_FS.size() < 6)
+				h.F_Ids[h.neighbor_FS.size()] = i;
+			h.neighbor_FS.push_back(i);
+		}
+	}
+}
 void determine_boundary_info(vector<Hex_V> &HVs, vector<Hex_E> &HEs, vector<Hex_F> &HFs, vector<Hex> &HHs)
 {
 	for (int i = 0; i < HFs.size(); i++)
@@ -15,6 +15,10 @@ void initialization_parameters();
 
 void construct_Es(vector<Hex_V> &HVs, vector<Hex_E> &HEs, vector<Hex> &HHs);
 void construct_Fs(vector<Hex_V> &HVs, vector<Hex_E> &HEs, vector<Hex_F> &HFs, vector<Hex> &HHs);
+//same vertices and hexes as writing Vs and Hexs with h_io::write_hex_mesh_off and reading them back
+void reload_hex_mesh(const vector<Hex_V> &Vs, const vector<Hex> &Hexs, vector<Hex_V> &HVs, vector<Hex> &HHs);
+//construct_Es and construct_Fs in one pass, keys are grouped by their smallest vertex instead of searched through the neighbors
+void construct_EFs(vector<Hex_V> &HVs, vector<Hex_E> &HEs, vector<Hex_F> &HFs, vector<Hex> &HHs);
 void determine_boundary_info(vector<Hex_V> &HVs, vector<Hex_E> &HEs, vector<Hex_F> &HFs, vector<Hex> &HHs);
 float average_len(vector<Hex_V> &HVs, vector<Hex_E> &HEs);
 void calculation_surface_centroid(vector<Hex_V> &HVs, vector<Hex_F> &HFs, vector<Hex> &HHs);
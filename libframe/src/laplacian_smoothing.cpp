@@ -54,103 +54,18 @@ void laplacian_smoothing::laplacian_average_fhs(int iter, vector<Hex_V> &hvs, ve
 	//calculation_volume_centroid(hvs,hhs);
 }
 
+//moves a boundary vertex to the closest point of tri_mesh, tri_mesh_bvh has to be up to date
 bool laplacian_smoothing::project_a_v(vector<Hex_V> &hvs, int which, bool fixornot)
 {
 	if (hvs[which].where_location == 1 && !fixornot)
 	{
-		float Min_dis = 10000;
-		int which_one = -1;
-
-		for (int j = 0; j < tri_mesh.Vs.size(); j++)
-		{
-			float dis;
-			DISTANCE(dis, hvs[which].v, tri_mesh.Vs[j].v);
-			if (Min_dis > dis)
-			{
-				Min_dis = dis;
-				which_one = j;
-			}
-		}
-
-		int which_one_inT = -1;
-		std::vector<Vertex> projected_vs;
-		std::vector<float> Diss;
-
-		std::vector<int> allneighborvs = tri_mesh.Vs[which_one].neighborv;
-		allneighborvs.push_back(which_one);
-		std::vector<int> allneighborts;
-		for (int j = 0; j < allneighborvs.size(); j++)
-		{
-			for (int k = 0; k < tri_mesh.Vs[allneighborvs[j]].neighbort.size(); k++)
-			{
-				bool havealready = false;
-				for (int m = 0; m < allneighborts.size(); m++)
-					if (tri_mesh.Vs[allneighborvs[j]].neighbort[k] == allneighborts[m])
-						havealready = true;
-				if (!havealready)
-					allneighborts.push_back(tri_mesh.Vs[allneighborvs[j]].neighbort[k]);
-			}
-		}
-		for (int j = 0; j < allneighborts.size(); j++)
-		{
-			int tid = allneighborts[j];
-
-			float x, y, z;
-			float dis;
-			bool istrue = projected_v(tri_mesh.Vs[tri_mesh.Ts[tid].triangle_v[0]].v, tri_mesh.Vs[tri_mesh.Ts[tid].triangle_v[1]].v,
-					tri_mesh.Vs[tri_mesh.Ts[tid].triangle_v[2]].v, hvs[which].v, &x, &y, &z, &dis);
-			if (istrue)
-			{
-				Vertex v;
-				v.v[0] = x;
-				v.v[1] = y;
-				v.v[2] = z;
-				projected_vs.push_back(v);
-				Diss.push_back(dis);
-				if (dis < Min_dis)
-				{
-					Min_dis = dis;
-					which_one_inT = projected_vs.size() - 1;
-				}
-			}
-		}
-		if (which_one_inT != -1)
-		{
-			hvs[which].v[0] = projected_vs[which_one_inT].v[0];
-			hvs[which].v[1] = projected_vs[which_one_inT].v[1];
-			hvs[which].v[2] = projected_vs[which_one_inT].v[2];
-		}
+		double p[3] = { hvs[which].v[0], hvs[which].v[1], hvs[which].v[2] };
+		double c[3], sqr_dis;
+		if (tri_mesh_bvh.closest_point(p, c, sqr_dis) != -1)
 		{
-			int which_one_v = -1;
-			vector<int> vidnVs = tri_mesh.Vs[which_one].neighborv;
-			for (int p = 0; p < vidnVs.size(); p++)
-			{
-				float kk = -1;
-				point_line_projection(tri_mesh.Vs[vidnVs[p]].v, tri_mesh.Vs[which_one].v, hvs[which].v, kk);
-				if (kk >= 0 && kk <= 1)
-				{
-					Vertex v_true;
-					for (int q = 0; q < 3; q++)
-					{
-						v_true.v[q] = tri_mesh.Vs[vidnVs[p]].v[q] + kk * (tri_mesh.Vs[which_one].v[q] - tri_mesh.Vs[vidnVs[p]].v[q]);
-					}
-					float dis;
-					DISTANCE(dis, hvs[which].v, v_true.v);
-					projected_vs.push_back(v_true);
-					Diss.push_back(dis);
-					if (dis < Min_dis)
-					{
-						Min_dis = dis;
-						which_one_v = projected_vs.size() - 1;
-					}
-				}
-			}
-			if (which_one_v != -1)
-			{
-				hex_mesh.HVs[which].v[0] = projected_vs[which_one_v].v[0];
-				hex_mesh.HVs[which].v[1] = projected_vs[which_one_v].v[1];
-				hex_mesh.HVs[which].v[2] = projected_vs[which_one_v].v[2];
-			}
+			hvs[which].v[0] = c[0];
+			hvs[which].v[1] = c[1];
+			hvs[which].v[2] = c[2];
 		}
 	}
 
@@ -158,6 +73,7 @@ bool laplacian_smoothing::project_a_v(vector<Hex_V> &hvs, int which, bool fixorn
 }
 void laplacian_smoothing::project_surface(vector<Hex_V> &hvs)
 {
+	update_tri_mesh_bvh();
 #pragma omp parallel for //multi-thread	for (int i = 0; i < hvs.size(); i++)	{
 		project_a_v(hvs, i, hvs[i].fixed);
 	}
@@ -291,6 +207,7 @@ void laplacian_smoothing::laplacian_inner_volume(vector<Hex_V> &hvs, vector<Hex>
 
 void laplacian_smoothing::project_surface_global(vector<Hex_V> &hvs)
 {
+	update_tri_mesh_bvh();
 #pragma omp parallel for //multi-thread	for (int i = 0; i < hvs.size(); i++)	{
 // 		if(hvs[i].fixed)
 // 			continue;
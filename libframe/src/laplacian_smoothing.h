@@ -4,6 +4,7 @@
 #include "global_types.h"
 #include "global_functions.h"
 #include "io.h"
+#include "triangle_bvh.h"
 #include <omp.h>
 class laplacian_smoothing
 {
@@ -3,6 +3,7 @@
 parameterization::parameterization(void)
 {
 	Escalar = 1.0;
+	write_off = true;
 }
 void parameterization::parameterization_main(char *path)
 {
@@ -2422,9 +2423,14 @@ void parameterization::produce_hex_mesh(vector<Parameterization_Cell> &PCs, char
 		}
 	}
 
-	char fname[300];
+	if (write_off)
+	{
+		char fname[300];
 
-	h_io io;
-	sprintf(fname, "%s%s", path, ".off");
-	io.write_hex_mesh_off(hvs, hhs, fname);
+		h_io io;
+		sprintf(fname, "%s%s", path, ".off");
+		io.write_hex_mesh_off(hvs, hhs, fname);
+	}
+	hvs_parameterized.swap(hvs);
+	hhs_parameterized.swap(hhs);
 }
@@ -23,6 +23,7 @@ class parameterization
 public:
 	vector<Hex_V> hvs_parameterized;
 	vector<Hex> hhs_parameterized;
+	bool write_off; //write the produced hex mesh to path.off, it is kept in hvs_parameterized and hhs_parameterized anyway
 public:
 
 	parameterization(void);
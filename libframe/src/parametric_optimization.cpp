@@ -61,17 +61,12 @@ void parametric_optimization::optimization_pipeline(char *fname)
 
 		if (1)
 		{
-			char pathH[300];
-			sprintf(pathH, "%s%s", fname, "Iter5_temp.off");
-			io.write_hex_mesh_off(hex_mesh.HVs, hex_mesh.HHs, pathH);
-
-			initialization_parameters();
+			vector<Hex_V> hvs;
+			vector<Hex> hhs;
+			hvs.swap(hex_mesh.HVs);
+			hhs.swap(hex_mesh.HHs);
 			{
-				io.read_hex_mesh_off(hex_mesh.HVs, hex_mesh.HHs, pathH);
-
-				construct_Es(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HHs);
-				construct_Fs(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
-				determine_boundary_info(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
+				rebuild_hex_mesh(hvs, hhs);
 
 				laps.project_surface_global(hex_mesh.HVs);
 
@@ -87,17 +82,11 @@ void parametric_optimization::optimization_pipeline(char *fname)
 			parameterization pa;
 			Para_min_N = 1;
 			sprintf(fname, "%s%d", fname, Iteration);
+			pa.write_off = i == Iteration - 1;
 			pa.parameterization_main(fname);
 
-			initialization_parameters();
 			{
-				char path[300];
-				sprintf(path, "%s%s", fname, ".off");
-				io.read_hex_mesh_off(hex_mesh.HVs, hex_mesh.HHs, path);
-
-				construct_Es(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HHs);
-				construct_Fs(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
-				determine_boundary_info(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
+				rebuild_hex_mesh(pa.hvs_parameterized, pa.hhs_parameterized);
 
 				laps.project_surface_global(hex_mesh.HVs);
 
@@ -113,6 +102,16 @@ void parametric_optimization::optimization_pipeline(char *fname)
 	std::cout << "Running time is: " << static_cast<double>(end_time - start_time) / CLOCKS_PER_SEC * 1000 << "ms" << std::endl;
 
 }
+//same as writing hvs and hhs to an OFF file and reading it back into hex_mesh, hvs and hhs are cleared
+void parametric_optimization::rebuild_hex_mesh(vector<Hex_V> &hvs, vector<Hex> &hhs)
+{
+	initialization_parameters();
+	reload_hex_mesh(hvs, hhs, hex_mesh.HVs, hex_mesh.HHs);
+	hvs.clear();
+	hhs.clear();
+	construct_EFs(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
+	determine_boundary_info(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
+}
 void parametric_optimization::optimization_pipelineF(char *fname)
 {
 	float hex_average_len = hex_mesh.average_e_len;
@@ -133,17 +132,12 @@ void parametric_optimization::optimization_pipelineF(char *fname)
 
 		if (1)
 		{
-			char pathH[300];
-			sprintf(pathH, "%s%s", fname, "Iter5_temp.off");
-			io.write_hex_mesh_off(hex_mesh.HVs, hex_mesh.HHs, pathH);
-
-			initialization_parameters();
+			vector<Hex_V> hvs;
+			vector<Hex> hhs;
+			hvs.swap(hex_mesh.HVs);
+			hhs.swap(hex_mesh.HHs);
 			{
-				io.read_hex_mesh_off(hex_mesh.HVs, hex_mesh.HHs, pathH);
-
-				construct_Es(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HHs);
-				construct_Fs(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
-				determine_boundary_info(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
+				rebuild_hex_mesh(hvs, hhs);
 				hex_mesh.average_e_len = hex_average_len;
 				calculation_centroid(hex_mesh.HVs, hex_mesh.HFs, hex_mesh.HHs);
 			}
@@ -160,15 +154,8 @@ void parametric_optimization::optimization_pipelineF(char *fname)
 			sprintf(fname, "%s%d", fname, Iteration);
 			pa.parameterization_main(fname);
 
-			initialization_parameters();
 			{
-				char path[300];
-				sprintf(path, "%s%s", fname, ".off");
-				io.read_hex_mesh_off(hex_mesh.HVs, hex_mesh.HHs, path);
-
-				construct_Es(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HHs);
-				construct_Fs(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
-				determine_boundary_info(hex_mesh.HVs, hex_mesh.HEs, hex_mesh.HFs, hex_mesh.HHs);
+				rebuild_hex_mesh(pa.hvs_parameterized, pa.hhs_parameterized);
 				hex_mesh.average_e_len = hex_average_len;
 				calculation_centroid(hex_mesh.HVs, hex_mesh.HFs, hex_mesh.HHs);
 			}
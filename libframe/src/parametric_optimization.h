@@ -64,6 +64,7 @@ public:
 	parametric_optimization(void);
 	void optimization_pipeline(char *fname);
 	void optimization_pipelineF(char *fname);
+	void rebuild_hex_mesh(vector<Hex_V> &hvs, vector<Hex> &hhs);
 
 	void optimization_pipeline_edge(int Iter);
 	void optimization_pipeline_face(int Iter, bool smooth);
@@ -0,0 +1,224 @@
+#include "triangle_bvh.h"
+#include <algorithm>
+#include <float.h>
+
+static const int BVH_LEAF_SIZE = 4;
+
+triangle_bvh tri_mesh_bvh;
+
+void update_tri_mesh_bvh()
+{
+	if (!tri_mesh_bvh.is_built_for(tri_mesh))
+		tri_mesh_bvh.build(tri_mesh);
+}
+
+triangle_bvh::triangle_bvh(void)
+{
+	built_for = NULL;
+	built_nv = -1;
+	built_nt = -1;
+}
+triangle_bvh::~triangle_bvh(void)
+{
+}
+bool triangle_bvh::is_built_for(const Tri_Mesh_Info &mesh) const
+{
+	return built_for == mesh.Vs.data() && built_nv == mesh.Vs.size() && built_nt == mesh.Ts.size();
+}
+void triangle_bvh::build(const Tri_Mesh_Info &mesh)
+{
+	vs.resize(3 * mesh.Vs.size());
+	for (int i = 0; i < mesh.Vs.size(); i++)
+		for (int j = 0; j < 3; j++)
+			vs[3 * i + j] = mesh.Vs[i].v[j];
+	ts.resize(3 * mesh.Ts.size());
+	vector<double> centroids(3 * mesh.Ts.size());
+	for (int i = 0; i < mesh.Ts.size(); i++)
+		for (int j = 0; j < 3; j++)
+		{
+			ts[3 * i + j] = mesh.Ts[i].triangle_v[j];
+			centroids[3 * i + j] = 0;
+		}
+	for (int i = 0; i < mesh.Ts.size(); i++)
+		for (int j = 0; j < 3; j++)
+			for (int k = 0; k < 3; k++)
+				centroids[3 * i + k] += vs[3 * ts[3 * i + j] + k] / 3;
+
+	t_ids.resize(mesh.Ts.size());
+	for (int i = 0; i < t_ids.size(); i++)
+		t_ids[i] = i;
+	nodes.clear();
+	nodes.reserve(2 * t_ids.size() / BVH_LEAF_SIZE + 1);
+	if (!t_ids.empty())
+		build_node(0, t_ids.size(), centroids);
+
+	built_for = mesh.Vs.data();
+	built_nv = mesh.Vs.size();
+	built_nt = mesh.Ts.size();
+}
+//splits at the median centroid along the longest axis of the box
+int triangle_bvh::build_node(int begin, int end, const vector<double> &centroids)
+{
+	int id = nodes.size();
+	nodes.push_back(node());
+	node n;
+	for (int k = 0; k < 3; k++)
+	{
+		n.box_min[k] = DBL_MAX;
+		n.box_max[k] = -DBL_MAX;
+	}
+	for (int i = begin; i < end; i++)
+		for (int j = 0; j < 3; j++)
+			for (int k = 0; k < 3; k++)
+			{
+				double x = vs[3 * ts[3 * t_ids[i] + j] + k];
+				n.box_min[k] = std::min(n.box_min[k], x);
+				n.box_max[k] = std::max(n.box_max[k], x);
+			}
+	n.left = n.right = -1;
+	n.begin = begin;
+	n.end = end;
+	if (end - begin > BVH_LEAF_SIZE)
+	{
+		int axis = 0;
+		for (int k = 1; k < 3; k++)
+			if (n.box_max[k] - n.box_min[k] > n.box_max[axis] - n.box_min[axis])
+				axis = k;
+		int mid = (begin + end) / 2;
+		std::nth_element(t_ids.begin() + begin, t_ids.begin() + mid, t_ids.begin() + end,
+				[&](int a, int b) {return centroids[3 * a + axis] < centroids[3 * b + axis];});
+		n.left = build_node(begin, mid, centroids);
+		n.right = build_node(mid, end, centroids);
+	}
+	nodes[id] = n;
+	return id;
+}
+double triangle_bvh::box_sqr_distance(const node &n, const double p[3]) const
+{
+	double sqr_dis = 0;
+	for (int k = 0; k < 3; k++)
+	{
+		double d = std::max(std::max(n.box_min[k] - p[k], p[k] - n.box_max[k]), 0.0);
+		sqr_dis += d * d;
+	}
+	return sqr_dis;
+}
+//Ericson, Real-Time Collision Detection, 5.1.5
+void triangle_bvh::closest_point_triangle(int tid, const double p[3], double c[3]) const
+{
+	const double *a = &vs[3 * ts[3 * tid]], *b = &vs[3 * ts[3 * tid + 1]], *cc = &vs[3 * ts[3 * tid + 2]];
+	double ab[3], ac[3], ap[3], bp[3], cp[3];
+	for (int k = 0; k < 3; k++)
+	{
+		ab[k] = b[k] - a[k];
+		ac[k] = cc[k] - a[k];
+		ap[k] = p[k] - a[k];
+		bp[k] = p[k] - b[k];
+		cp[k] = p[k] - cc[k];
+	}
+	double d1 = ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2];
+	double d2 = ac[0] * ap[0] + ac[1] * ap[1] + ac[2] * ap[2];
+	if (d1 <= 0 && d2 <= 0)
+	{
+		for (int k = 0; k < 3; k++)
+			c[k] = a[k];
+		return;
+	}
+	double d3 = ab[0] * bp[0] + ab[1] * bp[1] + ab[2] * bp[2];
+	double d4 = ac[0] * bp[0] + ac[1] * bp[1] + ac[2] * bp[2];
+	if (d3 >= 0 && d4 <= d3)
+	{
+		for (int k = 0; k < 3; k++)
+			c[k] = b[k];
+		return;
+	}
+	double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0 && d1 >= 0 && d3 <= 0)
+	{
+		double t = d1 / (d1 - d3);
+		for (int k = 0; k < 3; k++)
+			c[k] = a[k] + t * ab[k];
+		return;
+	}
+	double d5 = ab[0] * cp[0] + ab[1] * cp[1] + ab[2] * cp[2];
+	double d6 = ac[0] * cp[0] + ac[1] * cp[1] + ac[2] * cp[2];
+	if (d6 >= 0 && d5 <= d6)
+	{
+		for (int k = 0; k < 3; k++)
+			c[k] = cc[k];
+		return;
+	}
+	double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0 && d2 >= 0 && d6 <= 0)
+	{
+		double t = d2 / (d2 - d6);
+		for (int k = 0; k < 3; k++)
+			c[k] = a[k] + t * ac[k];
+		return;
+	}
+	double va = d3 * d6 - d5 * d4;
+	if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+	{
+		double t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		for (int k = 0; k < 3; k++)
+			c[k] = b[k] + t * (cc[k] - b[k]);
+		return;
+	}
+	double sum = va + vb + vc;
+	if (sum == 0) //degenerate triangle, every branch above failed by rounding
+	{
+		for (int k = 0; k < 3; k++)
+			c[k] = a[k];
+		return;
+	}
+	double v = vb / sum, w = vc / sum;
+	for (int k = 0; k < 3; k++)
+		c[k] = a[k] + ab[k] * v + ac[k] * w;
+}
+int triangle_bvh::closest_point(const double p[3], double c[3], double &sqr_dis) const
+{
+	sqr_dis = DBL_MAX;
+	int which_t = -1;
+	if (nodes.empty())
+		return which_t;
+	//nearer child first, subtrees farther than the current closest point are skipped
+	int stack[128];
+	int top = 0;
+	stack[top++] = 0;
+	while (top)
+	{
+		const node &n = nodes[stack[--top]];
+		if (box_sqr_distance(n, p) >= sqr_dis)
+			continue;
+		if (n.left == -1)
+		{
+			for (int i = n.begin; i < n.end; i++)
+			{
+				double q[3];
+				closest_point_triangle(t_ids[i], p, q);
+				double d = (q[0] - p[0]) * (q[0] - p[0]) + (q[1] - p[1]) * (q[1] - p[1]) + (q[2] - p[2]) * (q[2] - p[2]);
+				if (d < sqr_dis)
+				{
+					sqr_dis = d;
+					which_t = t_ids[i];
+					c[0] = q[0];
+					c[1] = q[1];
+					c[2] = q[2];
+				}
+			}
+			continue;
+		}
+		double dl = box_sqr_distance(nodes[n.left], p), dr = box_sqr_distance(nodes[n.right], p);
+		if (dl < dr)
+		{
+			stack[top++] = n.right;
+			stack[top++] = n.left;
+		}
+		else
+		{
+			stack[top++] = n.left;
+			stack[top++] = n.right;
+		}
+	}
+	return which_t;
+}
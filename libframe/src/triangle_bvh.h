@@ -0,0 +1,41 @@
+#ifndef __TRIANGLE_BVH_H__
+#define __TRIANGLE_BVH_H__
+//bounding volume hierarchy over the triangles of a triangle mesh, closest point queries in double precision.
+#include "global_types.h"
+
+class triangle_bvh
+{
+	struct node
+	{
+		double box_min[3];
+		double box_max[3];
+		int left; //-1 for leaves
+		int right;
+		int begin; //range in t_ids for leaves
+		int end;
+	};
+	vector<node> nodes;
+	vector<int> t_ids;
+	vector<double> vs; //coordinates of the vertices, 3 per vertex
+	vector<int> ts; //vertex ids of the triangles, 3 per triangle
+	const Vertex *built_for;
+	int built_nv, built_nt;
+public:
+	triangle_bvh(void);
+	void build(const Tri_Mesh_Info &mesh);
+	bool is_built_for(const Tri_Mesh_Info &mesh) const;
+	//closest point c on the triangles to p, returns the triangle id, -1 if there are no triangles
+	int closest_point(const double p[3], double c[3], double &sqr_dis) const;
+	~triangle_bvh(void);
+private:
+	int build_node(int begin, int end, const vector<double> &centroids);
+	double box_sqr_distance(const node &n, const double p[3]) const;
+	void closest_point_triangle(int tid, const double p[3], double c[3]) const;
+};
+
+//bvh of tri_mesh shared by the surface projections
+extern triangle_bvh tri_mesh_bvh;
+//rebuilds tri_mesh_bvh if tri_mesh was reloaded, call before projecting in parallel
+void update_tri_mesh_bvh();
+
+#endif // __TRIANGLE_BVH_H__
@@ -88,6 +88,28 @@ typedef struct hmCholeskyFactor {
 #endif /* HM_USE_HSLMA87 */
 /* ===================== END HSLMA87 IMPLEMENTATION ===================== */
 
+/* ======================== EIGEN IMPLEMENTATION ======================== */
+#ifdef HM_USE_EIGEN
+
+/** \brief Cholesky factor \f$L\f$ for a real symmetric positive-definite sparse matrix \f$A = LDL^T\f$.
+ *
+ */
+typedef struct hmCholeskyFactor {
+
+   /** \brief Dimension of factored matrix. */
+   int degree;
+
+   /** \brief Flags whether the symbolic factorization in hmCholeskyFactor::data is valid. */
+   char analyzed;
+
+   /** \brief Factorization in Eigen SimplicialLDLT format (opaque to keep this header plain C). */
+   void *data;
+
+} hmCholeskyFactor;
+
+#endif /* HM_USE_EIGEN */
+/* ====================== END EIGEN IMPLEMENTATION ====================== */
+
 /** \brief Constructor.
  *
  * @param factor Target object.
@@ -120,8 +142,8 @@ void hmCholeskyFactorCopy( hmCholeskyFactor* factor1,
 /** \brief Computes a fill-reducing matrix reordering.
  *
  * When using HSL_MA87, the reordering scheme can be specified
- * in the file hmConstants.h.  When using CHOLMOD, this routine
- * is ignored since the reordering is computed at the same time
+ * in the file hmConstants.h.  When using CHOLMOD or Eigen, this routine
+ * is ignored since the reordering (AMD) is computed at the same time
  * as the symbolic factorization (in hmCholeskyFactorSymbolic()).
  *
  * @param factor Target object.
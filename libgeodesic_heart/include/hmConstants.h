@@ -42,9 +42,12 @@
 #ifndef LIBGEODESIC_HMCONSTANTS_H
 #define LIBGEODESIC_HMCONSTANTS_H
 
-/* select a linear solver */
-#define HM_USE_CHOLMOD
-#undef  HM_USE_HSLMA87
+/* select a linear solver (CHOLMOD or HSL_MA87 can be chosen with
+ * -DHM_USE_CHOLMOD / -DHM_USE_HSLMA87; the self-contained Eigen
+ * backend is used otherwise) */
+#if !defined(HM_USE_CHOLMOD) && !defined(HM_USE_HSLMA87)
+#define HM_USE_EIGEN
+#endif
 
 /* linear solver parameters */
 #ifdef HM_USE_HSLMA87
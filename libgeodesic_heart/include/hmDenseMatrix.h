@@ -85,6 +85,26 @@ typedef struct hmDenseMatrix {
 #endif /* HM_USE_HSLMA87 */
 /* ===================== END HSLMA87 IMPLEMENTATION ===================== */
 
+/* ======================== EIGEN IMPLEMENTATION ======================== */
+#ifdef HM_USE_EIGEN
+
+/** \brief Real dense matrix. */
+typedef struct hmDenseMatrix {
+
+   /** \brief Number of rows. */
+   size_t nRows;
+
+   /** \brief Number of columns. */
+   size_t nColumns;
+
+   /** \brief Values of entries, stored in column-major order. */
+   double* values;
+
+} hmDenseMatrix;
+
+#endif /* HM_USE_EIGEN */
+/* ====================== END EIGEN IMPLEMENTATION ====================== */
+
 /** \brief Constructor.
  *
  * @param matrix Target object.
@@ -105,6 +105,35 @@ typedef struct hmSparseMatrix {
 #endif /* HM_USE_HSLMA87 */
 /* ===================== END HSLMA87 IMPLEMENTATION ===================== */
 
+/* ======================== EIGEN IMPLEMENTATION ======================== */
+#ifdef HM_USE_EIGEN
+
+/** \brief Real sparse matrix in compressed column format; symmetric matrices keep only the lower triangle. */
+typedef struct hmSparseMatrix {
+
+   /** \brief Number of rows. */
+   size_t nRows;
+
+   /** \brief Number of columns. */
+   size_t nColumns;
+
+   /** \brief Number of nonzero entries. */
+   size_t nNonZeros;
+
+   /** \brief Values of nonzero entries. */
+   double* values;
+
+   /** \brief Row indices of nonzero entries. */
+   int* rowIndices;
+
+   /** \brief Starting indices for nonzeros in each column. */
+   int* columnStart;
+
+} hmSparseMatrix;
+
+#endif /* HM_USE_EIGEN */
+/* ====================== END EIGEN IMPLEMENTATION ====================== */
+
 /** \brief Constructor.
  *
  * Builds an empty matrix.
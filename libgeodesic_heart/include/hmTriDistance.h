@@ -108,6 +108,10 @@ typedef struct hmTriDistance {
     * \brief Divergence \f$\nabla \cdot X\f$ of normalized vector field \f$X\f$. [1 x surface->nVertices] */
    hmDenseMatrix potential;
 
+   /** \private
+    * \brief Per-face contributions to the potential, computed in parallel before accumulation. [3*surface->nFaces x 1] */
+   hmDenseMatrix faceDivergence;
+
    /** \private
     * \brief Conformal (i.e., weak) Laplacian \f$L_C\f$. */
    hmSparseMatrix laplacian;
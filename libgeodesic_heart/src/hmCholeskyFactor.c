@@ -187,3 +187,121 @@ void hmCholeskyFactorBacksolve( hmCholeskyFactor* factor,
 #endif /* HM_USE_HSLMA87 */
 /* ===================== END HSLMA87 IMPLEMENTATION ===================== */
 
+
+/* ======================== EIGEN IMPLEMENTATION ======================== */
+#ifdef HM_USE_EIGEN
+#include <Eigen/Sparse>
+
+typedef Eigen::SparseMatrix<double, Eigen::ColMajor, int> hmEigenSparseMatrix;
+typedef Eigen::SimplicialLDLT<hmEigenSparseMatrix, Eigen::Lower, Eigen::AMDOrdering<int> > hmEigenFactor;
+
+/* views the lower triangle stored in matrix as an Eigen matrix (no copy) */
+static Eigen::Map<const hmEigenSparseMatrix> hmEigenMap( const hmSparseMatrix* matrix )
+{
+   return Eigen::Map<const hmEigenSparseMatrix>(
+         (int)matrix->nRows,
+         (int)matrix->nColumns,
+         (int)matrix->nNonZeros,
+         matrix->columnStart,
+         matrix->rowIndices,
+         matrix->values
+      );
+}
+
+void hmCholeskyFactorInitialize( hmCholeskyFactor* factor )
+{
+   factor->degree   = 0;
+   factor->analyzed = 0;
+   factor->data     = NULL;
+}
+
+void hmCholeskyFactorDestroy( hmCholeskyFactor* factor )
+{
+   if( factor->data != NULL )
+   {
+      delete (hmEigenFactor*)factor->data;
+      factor->data = NULL;
+   }
+   factor->analyzed = 0;
+}
+
+void hmCholeskyFactorCopy( hmCholeskyFactor* factor1,
+                           hmCholeskyFactor* factor2 )
+{
+   hmCholeskyFactorDestroy( factor1 );
+
+   /* Eigen factors are not copyable; the symbolic factorization is
+    * redone on the first numerical factorization instead */
+   factor1->degree   = factor2->degree;
+   factor1->analyzed = 0;
+   factor1->data     = new hmEigenFactor();
+}
+
+void hmCholeskyFactorReorder( hmCholeskyFactor* factor,
+                              hmSparseMatrix* matrix )
+{
+   (void)factor;
+   (void)matrix;
+}
+
+void hmCholeskyFactorSymbolic( hmCholeskyFactor* factor,
+                               hmSparseMatrix* matrix )
+{
+   hmEigenFactor* solver;
+
+   /* clear the old factor if already built */
+   hmCholeskyFactorDestroy( factor );
+
+   factor->degree = (int)matrix->nColumns;
+   solver = new hmEigenFactor();
+   solver->analyzePattern( hmEigenMap( matrix ));
+   factor->data     = solver;
+   factor->analyzed = 1;
+}
+
+void hmCholeskyFactorNumerical( hmCholeskyFactor* factor,
+                                hmSparseMatrix* matrix )
+{
+   hmEigenFactor* solver;
+
+   if( factor->data == NULL )
+   {
+      factor->data = new hmEigenFactor();
+   }
+   solver = (hmEigenFactor*)factor->data;
+   factor->degree = (int)matrix->nColumns;
+
+   if( !factor->analyzed )
+   {
+      solver->analyzePattern( hmEigenMap( matrix ));
+      factor->analyzed = 1;
+   }
+
+   /* build numerical factorization */
+   solver->factorize( hmEigenMap( matrix ));
+   if( solver->info() != Eigen::Success )
+   {
+      fprintf( stderr, "Error: hmCholeskyFactorNumerical -- factorization failed!\n" );
+      exit( 1 );
+   }
+}
+
+void hmCholeskyFactorBacksolve( hmCholeskyFactor* factor,
+                                      hmDenseMatrix* x,
+                                const hmDenseMatrix* b )
+{
+   const hmEigenFactor* solver = (const hmEigenFactor*)factor->data;
+
+   /* reuse the storage of x when it already has the right shape */
+   if( x->nRows != b->nRows || x->nColumns != b->nColumns || x->values == NULL )
+   {
+      hmDenseMatrixDestroy( x );
+      hmDenseMatrixInitialize( x, b->nRows, b->nColumns );
+   }
+
+   Eigen::Map<Eigen::MatrixXd>( x->values, b->nRows, b->nColumns ) =
+      solver->solve( Eigen::Map<const Eigen::MatrixXd>( b->values, b->nRows, b->nColumns ));
+}
+
+#endif /* HM_USE_EIGEN */
+/* ====================== END EIGEN IMPLEMENTATION ====================== */
@@ -48,3 +48,20 @@ void hmContextDestroy( hmContext* context )
 #endif /* HM_USE_CHOLMOD */
 /* ===================== END CHOLMOD IMPLEMENTATION ===================== */
 
+
+/* ======================== EIGEN IMPLEMENTATION ======================== */
+#ifdef HM_USE_EIGEN
+
+void hmContextInitialize( hmContext* context )
+{
+   /* Eigen needs no global state */
+   context->initialized = 1;
+}
+
+void hmContextDestroy( hmContext* context )
+{
+   context->initialized = 0;
+}
+
+#endif /* HM_USE_EIGEN */
+/* ====================== END EIGEN IMPLEMENTATION ====================== */
@@ -98,3 +98,42 @@ void hmDenseMatrixCopy(       hmDenseMatrix* matrix1,
 #endif /* HM_USE_HSLMA87 */
 /* ===================== END HSLMA87 IMPLEMENTATION ===================== */
 
+
+/* ======================== EIGEN IMPLEMENTATION ======================== */
+#ifdef HM_USE_EIGEN
+
+void hmDenseMatrixInitialize( hmDenseMatrix* matrix,
+                              size_t nRows,
+                              size_t nColumns )
+{
+   matrix->nRows    = nRows;
+   matrix->nColumns = nColumns;
+
+   matrix->values = (double*)malloc( nRows*nColumns * sizeof(double));
+}
+
+void hmDenseMatrixDestroy( hmDenseMatrix* matrix )
+{
+   matrix->nRows    = 0;
+   matrix->nColumns = 0;
+
+   hmDestroy( matrix->values );
+}
+
+void hmDenseMatrixCopy(       hmDenseMatrix* matrix1,
+                        const hmDenseMatrix* matrix2 )
+{
+   size_t nEntries;
+
+   hmDenseMatrixDestroy( matrix1 );
+
+   matrix1->nRows    = matrix2->nRows;
+   matrix1->nColumns = matrix2->nColumns;
+   nEntries = matrix2->nRows * matrix2->nColumns;
+
+   matrix1->values = (double*)malloc( nEntries * sizeof( double ));
+   memcpy( matrix1->values, matrix2->values, nEntries * sizeof(double));
+}
+
+#endif /* HM_USE_EIGEN */
+/* ====================== END EIGEN IMPLEMENTATION ====================== */
@@ -84,3 +84,33 @@ void hmSparseMatrixDestroy( hmSparseMatrix* matrix )
 #endif /* HM_USE_HSLMA87 */
 /* ===================== END HSLMA87 IMPLEMENTATION ===================== */
 
+
+/* ======================== EIGEN IMPLEMENTATION ======================== */
+#ifdef HM_USE_EIGEN
+
+void hmSparseMatrixInitialize( hmSparseMatrix* matrix,
+                               size_t nRows,
+                               size_t nColumns,
+                               size_t nNonZeros )
+{
+   matrix->nRows       = nRows;
+   matrix->nColumns    = nColumns;
+   matrix->nNonZeros   = nNonZeros;
+   matrix->values      = (double*)malloc( nNonZeros    * sizeof(double));
+   matrix->rowIndices  = (int*)   malloc( nNonZeros    * sizeof(int));
+   matrix->columnStart = (int*)   malloc( (nColumns+1) * sizeof(int));
+}
+
+void hmSparseMatrixDestroy( hmSparseMatrix* matrix )
+{
+   hmDestroy( matrix->values      );
+   hmDestroy( matrix->rowIndices  );
+   hmDestroy( matrix->columnStart );
+
+   matrix->nRows     = 0;
+   matrix->nColumns  = 0;
+   matrix->nNonZeros = 0;
+}
+
+#endif /* HM_USE_EIGEN */
+/* ====================== END EIGEN IMPLEMENTATION ====================== */
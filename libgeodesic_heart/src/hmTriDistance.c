@@ -20,6 +20,7 @@ void hmTriDistanceInitialize( hmTriDistance* distance )
    hmDenseMatrixInitialize( &distance->heatNeumann,   0, 0 );
    hmDenseMatrixInitialize( &distance->heatDirichlet, 0, 0 );
    hmDenseMatrixInitialize( &distance->potential,     0, 0 );
+   hmDenseMatrixInitialize( &distance->faceDivergence, 0, 0 );
 
    hmSparseMatrixInitialize( &distance->laplacian,         0, 0, 0 );
    hmSparseMatrixInitialize( &distance->heatFlowNeumann,   0, 0, 0 );
@@ -43,6 +44,7 @@ void hmTriDistanceDestroy( hmTriDistance* distance )
    hmDenseMatrixDestroy( &distance->heatNeumann );
    hmDenseMatrixDestroy( &distance->heatDirichlet );
    hmDenseMatrixDestroy( &distance->potential );
+   hmDenseMatrixDestroy( &distance->faceDivergence );
 
    hmSparseMatrixDestroy( &distance->laplacian );
    hmSparseMatrixDestroy( &distance->heatFlowNeumann );
@@ -117,6 +119,7 @@ void hmTriDistanceBuild( hmTriDistance* distance )
    hmDenseMatrixInitialize( &distance->isSource,  nVertices, 1 );
    hmDenseMatrixInitialize( &distance->distance,  nVertices, 1 );
    hmDenseMatrixInitialize( &distance->potential, nVertices, 1 );
+   hmDenseMatrixInitialize( &distance->faceDivergence, 3*distance->surface->nFaces, 1 );
 
    /* only allocate space for both solutions if necessary */
    if( distance->boundaryConditions < 1. ) /* partial Neumann */
@@ -206,87 +209,94 @@ void hmTriDistanceSolveHeatEquation( hmTriDistance* distance )
 void hmTriDistanceComputePotential( hmTriDistance* distance )
 {
    /* array counters */
-   size_t i;
+   long i;
 
    /* local data handles */
    size_t nFaces    = distance->surface->nFaces;
    int nVertices = distance->surface->nVertices;
-   const size_t*         f = distance->surface->faces;
-   const double*         w = distance->surface->weights;
-   const double*      heat = distance->heat;
-         double* potential = distance->potential.values;
-
-   /* current triangle data */
-   double u0, u1, u2; /* heat values */
-   double rMag; /* reciprocal of magnitude */
-   double *t0, *t1, *t2; /* edge normals */
-   double *e0, *e1, *e2; /* cotan-weighted edge vectors */
-   hmVec3 X; /* normalized gradient */
-   double e0DotX, e1DotX, e2DotX;
+   const size_t*            faces = distance->surface->faces;
+   const double*      edgeNormals = distance->surface->edgeNormals;
+   const double*    weightedEdges = distance->surface->weightedEdges;
+   const double*             heat = distance->heat;
+         double*        potential = distance->potential.values;
+         double*   faceDivergence = distance->faceDivergence.values;
+   const size_t* f;
+   const double* d;
+
+   /* compute the contribution of each face independently */
+#pragma omp parallel for schedule(static)
+   for( i = 0; i < (long)nFaces; i++ )
+   {
+      /* current triangle data */
+      const size_t* fi = &faces[ 3*i ];
+      const double* t0 = &edgeNormals[ 9*i ]; /* edge normals */
+      const double* t1 = t0 + 3;
+      const double* t2 = t0 + 6;
+      const double* e0 = &weightedEdges[ 9*i ]; /* cotan-weighted edge vectors */
+      const double* e1 = e0 + 3;
+      const double* e2 = e0 + 6;
+      double* div = &faceDivergence[ 3*i ];
+      double u0, u1, u2; /* heat values */
+      double rMag; /* reciprocal of magnitude */
+      hmVec3 X; /* normalized gradient */
+      double e0DotX, e1DotX, e2DotX;
 
-   /* initialize potential to zero */
-   hmClearArrayDouble( potential, distance->surface->nVertices, 0. );
+      /* get heat values at three vertices */
+      u0 = fabs( heat[ fi[0] ] );
+      u1 = fabs( heat[ fi[1] ] );
+      u2 = fabs( heat[ fi[2] ] );
 
-   /* get pointers to first three edge normals */
-   t0 = &distance->surface->edgeNormals[0];
-   t1 = &distance->surface->edgeNormals[3];
-   t2 = &distance->surface->edgeNormals[6];
+      /* normalize heat values so that they have roughly unit magnitude */
+      rMag = 1./hmMaxDouble( hmMaxDouble( u0, u1 ), u2 );
+      if( isinf(rMag) )
+      {
+         div[0] = div[1] = div[2] = 0.;
+         continue;
+      }
+      u0 *= rMag;
+      u1 *= rMag;
+      u2 *= rMag;
+
+      /* compute normalized gradient */
+      X[0] = u0*t0[0] + u1*t1[0] + u2*t2[0];
+      X[1] = u0*t0[1] + u1*t1[1] + u2*t2[1];
+      X[2] = u0*t0[2] + u1*t1[2] + u2*t2[2];
+      hmVec3Normalize( X );
+
+      /* contribution to divergence */
+      e0DotX = hmVec3Dot( e0, X );
+      e1DotX = hmVec3Dot( e1, X );
+      e2DotX = hmVec3Dot( e2, X );
+      div[0] = e1DotX - e2DotX;
+      div[1] = e2DotX - e0DotX;
+      div[2] = e0DotX - e1DotX;
+   }
 
-   /* get pointers to first three weighted edges */
-   e0 = &distance->surface->weightedEdges[0];
-   e1 = &distance->surface->weightedEdges[3];
-   e2 = &distance->surface->weightedEdges[6];
+   /* initialize potential to zero */
+   hmClearArrayDouble( potential, distance->surface->nVertices, 0. );
 
    /* add contribution from each face */
-   for( i = 0; i < nFaces; i++ )
+   f = faces;
+   d = faceDivergence;
+   for( i = 0; i < (long)nFaces; i++ )
    {
-      /* get heat values at three vertices */
-      u0 = fabs( heat[ f[0] ] );
-      u1 = fabs( heat[ f[1] ] );
-      u2 = fabs( heat[ f[2] ] );
+      potential[ f[0] ] -= d[0];
+      potential[ f[1] ] -= d[1];
+      potential[ f[2] ] -= d[2];
 
-      /* normalize heat values so that they have roughly unit magnitude */
-      rMag = 1./hmMaxDouble( hmMaxDouble( u0, u1 ), u2 );
-      if( !isinf(rMag) )
+      if( isnan( potential[f[0]] ) ||
+          isnan( potential[f[1]] ) ||
+          isnan( potential[f[2]] ) )
       {
-         u0 *= rMag;
-         u1 *= rMag;
-         u2 *= rMag;
-
-         /* compute normalized gradient */
-         X[0] = u0*t0[0] + u1*t1[0] + u2*t2[0];
-         X[1] = u0*t0[1] + u1*t1[1] + u2*t2[1];
-         X[2] = u0*t0[2] + u1*t1[2] + u2*t2[2];
-         hmVec3Normalize( X );
-
-         /* add contribution to divergence */
-         e0DotX = hmVec3Dot( e0, X );
-         e1DotX = hmVec3Dot( e1, X );
-         e2DotX = hmVec3Dot( e2, X );
-         potential[ f[0] ] -= e1DotX - e2DotX;
-         potential[ f[1] ] -= e2DotX - e0DotX;
-         potential[ f[2] ] -= e0DotX - e1DotX;
-
-         if( isnan( potential[f[0]] ) ||
-             isnan( potential[f[1]] ) ||
-             isnan( potential[f[2]] ) )
-         {
-            fprintf( stderr, "NaN\n============\n" );
-            fprintf( stderr, "heat: %e %e %e\n", heat[f[0]], heat[f[1]], heat[f[2]] );
-            fprintf( stderr, " mag: %e\n",  hmMaxDouble( hmMaxDouble( u0, u1 ), u2 ));
-            fprintf( stderr, "rMag: %e\n", rMag );
-            fprintf( stderr, "   u: %e %e %e\n", u0, u1, u2 );
-            fprintf( stderr, "   X: %e %e %e\n", X[0], X[1], X[2] );
-            fprintf( stderr, "ei*X: %e %e %e\n", e0DotX, e1DotX, e2DotX );
-            exit( 1 );
-         }
+         fprintf( stderr, "NaN\n============\n" );
+         fprintf( stderr, "heat: %e %e %e\n", heat[f[0]], heat[f[1]], heat[f[2]] );
+         fprintf( stderr, " div: %e %e %e\n", d[0], d[1], d[2] );
+         exit( 1 );
       }
-      
+
       /* move to next face */
       f += 3;
-      w += 3;
-      t0 += 9; t1 += 9; t2 += 9;
-      e0 += 9; e1 += 9; e2 += 9;
+      d += 3;
    }
 
    /* remove mean value so that the potential is
@@ -319,19 +329,15 @@ void hmTriDistanceSolvePoissonEquation( hmTriDistance* distance )
 
 void hmTriDistanceBuildMatrices( hmTriDistance* distance )
 {
-   size_t i;
+   long i;
    size_t nVertices = distance->surface->nVertices;
    size_t nNonZeros = 0;
-   size_t nz; /* current nonzero */
    hmVectorSizeT columnStart;
    const hmVectorPairSizeTDouble* neighbors = distance->surface->vertexNeighbors;
-   char* onBoundary = distance->surface->onBoundary;
-   double columnSum;
-   char diagonalSet;
-   const hmPairSizeTDouble *neighborsBegin, *neighborsEnd, *currentNeighbor;
+   const char* onBoundary = distance->surface->onBoundary;
+   const double* vertexAreas = distance->surface->vertexAreas;
    const double boundaryConditions = distance->boundaryConditions;
    const double time = distance->time;
-   double A; /* vertex area */
 
    hmSparseMatrix* laplacian         = &distance->laplacian;
    hmSparseMatrix* heatFlowNeumann   = &distance->heatFlowNeumann;
@@ -340,33 +346,42 @@ void hmTriDistanceBuildMatrices( hmTriDistance* distance )
    /* determine the starting entry of nonzeros in
     * each column, keeping the lower triangle only */
    hmVectorSizeTInitialize( &columnStart );
-   hmVectorSizeTPushBack( &columnStart, 0 );
-   for( i = 0; i < nVertices; i++ )
+   hmVectorSizeTResize( &columnStart, nVertices+1 );
+   columnStart.entries[0] = 0;
+#pragma omp parallel for schedule(static)
+   for( i = 0; i < (long)nVertices; i++ )
    {
+      const hmPairSizeTDouble* neighborsBegin = neighbors[i].entries;
+      const hmPairSizeTDouble* neighborsEnd   = neighborsBegin + neighbors[i].size;
+      const hmPairSizeTDouble* currentNeighbor;
+
       /* add one for the diagonal entry */
-      nNonZeros++;
+      size_t nColumnNonZeros = 1;
 
       /* add one for each off-diagonal entry below the diagonal */
-      neighborsBegin = neighbors[i].entries;
-      neighborsEnd   = neighborsBegin + neighbors[i].size;
       for( currentNeighbor  = neighborsBegin;
            currentNeighbor != neighborsEnd;
            currentNeighbor ++ )
       {
-         if( currentNeighbor->n > i )
+         if( currentNeighbor->n > (size_t)i )
          {
-            nNonZeros++;
+            nColumnNonZeros++;
          }
       }
+      columnStart.entries[i+1] = nColumnNonZeros;
+   }
 
-      /* keep track of the nonzeros so far */
-      hmVectorSizeTPushBack( &columnStart, nNonZeros );
+   /* keep track of the nonzeros so far */
+   for( i = 0; i < (long)nVertices; i++ )
+   {
+      columnStart.entries[i+1] += columnStart.entries[i];
    }
+   nNonZeros = columnStart.entries[nVertices];
 
    /* initialize matrices and copy column start pointers */
    hmSparseMatrixDestroy( laplacian );
    hmSparseMatrixInitialize( laplacian, nVertices, nVertices, nNonZeros );
-   for( i = 0; i < nVertices+1; i++ )
+   for( i = 0; i < (long)nVertices+1; i++ )
    {
       distance->laplacian.columnStart[i] = columnStart.entries[i];
    }
@@ -376,7 +391,7 @@ void hmTriDistanceBuildMatrices( hmTriDistance* distance )
    {
       hmSparseMatrixDestroy( heatFlowNeumann );
       hmSparseMatrixInitialize( heatFlowNeumann,  nVertices, nVertices, nNonZeros );
-      for( i = 0; i < nVertices+1; i++ )
+      for( i = 0; i < (long)nVertices+1; i++ )
       {
          distance->heatFlowNeumann.columnStart[i] = columnStart.entries[i];
       }
@@ -385,19 +400,24 @@ void hmTriDistanceBuildMatrices( hmTriDistance* distance )
    {
       hmSparseMatrixDestroy( heatFlowDirichlet );
       hmSparseMatrixInitialize( heatFlowDirichlet,  nVertices, nVertices, nNonZeros );
-      for( i = 0; i < nVertices+1; i++ )
+      for( i = 0; i < (long)nVertices+1; i++ )
       {
          distance->heatFlowDirichlet.columnStart[i] = columnStart.entries[i];
       }
    }
 
-   /* fill nonzero entries */
-   nz = 0;
-   for( i = 0; i < nVertices; i++ )
+   /* fill nonzero entries, every column is independent */
+#pragma omp parallel for schedule(static)
+   for( i = 0; i < (long)nVertices; i++ )
    {
       /* get beginning and end of neighbor list for this vertex */
-      neighborsBegin = neighbors[i].entries;
-      neighborsEnd   = neighborsBegin + neighbors[i].size;
+      const hmPairSizeTDouble* neighborsBegin = neighbors[i].entries;
+      const hmPairSizeTDouble* neighborsEnd   = neighborsBegin + neighbors[i].size;
+      const hmPairSizeTDouble* currentNeighbor;
+      size_t nz = columnStart.entries[i]; /* current nonzero */
+      double columnSum;
+      char diagonalSet;
+      double A; /* vertex area */
 
       /* get sum of neighbors' weights */
       columnSum = 0.;
@@ -419,7 +439,7 @@ void hmTriDistanceBuildMatrices( hmTriDistance* distance )
           * a neighbor with index smaller than the index of the
           * current vertex, then insert the diagonal entry here */
          if( !diagonalSet &&
-             ( currentNeighbor == neighborsEnd || currentNeighbor->n > i ))
+             ( currentNeighbor == neighborsEnd || currentNeighbor->n > (size_t)i ))
          {
             diagonalSet = 1;
 
@@ -429,7 +449,7 @@ void hmTriDistanceBuildMatrices( hmTriDistance* distance )
             laplacian->values[ nz ] = columnSum + hmRegularization;
             laplacian->rowIndices[ nz ] = i;
 
-            A = distance->surface->vertexAreas[ i ];
+            A = vertexAreas[ i ];
 
             if( boundaryConditions < 1. ) /* partial Neumann */
             {
@@ -455,7 +475,7 @@ void hmTriDistanceBuildMatrices( hmTriDistance* distance )
 
          /* set off-diagonal entries below the diagonal */
          if( currentNeighbor < neighborsEnd &&
-             currentNeighbor->n > i )
+             currentNeighbor->n > (size_t)i )
          {
             laplacian->values[ nz ] = -currentNeighbor->x;
             laplacian->rowIndices[ nz ] = currentNeighbor->n;
@@ -483,6 +503,8 @@ void hmTriDistanceBuildMatrices( hmTriDistance* distance )
          }
       }
    }
+
+   hmVectorSizeTDestroy( &columnStart );
 }
 
 void hmTriDistanceFactorMatrices( hmTriDistance* distance )
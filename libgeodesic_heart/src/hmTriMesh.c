@@ -108,9 +108,9 @@ void hmTriMeshReferenceData( hmTriMesh* mesh,
 void hmTriMeshReadOBJ( hmTriMesh* mesh, const char* filename )
 {
    FILE* in;
-   char* line;
+   char* line = NULL;
    char token[32];
-   size_t size;
+   size_t size = 0;
    double* v;
    size_t* f;
    unsigned long I0, I1, I2;
@@ -193,6 +193,7 @@ void hmTriMeshReadOBJ( hmTriMesh* mesh, const char* filename )
       }
    }
 
+   free( line );
    fclose( in );
 }
 